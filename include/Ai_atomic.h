@@ -0,0 +1,166 @@
+/*! \file Ai_atomic.h
+ *
+ *  This header file contains declarations for
+ *  platform independent atomic operations
+ */
+
+#ifndef AI_ATOMIC_H_
+#define AI_ATOMIC_H_
+
+
+#include "Ai_types.h"
+
+
+
+
+#if defined __GNUC__
+
+
+/*! \def AI_ATOMIC_PTR_LOAD
+ * Load a pointer with acquire semantics
+ * @param p address of the pointer
+ */
+#define AI_ATOMIC_PTR_LOAD(p)           __atomic_load_n((p), __ATOMIC_ACQUIRE)
+
+/*! \def AI_ATOMIC_PTR_STORE
+ * Store a pointer with release semantics
+ * @param p address of the pointer
+ * @param v value to store
+ */
+#define AI_ATOMIC_PTR_STORE(p, v)       __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+/*! \def AI_ATOMIC_PTR_EXCHANGE
+ * Exchange a pointer with full barrier semantics
+ * @param p address of the pointer
+ * @param v value to store
+ * @return previous value
+ */
+#define AI_ATOMIC_PTR_EXCHANGE(p, v)    __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+
+
+/*! \brief Load a 32 bit value with acquire semantics
+ */
+static AI_INLINE AiUInt32 ai_atomic_u32_load(volatile AiUInt32* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+
+/*! \brief Store a 32 bit value with release semantics
+ */
+static AI_INLINE void ai_atomic_u32_store(volatile AiUInt32* p, AiUInt32 v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+
+/*! \brief Add to a 32 bit value
+ *
+ * @return value before the addition
+ */
+static AI_INLINE AiUInt32 ai_atomic_u32_fetch_add(volatile AiUInt32* p, AiUInt32 v)
+{
+    return __atomic_fetch_add(p, v, __ATOMIC_SEQ_CST);
+}
+
+
+/*! \brief Compare and exchange a 32 bit value
+ *
+ * @return AiTrue if '*p' was equal to 'expected' and has been replaced by 'desired'
+ */
+static AI_INLINE AiBoolean ai_atomic_u32_cas(volatile AiUInt32* p, AiUInt32 expected, AiUInt32 desired)
+{
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? AiTrue : AiFalse;
+}
+
+
+/*! \brief Load a 64 bit value with acquire semantics
+ */
+static AI_INLINE AiUInt64 ai_atomic_u64_load(volatile AiUInt64* p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+
+/*! \brief Store a 64 bit value with release semantics
+ */
+static AI_INLINE void ai_atomic_u64_store(volatile AiUInt64* p, AiUInt64 v)
+{
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+
+/*! \brief Add to a 64 bit value
+ *
+ * @return value before the addition
+ */
+static AI_INLINE AiUInt64 ai_atomic_u64_fetch_add(volatile AiUInt64* p, AiUInt64 v)
+{
+    return __atomic_fetch_add(p, v, __ATOMIC_SEQ_CST);
+}
+
+
+
+#elif defined _MSC_VER
+
+
+#include <Windows.h>
+
+
+#define AI_ATOMIC_PTR_LOAD(p)           InterlockedCompareExchangePointer((PVOID volatile*) (p), NULL, NULL)
+#define AI_ATOMIC_PTR_STORE(p, v)       ((void) InterlockedExchangePointer((PVOID volatile*) (p), (v)))
+#define AI_ATOMIC_PTR_EXCHANGE(p, v)    InterlockedExchangePointer((PVOID volatile*) (p), (v))
+
+
+static AI_INLINE AiUInt32 ai_atomic_u32_load(volatile AiUInt32* p)
+{
+    return (AiUInt32) InterlockedCompareExchange((volatile LONG*) p, 0, 0);
+}
+
+
+static AI_INLINE void ai_atomic_u32_store(volatile AiUInt32* p, AiUInt32 v)
+{
+    InterlockedExchange((volatile LONG*) p, (LONG) v);
+}
+
+
+static AI_INLINE AiUInt32 ai_atomic_u32_fetch_add(volatile AiUInt32* p, AiUInt32 v)
+{
+    return (AiUInt32) InterlockedExchangeAdd((volatile LONG*) p, (LONG) v);
+}
+
+
+static AI_INLINE AiBoolean ai_atomic_u32_cas(volatile AiUInt32* p, AiUInt32 expected, AiUInt32 desired)
+{
+    return (AiUInt32) InterlockedCompareExchange((volatile LONG*) p, (LONG) desired, (LONG) expected) == expected ? AiTrue : AiFalse;
+}
+
+
+static AI_INLINE AiUInt64 ai_atomic_u64_load(volatile AiUInt64* p)
+{
+    return (AiUInt64) InterlockedCompareExchange64((volatile LONGLONG*) p, 0, 0);
+}
+
+
+static AI_INLINE void ai_atomic_u64_store(volatile AiUInt64* p, AiUInt64 v)
+{
+    InterlockedExchange64((volatile LONGLONG*) p, (LONGLONG) v);
+}
+
+
+static AI_INLINE AiUInt64 ai_atomic_u64_fetch_add(volatile AiUInt64* p, AiUInt64 v)
+{
+    return (AiUInt64) InterlockedExchangeAdd64((volatile LONGLONG*) p, (LONGLONG) v);
+}
+
+
+#else
+
+#error "Unsupported compiler"
+
+#endif
+
+
+
+
+#endif /* AI_ATOMIC_H_ */
@@ -0,0 +1,106 @@
+/*! \file Ai_clock.h
+ *
+ *  This header file contains declarations for
+ *  a platform independent monotonic clock
+ */
+
+#ifndef AI_CLOCK_H_
+#define AI_CLOCK_H_
+
+
+#include "Ai_types.h"
+
+
+
+
+#ifdef __linux
+
+#include <errno.h>
+#include <time.h>
+
+
+/* clock_gettime, nanosleep and CLOCK_MONOTONIC are POSIX. In strict ISO C modes (e.g. -std=c99)
+ * they are only declared if POSIX features are requested before the first system header is included */
+#ifndef CLOCK_MONOTONIC
+  #error "Ai_clock.h requires POSIX.1-2001. Compile with -D_DEFAULT_SOURCE or -D_POSIX_C_SOURCE=200112L in strict ISO C modes"
+#endif
+
+
+/*! \brief Get time of monotonic clock
+ *
+ * The clock is not affected by changes of the system time.
+ * @return time in microseconds since an unspecified starting point
+ */
+static AI_INLINE AiUInt64 ai_clock_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (AiUInt64) ts.tv_sec * 1000000 + (AiUInt64) ts.tv_nsec / 1000;
+}
+
+
+/*! \brief Suspend the calling thread
+ *
+ * @param us time to sleep in microseconds
+ */
+static AI_INLINE void ai_clock_sleep_us(AiUInt32 us)
+{
+    struct timespec ts;
+
+    ts.tv_sec  = us / 1000000;
+    ts.tv_nsec = (long) (us % 1000000) * 1000;
+
+    while(nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+
+
+
+#elif defined WIN32
+
+
+#include <Windows.h>
+
+
+/*! \brief Get time of monotonic clock
+ *
+ * The clock is not affected by changes of the system time.
+ * @return time in microseconds since an unspecified starting point
+ */
+static AI_INLINE AiUInt64 ai_clock_us(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (AiUInt64) (counter.QuadPart / frequency.QuadPart) * 1000000
+         + (AiUInt64) (counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+}
+
+
+/*! \brief Suspend the calling thread
+ *
+ * The resolution is one millisecond, shorter times are rounded up.
+ * @param us time to sleep in microseconds
+ */
+static AI_INLINE void ai_clock_sleep_us(AiUInt32 us)
+{
+    Sleep((us + 999) / 1000);
+}
+
+
+#else
+
+#error "Unsupported platform"
+
+#endif
+
+
+
+
+#endif /* AI_CLOCK_H_ */
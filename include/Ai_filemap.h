@@ -0,0 +1,314 @@
+/*! \file Ai_filemap.h
+ *
+ *  This header file contains declarations for
+ *  platform independent read-only memory mapped files
+ */
+
+#ifndef AI_FILEMAP_H_
+#define AI_FILEMAP_H_
+
+
+#include "Ai_types.h"
+
+
+/*! \struct ai_filemap
+ *
+ * A file mapped read-only into the address space of the process. \n
+ * The whole file is mapped at once, so on 32 bit hosts the file size is limited by the free address space.
+ * Files larger than SIZE_MAX bytes can not be mapped and are rejected by \ref ai_filemap_open.
+ */
+struct ai_filemap
+{
+    const AiUInt8* data;    /*!< Start of the mapped file. NULL for empty files */
+    AiUInt64 size;          /*!< Size of the file in bytes */
+    void* handle;           /*!< Platform dependent handle */
+};
+
+
+/*! \def AI_FILEMAP_PAGE_SIZE
+ * Step width used for touching mapped pages
+ */
+#define AI_FILEMAP_PAGE_SIZE    4096
+
+
+
+
+#ifdef __linux
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/* posix_madvise is POSIX. In strict ISO C modes (e.g. -std=c99)
+ * it is only declared if POSIX features are requested before the first system header is included */
+#ifndef POSIX_MADV_SEQUENTIAL
+  #error "Ai_filemap.h requires POSIX.1-2001. Compile with -D_DEFAULT_SOURCE or -D_POSIX_C_SOURCE=200112L in strict ISO C modes"
+#endif
+
+
+
+
+/*! \brief Map a file
+ *
+ * @param path path of the file
+ * @return pointer to the mapped file on success, NULL on failure. errno is set to EFBIG if the file is larger than SIZE_MAX bytes
+ */
+static AI_INLINE struct ai_filemap* ai_filemap_open(const char* path)
+{
+    struct ai_filemap* map;
+    struct stat st;
+    void* data;
+    int fd;
+
+    if(!path)
+    {
+        return NULL;
+    }
+
+    fd = open(path, O_RDONLY);
+    if(fd < 0)
+    {
+        return NULL;
+    }
+
+    if(fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    /* The mapping length is a size_t, which must not truncate the file size */
+    if((AiUInt64) st.st_size > SIZE_MAX)
+    {
+        close(fd);
+        errno = EFBIG;
+        return NULL;
+    }
+
+    map = (struct ai_filemap*) calloc(1, sizeof(struct ai_filemap));
+    if(!map)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    map->size = (AiUInt64) st.st_size;
+
+    if(map->size)
+    {
+        data = mmap(NULL, (size_t) map->size, PROT_READ, MAP_SHARED, fd, 0);
+        if(data == MAP_FAILED)
+        {
+            close(fd);
+            free(map);
+            return NULL;
+        }
+
+        /* Files are mostly read front to back */
+        posix_madvise(data, (size_t) map->size, POSIX_MADV_SEQUENTIAL);
+        map->data = (const AiUInt8*) data;
+    }
+
+    /* The mapping stays valid after closing the file */
+    close(fd);
+
+    return map;
+}
+
+
+/*! \brief Unmap a file
+ *
+ * @param map the mapped file. May be NULL
+ */
+static AI_INLINE void ai_filemap_close(struct ai_filemap* map)
+{
+    if(!map)
+    {
+        return;
+    }
+
+    if(map->data)
+    {
+        munmap((void*) map->data, (size_t) map->size);
+    }
+
+    free(map);
+}
+
+
+/*! \brief Announce that a range of the file will be read soon
+ *
+ * Asks the operating system to start reading the range in the background.
+ * @param map the mapped file
+ * @param offset start of the range in bytes
+ * @param size size of the range in bytes
+ */
+static AI_INLINE void ai_filemap_advise(struct ai_filemap* map, AiUInt64 offset, AiUInt64 size)
+{
+    AiUInt64 start;
+
+    if(!map || !map->data || offset >= map->size)
+    {
+        return;
+    }
+
+    size  = size < map->size - offset ? size : map->size - offset;
+    start = offset & ~(AiUInt64) (AI_FILEMAP_PAGE_SIZE - 1);
+
+    posix_madvise((void*) (map->data + start), (size_t) (size + offset - start), POSIX_MADV_WILLNEED);
+}
+
+
+
+#elif defined WIN32
+
+
+#include <Windows.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+static AI_INLINE struct ai_filemap* ai_filemap_open(const char* path)
+{
+    struct ai_filemap* map;
+    LARGE_INTEGER size;
+    HANDLE file;
+    HANDLE mapping;
+
+    if(!path)
+    {
+        return NULL;
+    }
+
+    file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return NULL;
+    }
+
+    if(!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    /* The view size is a SIZE_T, which must not truncate the file size */
+    if((AiUInt64) size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        SetLastError(ERROR_FILE_TOO_LARGE);
+        return NULL;
+    }
+
+    map = (struct ai_filemap*) calloc(1, sizeof(struct ai_filemap));
+    if(!map)
+    {
+        CloseHandle(file);
+        return NULL;
+    }
+
+    map->size = (AiUInt64) size.QuadPart;
+
+    if(map->size)
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(!mapping)
+        {
+            CloseHandle(file);
+            free(map);
+            return NULL;
+        }
+
+        map->data = (const AiUInt8*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+        /* The view keeps the mapping alive */
+        CloseHandle(mapping);
+
+        if(!map->data)
+        {
+            CloseHandle(file);
+            free(map);
+            return NULL;
+        }
+    }
+
+    CloseHandle(file);
+
+    return map;
+}
+
+
+static AI_INLINE void ai_filemap_close(struct ai_filemap* map)
+{
+    if(!map)
+    {
+        return;
+    }
+
+    if(map->data)
+    {
+        UnmapViewOfFile(map->data);
+    }
+
+    free(map);
+}
+
+
+static AI_INLINE void ai_filemap_advise(struct ai_filemap* map, AiUInt64 offset, AiUInt64 size)
+{
+    /* Pages are read on first access */
+    (void) map;
+    (void) offset;
+    (void) size;
+}
+
+
+#else
+
+#error "Unsupported platform"
+
+#endif
+
+
+
+
+/*! \brief Read a range of a mapped file into memory
+ *
+ * Touches each page of the range, so later accesses do not block on page faults.
+ * @param map the mapped file
+ * @param offset start of the range in bytes
+ * @param size size of the range in bytes
+ * @return a value depending on the file content, which may be ignored
+ */
+static AI_INLINE AiUInt32 ai_filemap_touch(struct ai_filemap* map, AiUInt64 offset, AiUInt64 size)
+{
+    const volatile AiUInt8* p;
+    AiUInt64 end;
+    AiUInt32 sum = 0;
+
+    if(!map || !map->data || offset >= map->size)
+    {
+        return 0;
+    }
+
+    end = size < map->size - offset ? offset + size : map->size;
+
+    for(p = map->data + offset; p < map->data + end; p += AI_FILEMAP_PAGE_SIZE)
+    {
+        sum += *p;
+    }
+
+    sum += map->data[end - 1];
+
+    return sum;
+}
+
+
+
+
+#endif /* AI_FILEMAP_H_ */
@@ -54,6 +54,13 @@
 
 
 
+/*! \def AI_SELECTANY
+  Macro for initialized global variables defined in headers. The linker keeps one definition shared by all translation units
+*/
+#define AI_SELECTANY __attribute__((weak))
+
+
+
 /*! \def AI_UNUSED
   Macro to avoid compiler warnings of unreferenced formal parameter
 */
@@ -34,6 +34,13 @@
 #define AI_INLINE __inline
 
 
+/*! \def AI_SELECTANY
+  Macro for initialized global variables defined in headers. The linker keeps one definition shared by all translation units
+*/
+#define AI_SELECTANY __declspec(selectany)
+
+
+
 /*! \def AI_UNUSED
   Macro to avoid compiler warnings of unreferenced formal parameter
 */
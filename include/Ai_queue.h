@@ -0,0 +1,321 @@
+/*! \file Ai_queue.h
+ *
+ *  This header file contains declarations for
+ *  lock-free queues used to pass data between threads
+ */
+
+#ifndef AI_QUEUE_H_
+#define AI_QUEUE_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Ai_types.h"
+#include "Ai_atomic.h"
+
+
+
+
+/*! \struct ai_mpsc_node
+ *
+ * Node of a multi producer single consumer queue.
+ * It is embedded into the structure that is queued, which can be
+ * retrieved with \ref AI_CONTAINER_OF
+ */
+struct ai_mpsc_node
+{
+    struct ai_mpsc_node* volatile next;
+};
+
+
+/*! \struct ai_mpsc_queue
+ *
+ * Unbounded intrusive multi producer single consumer queue. \n
+ * Any number of threads may push concurrently without locking,
+ * only one thread at a time may pop.
+ */
+struct ai_mpsc_queue
+{
+    struct ai_mpsc_node* volatile head;     /*!< Last pushed node. Modified by producers */
+    struct ai_mpsc_node* tail;              /*!< Next node to pop. Only used by the consumer */
+    struct ai_mpsc_node stub;               /*!< Dummy node that keeps the queue non-empty */
+};
+
+
+
+
+/*! \brief Initialize an empty queue
+ */
+static AI_INLINE void ai_mpsc_init(struct ai_mpsc_queue* queue)
+{
+    queue->stub.next = NULL;
+    queue->head      = &queue->stub;
+    queue->tail      = &queue->stub;
+}
+
+
+/*! \brief Push a node to the queue
+ *
+ * May be called from any thread. The node must not be queued already.
+ */
+static AI_INLINE void ai_mpsc_push(struct ai_mpsc_queue* queue, struct ai_mpsc_node* node)
+{
+    struct ai_mpsc_node* prev;
+
+    node->next = NULL;
+    prev = (struct ai_mpsc_node*) AI_ATOMIC_PTR_EXCHANGE(&queue->head, node);
+    AI_ATOMIC_PTR_STORE(&prev->next, node);
+}
+
+
+/*! \brief Pop the oldest node from the queue
+ *
+ * Must only be called by the consumer thread.
+ * @return the popped node, or NULL if the queue is empty or a producer is just in the middle of a push
+ */
+static AI_INLINE struct ai_mpsc_node* ai_mpsc_pop(struct ai_mpsc_queue* queue)
+{
+    struct ai_mpsc_node* tail = queue->tail;
+    struct ai_mpsc_node* next = (struct ai_mpsc_node*) AI_ATOMIC_PTR_LOAD(&tail->next);
+    struct ai_mpsc_node* head;
+
+    if(tail == &queue->stub)
+    {
+        if(!next)
+        {
+            return NULL;
+        }
+
+        queue->tail = next;
+        tail = next;
+        next = (struct ai_mpsc_node*) AI_ATOMIC_PTR_LOAD(&tail->next);
+    }
+
+    if(next)
+    {
+        queue->tail = next;
+        return tail;
+    }
+
+    head = (struct ai_mpsc_node*) AI_ATOMIC_PTR_LOAD(&queue->head);
+    if(tail != head)
+    {
+        return NULL;
+    }
+
+    /* Last node is about to be popped, re-insert stub behind it */
+    ai_mpsc_push(queue, &queue->stub);
+
+    next = (struct ai_mpsc_node*) AI_ATOMIC_PTR_LOAD(&tail->next);
+    if(next)
+    {
+        queue->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+
+
+
+
+/*! \def AI_MPMC_CACHE_LINE
+ * Size of a cache line, used to keep producer and consumer positions apart
+ */
+#define AI_MPMC_CACHE_LINE      64
+
+/*! \def AI_MPMC_CELL_HEADER
+ * Size of the sequence number in front of each element of a multi producer multi consumer queue
+ */
+#define AI_MPMC_CELL_HEADER     8
+
+
+/*! \struct ai_mpmc_queue
+ *
+ * Bounded multi producer multi consumer queue of fixed size elements. \n
+ * Any number of threads may push and pop concurrently without locking.
+ * Each cell carries a sequence number that tells producers and consumers whether the cell is free or filled
+ * in the current round, so a thread only competes for the queue position, never for a lock.
+ */
+struct ai_mpmc_queue
+{
+    AiUInt8* cells;                                 /*!< Cells, each with sequence number and element */
+    AiUInt32 cell_size;                             /*!< Size of a cell in bytes */
+    AiUInt32 element_size;                          /*!< Size of an element in bytes */
+    AiUInt32 mask;                                  /*!< Number of cells minus one */
+    AiUInt8 pad0[AI_MPMC_CACHE_LINE];
+    volatile AiUInt32 enqueue_pos;                  /*!< Position of the next push */
+    AiUInt8 pad1[AI_MPMC_CACHE_LINE];
+    volatile AiUInt32 dequeue_pos;                  /*!< Position of the next pop */
+    AiUInt8 pad2[AI_MPMC_CACHE_LINE];
+};
+
+
+
+
+/*! \brief Get the sequence number of a cell
+ */
+static AI_INLINE volatile AiUInt32* ai_mpmc_sequence(struct ai_mpmc_queue* queue, AiUInt32 pos)
+{
+    return (volatile AiUInt32*) (void*) (queue->cells + (AiSize) (pos & queue->mask) * queue->cell_size);
+}
+
+
+/*! \brief Free a queue
+ *
+ * @param queue queue to free. May be NULL
+ */
+static AI_INLINE void ai_mpmc_free(struct ai_mpmc_queue* queue)
+{
+    if(!queue)
+    {
+        return;
+    }
+
+    free(queue->cells);
+    free(queue);
+}
+
+
+/*! \brief Create an empty queue
+ *
+ * @param capacity maximum number of queued elements. Must be a power of two
+ * @param element_size size of an element in bytes
+ * @return pointer to the created queue on success, NULL on failure
+ */
+static AI_INLINE struct ai_mpmc_queue* ai_mpmc_create(AiUInt32 capacity, AiUInt32 element_size)
+{
+    struct ai_mpmc_queue* queue;
+    AiUInt32 i;
+
+    if(capacity < 2 || capacity > 0x40000000u || (capacity & (capacity - 1)))
+    {
+        return NULL;
+    }
+
+    queue = (struct ai_mpmc_queue*) calloc(1, sizeof(struct ai_mpmc_queue));
+    if(!queue)
+    {
+        return NULL;
+    }
+
+    queue->element_size = element_size;
+    queue->cell_size    = (AI_MPMC_CELL_HEADER + element_size + 7) & ~7u;
+    queue->mask         = capacity - 1;
+    queue->cells        = (AiUInt8*) malloc((AiSize) capacity * queue->cell_size);
+
+    if(!queue->cells)
+    {
+        ai_mpmc_free(queue);
+        return NULL;
+    }
+
+    for(i = 0; i < capacity; i++)
+    {
+        *ai_mpmc_sequence(queue, i) = i;
+    }
+
+    return queue;
+}
+
+
+/*! \brief Push an element to the queue
+ *
+ * May be called from any thread. Never blocks.
+ * @param queue the queue
+ * @param element element to copy into the queue
+ * @return AiTrue on success, AiFalse if the queue is full
+ */
+static AI_INLINE AiBoolean ai_mpmc_push(struct ai_mpmc_queue* queue, const void* element)
+{
+    volatile AiUInt32* sequence;
+    AiUInt32 pos = ai_atomic_u32_load(&queue->enqueue_pos);
+    AiInt32 diff;
+
+    for(;;)
+    {
+        sequence = ai_mpmc_sequence(queue, pos);
+        diff     = (AiInt32) (ai_atomic_u32_load(sequence) - pos);
+
+        if(diff == 0)
+        {
+            if(ai_atomic_u32_cas(&queue->enqueue_pos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            /* The cell still holds the element of the previous round */
+            return AiFalse;
+        }
+
+        pos = ai_atomic_u32_load(&queue->enqueue_pos);
+    }
+
+    memcpy((AiUInt8*) sequence + AI_MPMC_CELL_HEADER, element, queue->element_size);
+    ai_atomic_u32_store(sequence, pos + 1);
+
+    return AiTrue;
+}
+
+
+/*! \brief Pop the oldest element from the queue
+ *
+ * May be called from any thread. Never blocks.
+ * @param queue the queue
+ * @param element the element is copied here
+ * @return AiTrue on success, AiFalse if the queue is empty
+ */
+static AI_INLINE AiBoolean ai_mpmc_pop(struct ai_mpmc_queue* queue, void* element)
+{
+    volatile AiUInt32* sequence;
+    AiUInt32 pos = ai_atomic_u32_load(&queue->dequeue_pos);
+    AiInt32 diff;
+
+    for(;;)
+    {
+        sequence = ai_mpmc_sequence(queue, pos);
+        diff     = (AiInt32) (ai_atomic_u32_load(sequence) - (pos + 1));
+
+        if(diff == 0)
+        {
+            if(ai_atomic_u32_cas(&queue->dequeue_pos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if(diff < 0)
+        {
+            /* The cell was not filled in this round yet */
+            return AiFalse;
+        }
+
+        pos = ai_atomic_u32_load(&queue->dequeue_pos);
+    }
+
+    memcpy(element, (const AiUInt8*) sequence + AI_MPMC_CELL_HEADER, queue->element_size);
+    ai_atomic_u32_store(sequence, pos + queue->mask + 1);
+
+    return AiTrue;
+}
+
+
+/*! \brief Get the number of queued elements
+ *
+ * The value is only a snapshot while other threads access the queue.
+ */
+static AI_INLINE AiUInt32 ai_mpmc_size(struct ai_mpmc_queue* queue)
+{
+    AiUInt32 dequeue = ai_atomic_u32_load(&queue->dequeue_pos);
+    AiUInt32 enqueue = ai_atomic_u32_load(&queue->enqueue_pos);
+
+    return enqueue - dequeue <= queue->mask + 1 ? enqueue - dequeue : 0;
+}
+
+
+
+
+#endif /* AI_QUEUE_H_ */
@@ -0,0 +1,463 @@
+/*! \file Ai_thread.h
+ *
+ *  This header file contains declarations for
+ *  platform independent threads and thread notification
+ */
+
+#ifndef AI_THREAD_H_
+#define AI_THREAD_H_
+
+
+#include "Ai_types.h"
+
+
+/* Forward declaration
+ * Actual definition is platform dependent
+ */
+struct ai_thread;
+struct ai_event;
+
+
+/*! \enum ai_thread_err
+ * Enumeration of possible ai_thread related error codes
+ */
+enum ai_thread_err
+{
+    AI_THREAD_OK = 0,   /*!< The function executed successfully */
+    AI_THREAD_INVAL,    /*!< Invalid argument provided */
+    AI_THREAD_TIMEOUT,  /*!< Wait timed out */
+    AI_THREAD_INTERNAL  /*!< Internal error occurred */
+};
+
+
+/*! \typedef AI_THREAD_ROUTINE
+ * Prototype of a function that is executed by a thread
+ */
+typedef void (*AI_THREAD_ROUTINE)(void* arg);
+
+
+
+
+#ifdef __linux
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <time.h>
+
+
+/* pthread_condattr_setclock, clock_gettime and CLOCK_MONOTONIC are POSIX. In strict ISO C modes (e.g. -std=c99)
+ * they are only declared if POSIX features are requested before the first system header is included */
+#ifndef CLOCK_MONOTONIC
+  #error "Ai_thread.h requires POSIX.1-2001. Compile with -D_DEFAULT_SOURCE or -D_POSIX_C_SOURCE=200112L in strict ISO C modes"
+#endif
+
+
+
+
+/*! \struct ai_thread
+ *
+ * Generic thread using pthread library
+ */
+struct ai_thread
+{
+    pthread_t pt;
+    AI_THREAD_ROUTINE routine;
+    void* arg;
+};
+
+
+/*! \struct ai_event
+ *
+ * Event counter using pthread library. \n
+ * Each signal increments the counter and wakes all threads waiting for a change of it,
+ * so no signal gets lost between checking a condition and starting to wait.
+ */
+struct ai_event
+{
+    pthread_mutex_t pm;
+    pthread_cond_t pc;
+    AiUInt32 count;
+};
+
+
+static void* ai_thread_start(void* arg)
+{
+    struct ai_thread* thread = (struct ai_thread*) arg;
+
+    thread->routine(thread->arg);
+
+    return NULL;
+}
+
+
+/*! \brief Create and start a thread
+ *
+ * @param routine function the thread executes
+ * @param arg argument passed to 'routine'
+ * @return pointer to created thread on success, NULL on failure
+ */
+static AI_INLINE struct ai_thread* ai_thread_create(AI_THREAD_ROUTINE routine, void* arg)
+{
+    struct ai_thread* thread;
+
+    if(!routine)
+    {
+        return NULL;
+    }
+
+    thread = (struct ai_thread*) malloc(sizeof(struct ai_thread));
+    if(!thread)
+    {
+        return NULL;
+    }
+
+    thread->routine = routine;
+    thread->arg     = arg;
+
+    if(pthread_create(&thread->pt, NULL, ai_thread_start, thread))
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+
+/*! \brief Wait for a thread to finish and free it
+ *
+ * @param thread thread to join
+ * @return AI_THREAD_OK on success, an ai_thread_err otherwise
+ */
+static AI_INLINE enum ai_thread_err ai_thread_join(struct ai_thread* thread)
+{
+    if(!thread)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    if(pthread_join(thread->pt, NULL))
+    {
+        return AI_THREAD_INTERNAL;
+    }
+
+    free(thread);
+
+    return AI_THREAD_OK;
+}
+
+
+/*! \brief Create an event counter
+ *
+ * @return pointer to created event on success, NULL on failure
+ */
+static AI_INLINE struct ai_event* ai_event_create(void)
+{
+    struct ai_event* event;
+    pthread_condattr_t attr;
+
+    event = (struct ai_event*) malloc(sizeof(struct ai_event));
+    if(!event)
+    {
+        return NULL;
+    }
+
+    event->count = 0;
+
+    if(pthread_mutex_init(&event->pm, NULL))
+    {
+        free(event);
+        return NULL;
+    }
+
+    /* Timeouts are measured with monotonic clock */
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    if(pthread_cond_init(&event->pc, &attr))
+    {
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_destroy(&event->pm);
+        free(event);
+        return NULL;
+    }
+
+    pthread_condattr_destroy(&attr);
+
+    return event;
+}
+
+
+/*! \brief Free an event counter
+ *
+ * No thread must wait for the event.
+ * @param event event to free
+ * @return AI_THREAD_OK on success, an ai_thread_err otherwise
+ */
+static AI_INLINE enum ai_thread_err ai_event_free(struct ai_event* event)
+{
+    if(!event)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    pthread_cond_destroy(&event->pc);
+    pthread_mutex_destroy(&event->pm);
+    free(event);
+
+    return AI_THREAD_OK;
+}
+
+
+/*! \brief Get the current value of an event counter
+ *
+ * The value is passed to \ref ai_event_wait after checking the awaited condition.
+ */
+static AI_INLINE AiUInt32 ai_event_value(struct ai_event* event)
+{
+    AiUInt32 count;
+
+    pthread_mutex_lock(&event->pm);
+    count = event->count;
+    pthread_mutex_unlock(&event->pm);
+
+    return count;
+}
+
+
+/*! \brief Signal an event
+ *
+ * Increments the counter and wakes all waiting threads.
+ * May be called from any thread, including interrupt callbacks.
+ */
+static AI_INLINE void ai_event_signal(struct ai_event* event)
+{
+    pthread_mutex_lock(&event->pm);
+    event->count++;
+    pthread_cond_broadcast(&event->pc);
+    pthread_mutex_unlock(&event->pm);
+}
+
+
+/*! \brief Wait until an event counter differs from a value
+ *
+ * @param event the event
+ * @param value counter value as returned by \ref ai_event_value
+ * @param timeout_us maximum time to wait in microseconds
+ * @return AI_THREAD_OK if the event was signalled, AI_THREAD_TIMEOUT otherwise
+ */
+static AI_INLINE enum ai_thread_err ai_event_wait(struct ai_event* event, AiUInt32 value, AiUInt32 timeout_us)
+{
+    struct timespec ts;
+    enum ai_thread_err ret = AI_THREAD_OK;
+
+    if(!event)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec  += timeout_us / 1000000;
+    ts.tv_nsec += (long) (timeout_us % 1000000) * 1000;
+    if(ts.tv_nsec >= 1000000000)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&event->pm);
+
+    while(event->count == value)
+    {
+        if(pthread_cond_timedwait(&event->pc, &event->pm, &ts) == ETIMEDOUT)
+        {
+            ret = event->count == value ? AI_THREAD_TIMEOUT : AI_THREAD_OK;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&event->pm);
+
+    return ret;
+}
+
+
+
+#elif defined WIN32
+
+
+#include <Windows.h>
+#include <stdlib.h>
+
+
+struct ai_thread
+{
+    HANDLE handle;
+    AI_THREAD_ROUTINE routine;
+    void* arg;
+};
+
+
+struct ai_event
+{
+    CRITICAL_SECTION cs;
+    CONDITION_VARIABLE cv;
+    AiUInt32 count;
+};
+
+
+static DWORD WINAPI ai_thread_start(LPVOID arg)
+{
+    struct ai_thread* thread = (struct ai_thread*) arg;
+
+    thread->routine(thread->arg);
+
+    return 0;
+}
+
+
+static AI_INLINE struct ai_thread* ai_thread_create(AI_THREAD_ROUTINE routine, void* arg)
+{
+    struct ai_thread* thread;
+
+    if(!routine)
+    {
+        return NULL;
+    }
+
+    thread = (struct ai_thread*) malloc(sizeof(struct ai_thread));
+    if(!thread)
+    {
+        return NULL;
+    }
+
+    thread->routine = routine;
+    thread->arg     = arg;
+
+    thread->handle = CreateThread(NULL, 0, ai_thread_start, thread, 0, NULL);
+    if(!thread->handle)
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+
+static AI_INLINE enum ai_thread_err ai_thread_join(struct ai_thread* thread)
+{
+    if(!thread)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    if(WaitForSingleObject(thread->handle, INFINITE) == WAIT_FAILED)
+    {
+        return AI_THREAD_INTERNAL;
+    }
+
+    CloseHandle(thread->handle);
+    free(thread);
+
+    return AI_THREAD_OK;
+}
+
+
+static AI_INLINE struct ai_event* ai_event_create(void)
+{
+    struct ai_event* event;
+
+    event = (struct ai_event*) malloc(sizeof(struct ai_event));
+    if(!event)
+    {
+        return NULL;
+    }
+
+    event->count = 0;
+    InitializeCriticalSection(&event->cs);
+    InitializeConditionVariable(&event->cv);
+
+    return event;
+}
+
+
+static AI_INLINE enum ai_thread_err ai_event_free(struct ai_event* event)
+{
+    if(!event)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    DeleteCriticalSection(&event->cs);
+    free(event);
+
+    return AI_THREAD_OK;
+}
+
+
+static AI_INLINE AiUInt32 ai_event_value(struct ai_event* event)
+{
+    AiUInt32 count;
+
+    EnterCriticalSection(&event->cs);
+    count = event->count;
+    LeaveCriticalSection(&event->cs);
+
+    return count;
+}
+
+
+static AI_INLINE void ai_event_signal(struct ai_event* event)
+{
+    EnterCriticalSection(&event->cs);
+    event->count++;
+    WakeAllConditionVariable(&event->cv);
+    LeaveCriticalSection(&event->cs);
+}
+
+
+static AI_INLINE enum ai_thread_err ai_event_wait(struct ai_event* event, AiUInt32 value, AiUInt32 timeout_us)
+{
+    ULONGLONG deadline;
+    ULONGLONG now;
+    enum ai_thread_err ret = AI_THREAD_OK;
+
+    if(!event)
+    {
+        return AI_THREAD_INVAL;
+    }
+
+    deadline = GetTickCount64() + (timeout_us + 999) / 1000;
+
+    EnterCriticalSection(&event->cs);
+
+    while(event->count == value)
+    {
+        now = GetTickCount64();
+        if(now >= deadline)
+        {
+            ret = AI_THREAD_TIMEOUT;
+            break;
+        }
+
+        SleepConditionVariableCS(&event->cv, &event->cs, (DWORD) (deadline - now));
+    }
+
+    LeaveCriticalSection(&event->cs);
+
+    return ret;
+}
+
+
+#else
+
+#error "Unsupported platform"
+
+#endif
+
+
+
+
+#endif /* AI_THREAD_H_ */
@@ -0,0 +1,609 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Codec.h
+ *
+ *  This header file contains inline helper functions for
+ *  encoding and decoding the fields of Arinc 429 data words
+ *  (Label, SDI, BNR/BCD/discrete data, SSM and parity).
+ */
+
+#ifndef API429CODEC_H_
+#define API429CODEC_H_
+
+
+#include "Api429.h"
+
+
+/**
+* \defgroup codec Data Word Encoding/Decoding
+  This module contains header-only helpers for packing and unpacking
+  Arinc 429 data words as they are exchanged with the transfer buffers,
+  receive buffers and monitor buffers of the board.
+
+  Bit numbers used in this module follow the Arinc 429 specification,
+  i.e. bit 1 is the least significant bit of the 32 bit data word and
+  bits 1..8 hold the label.
+
+  A data word format is described with a \ref api429_codec_format that
+  is usually declared as 'static const' with one of the
+  API429_CODEC_FORMAT_* initializer macros. As all codec functions are
+  inline, the compiler resolves masks and shifts of such a constant format
+  at compile time, and the generated encode/decode code does not branch on
+  the data.
+* @{
+*/
+
+
+
+/*! \def API429_WORD_LABEL_MASK
+ * Mask of the label field (bits 1..8) of a data word
+ */
+#define API429_WORD_LABEL_MASK      0x000000FF
+
+/*! \def API429_WORD_SDI_POS
+ * Position of the SDI field (bits 9..10) of a data word
+ */
+#define API429_WORD_SDI_POS         8
+
+/*! \def API429_WORD_SDI_MASK
+ * Mask of the SDI field (bits 9..10) of a data word
+ */
+#define API429_WORD_SDI_MASK        0x00000300
+
+/*! \def API429_WORD_SSM_POS
+ * Position of the SSM field (bits 30..31) of a data word
+ */
+#define API429_WORD_SSM_POS         29
+
+/*! \def API429_WORD_SSM_MASK
+ * Mask of the SSM field (bits 30..31) of a data word
+ */
+#define API429_WORD_SSM_MASK        0x60000000
+
+/*! \def API429_WORD_PARITY_MASK
+ * Mask of the parity bit (bit 32) of a data word
+ */
+#define API429_WORD_PARITY_MASK     0x80000000
+
+
+
+/*! \enum api429_codec_type
+ *
+ * Enumeration of all supported data encodings
+ */
+enum api429_codec_type
+{
+    API429_CODEC_BNR = 0,   /*!< Binary number representation, optionally two's complement */
+    API429_CODEC_BCD,       /*!< Binary coded decimal. Sign is encoded in the SSM field */
+    API429_CODEC_DISCRETE   /*!< Plain bit field */
+};
+
+/*! \typedef TY_E_API429_CODEC_TYPE
+ * Convenience typedef for \ref api429_codec_type
+ */
+typedef enum api429_codec_type TY_E_API429_CODEC_TYPE;
+
+
+/*! \enum api429_ssm_status
+ *
+ * Meaning of the SSM field independent of the data encoding
+ */
+enum api429_ssm_status
+{
+    API429_SSM_NORMAL = 0,          /*!< Normal operation. For BCD data, the sign is encoded in addition */
+    API429_SSM_NO_COMPUTED_DATA,    /*!< No computed data */
+    API429_SSM_FUNCTIONAL_TEST,     /*!< Functional test */
+    API429_SSM_FAILURE_WARNING      /*!< Failure warning. Not available for BCD data */
+};
+
+/*! \typedef TY_E_API429_SSM_STATUS
+ * Convenience typedef for \ref api429_ssm_status
+ */
+typedef enum api429_ssm_status TY_E_API429_SSM_STATUS;
+
+
+/*! \struct api429_codec_format
+ *
+ * This structure describes the layout of the data field of a label
+ */
+struct api429_codec_format
+{
+    enum api429_codec_type type;    /*!< Data encoding. See \ref api429_codec_type */
+    AiUInt8 lsb;                    /*!< Bit number of the least significant data bit. Ranges from 9..29 */
+    AiUInt8 msb;                    /*!< Bit number of the most significant data bit, not including the sign bit. Ranges from lsb..29 */
+    AiBoolean is_signed;            /*!< BNR only. If AiTrue, bit msb + 1 holds the sign of a two's complement value */
+    AiDouble resolution;            /*!< Value of the least significant data bit in engineering units */
+};
+
+/*! \typedef TY_API429_CODEC_FORMAT
+ * Convenience typedef for \ref api429_codec_format
+ */
+typedef struct api429_codec_format TY_API429_CODEC_FORMAT;
+
+
+/*! \def API429_CODEC_FORMAT_BNR
+ * Initializer for a BNR \ref api429_codec_format
+ * @param msb bit number of the most significant data bit (without sign)
+ * @param lsb bit number of the least significant data bit
+ * @param is_signed AiTrue if bit msb + 1 is a sign bit
+ * @param resolution value of the least significant bit
+ */
+#define API429_CODEC_FORMAT_BNR(msb, lsb, is_signed, resolution) \
+    { API429_CODEC_BNR, (lsb), (msb), (is_signed), (resolution) }
+
+/*! \def API429_CODEC_FORMAT_BCD
+ * Initializer for a BCD \ref api429_codec_format
+ * @param msb bit number of the most significant bit of the most significant digit
+ * @param lsb bit number of the least significant bit of the least significant digit
+ * @param resolution value of the least significant digit
+ */
+#define API429_CODEC_FORMAT_BCD(msb, lsb, resolution) \
+    { API429_CODEC_BCD, (lsb), (msb), AiFalse, (resolution) }
+
+/*! \def API429_CODEC_FORMAT_DISCRETE
+ * Initializer for a discrete \ref api429_codec_format
+ * @param msb bit number of the most significant bit of the field
+ * @param lsb bit number of the least significant bit of the field
+ */
+#define API429_CODEC_FORMAT_DISCRETE(msb, lsb) \
+    { API429_CODEC_DISCRETE, (lsb), (msb), AiFalse, 1.0 }
+
+
+
+/*! \var api429_codec_label_reverse_table
+ * Lookup table for reversing the bit order of a label
+ */
+static const AiUInt8 api429_codec_label_reverse_table[256] =
+{
+    0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0,
+    0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0,
+    0x08, 0x88, 0x48, 0xC8, 0x28, 0xA8, 0x68, 0xE8,
+    0x18, 0x98, 0x58, 0xD8, 0x38, 0xB8, 0x78, 0xF8,
+    0x04, 0x84, 0x44, 0xC4, 0x24, 0xA4, 0x64, 0xE4,
+    0x14, 0x94, 0x54, 0xD4, 0x34, 0xB4, 0x74, 0xF4,
+    0x0C, 0x8C, 0x4C, 0xCC, 0x2C, 0xAC, 0x6C, 0xEC,
+    0x1C, 0x9C, 0x5C, 0xDC, 0x3C, 0xBC, 0x7C, 0xFC,
+    0x02, 0x82, 0x42, 0xC2, 0x22, 0xA2, 0x62, 0xE2,
+    0x12, 0x92, 0x52, 0xD2, 0x32, 0xB2, 0x72, 0xF2,
+    0x0A, 0x8A, 0x4A, 0xCA, 0x2A, 0xAA, 0x6A, 0xEA,
+    0x1A, 0x9A, 0x5A, 0xDA, 0x3A, 0xBA, 0x7A, 0xFA,
+    0x06, 0x86, 0x46, 0xC6, 0x26, 0xA6, 0x66, 0xE6,
+    0x16, 0x96, 0x56, 0xD6, 0x36, 0xB6, 0x76, 0xF6,
+    0x0E, 0x8E, 0x4E, 0xCE, 0x2E, 0xAE, 0x6E, 0xEE,
+    0x1E, 0x9E, 0x5E, 0xDE, 0x3E, 0xBE, 0x7E, 0xFE,
+    0x01, 0x81, 0x41, 0xC1, 0x21, 0xA1, 0x61, 0xE1,
+    0x11, 0x91, 0x51, 0xD1, 0x31, 0xB1, 0x71, 0xF1,
+    0x09, 0x89, 0x49, 0xC9, 0x29, 0xA9, 0x69, 0xE9,
+    0x19, 0x99, 0x59, 0xD9, 0x39, 0xB9, 0x79, 0xF9,
+    0x05, 0x85, 0x45, 0xC5, 0x25, 0xA5, 0x65, 0xE5,
+    0x15, 0x95, 0x55, 0xD5, 0x35, 0xB5, 0x75, 0xF5,
+    0x0D, 0x8D, 0x4D, 0xCD, 0x2D, 0xAD, 0x6D, 0xED,
+    0x1D, 0x9D, 0x5D, 0xDD, 0x3D, 0xBD, 0x7D, 0xFD,
+    0x03, 0x83, 0x43, 0xC3, 0x23, 0xA3, 0x63, 0xE3,
+    0x13, 0x93, 0x53, 0xD3, 0x33, 0xB3, 0x73, 0xF3,
+    0x0B, 0x8B, 0x4B, 0xCB, 0x2B, 0xAB, 0x6B, 0xEB,
+    0x1B, 0x9B, 0x5B, 0xDB, 0x3B, 0xBB, 0x7B, 0xFB,
+    0x07, 0x87, 0x47, 0xC7, 0x27, 0xA7, 0x67, 0xE7,
+    0x17, 0x97, 0x57, 0xD7, 0x37, 0xB7, 0x77, 0xF7,
+    0x0F, 0x8F, 0x4F, 0xCF, 0x2F, 0xAF, 0x6F, 0xEF,
+    0x1F, 0x9F, 0x5F, 0xDF, 0x3F, 0xBF, 0x7F, 0xFF
+};
+
+
+/*! \var api429_codec_ssm_status_table
+ * Lookup table for converting the raw SSM field into an \ref api429_ssm_status. \n
+ * Indexed by \ref api429_codec_type and raw SSM value.
+ */
+static const AiUInt8 api429_codec_ssm_status_table[3][4] =
+{
+    /* BNR:      00 = FW, 01 = NCD, 10 = FT, 11 = NO */
+    { API429_SSM_FAILURE_WARNING, API429_SSM_NO_COMPUTED_DATA, API429_SSM_FUNCTIONAL_TEST, API429_SSM_NORMAL },
+    /* BCD:      00 = Plus, 01 = NCD, 10 = FT, 11 = Minus */
+    { API429_SSM_NORMAL, API429_SSM_NO_COMPUTED_DATA, API429_SSM_FUNCTIONAL_TEST, API429_SSM_NORMAL },
+    /* Discrete: 00 = NO, 01 = NCD, 10 = FT, 11 = FW */
+    { API429_SSM_NORMAL, API429_SSM_NO_COMPUTED_DATA, API429_SSM_FUNCTIONAL_TEST, API429_SSM_FAILURE_WARNING }
+};
+
+
+/*! \var api429_codec_ssm_encode_table
+ * Lookup table for converting an \ref api429_ssm_status into the raw SSM field. \n
+ * Indexed by \ref api429_codec_type and \ref api429_ssm_status.
+ * For BCD, the 'normal' entry encodes a positive sign.
+ */
+static const AiUInt8 api429_codec_ssm_encode_table[3][4] =
+{
+    { 3, 1, 2, 0 },
+    { 0, 1, 2, 0 },
+    { 0, 1, 2, 3 }
+};
+
+
+/*! \var api429_codec_bcd_sign_table
+ * Sign factor of BCD data indexed by raw SSM value
+ */
+static const AiDouble api429_codec_bcd_sign_table[4] = { 1.0, 1.0, 1.0, -1.0 };
+
+
+
+
+/*! \brief Reverse the bit order of a label
+ *
+ * The API delivers the label in the lowest byte of a data word with bit 1 holding
+ * the label's least significant bit. On the bus, the label is transferred most
+ * significant bit first. This function converts between both representations.
+ * @param label label to reverse
+ * @return label in reversed bit order
+ */
+static AI_INLINE AiUInt8 api429_codec_label_reverse(AiUInt8 label)
+{
+    return api429_codec_label_reverse_table[label];
+}
+
+
+/*! \brief Get the label of a data word
+ *
+ * @param word Arinc 429 data word
+ * @return label ID in bits 1..8
+ */
+static AI_INLINE AiUInt8 api429_codec_label_get(AiUInt32 word)
+{
+    return (AiUInt8) (word & API429_WORD_LABEL_MASK);
+}
+
+
+/*! \brief Get the SDI of a data word
+ *
+ * @param word Arinc 429 data word
+ * @return SDI (0..3)
+ */
+static AI_INLINE AiUInt8 api429_codec_sdi_get(AiUInt32 word)
+{
+    return (AiUInt8) ((word & API429_WORD_SDI_MASK) >> API429_WORD_SDI_POS);
+}
+
+
+/*! \brief Get the raw SSM field of a data word
+ *
+ * @param word Arinc 429 data word
+ * @return raw SSM (0..3)
+ */
+static AI_INLINE AiUInt8 api429_codec_ssm_get(AiUInt32 word)
+{
+    return (AiUInt8) ((word & API429_WORD_SSM_MASK) >> API429_WORD_SSM_POS);
+}
+
+
+/*! \brief Get the meaning of the SSM field of a data word
+ *
+ * @param format format of the data word
+ * @param word Arinc 429 data word
+ * @return SSM status. See \ref api429_ssm_status
+ */
+static AI_INLINE enum api429_ssm_status api429_codec_ssm_status_get(const struct api429_codec_format* format, AiUInt32 word)
+{
+    return (enum api429_ssm_status) api429_codec_ssm_status_table[format->type][api429_codec_ssm_get(word)];
+}
+
+
+/*! \brief Calculate the parity bit of a data word
+ *
+ * Arinc 429 uses odd parity over all 32 bits.
+ * @param word Arinc 429 data word. Bit 32 is ignored
+ * @return value of bit 32 (0 or 1) that results in odd parity
+ */
+static AI_INLINE AiUInt32 api429_codec_parity_calc(AiUInt32 word)
+{
+    word &= ~API429_WORD_PARITY_MASK;
+    word ^= word >> 16;
+    word ^= word >> 8;
+    word ^= word >> 4;
+    word ^= word >> 2;
+    word ^= word >> 1;
+
+    return (~word) & 1;
+}
+
+
+/*! \brief Set the parity bit of a data word
+ *
+ * @param word Arinc 429 data word
+ * @return data word with bit 32 set for odd parity
+ */
+static AI_INLINE AiUInt32 api429_codec_parity_set(AiUInt32 word)
+{
+    return (word & ~API429_WORD_PARITY_MASK) | (api429_codec_parity_calc(word) << 31);
+}
+
+
+/*! \brief Check the parity bit of a data word
+ *
+ * @param word Arinc 429 data word
+ * @return AiTrue if the word has odd parity, AiFalse otherwise
+ */
+static AI_INLINE AiBoolean api429_codec_parity_check(AiUInt32 word)
+{
+    return (AiBoolean) ((word >> 31) == api429_codec_parity_calc(word));
+}
+
+
+/*! \brief Get the mask of the data field of a format in the data word
+ *
+ * For signed BNR formats the sign bit is part of the mask.
+ * @param format the format to get mask of
+ * @return the mask
+ */
+static AI_INLINE AiUInt32 api429_codec_field_mask(const struct api429_codec_format* format)
+{
+    AiUInt32 width = (AiUInt32) (format->msb - format->lsb + 1) + (format->is_signed ? 1 : 0);
+
+    return (AiUInt32) ((((AiUInt64) 1) << width) - 1) << (format->lsb - 1);
+}
+
+
+/*! \brief Get the raw data field of a data word
+ *
+ * Signed BNR fields are sign extended.
+ * @param format format of the data word
+ * @param word Arinc 429 data word
+ * @return raw field value
+ */
+static AI_INLINE AiInt32 api429_codec_raw_get(const struct api429_codec_format* format, AiUInt32 word)
+{
+    AiUInt32 width = (AiUInt32) (format->msb - format->lsb + 1);
+    AiUInt32 field;
+    AiUInt32 sign;
+
+    field = (word & api429_codec_field_mask(format)) >> (format->lsb - 1);
+
+    /* Branch free sign extension. 'sign' is zero for unsigned formats */
+    sign = (AiUInt32) (format->is_signed ? 1 : 0) << width;
+
+    return (AiInt32) ((field ^ sign) - sign);
+}
+
+
+/*! \brief Decode the data field of a data word into engineering units
+ *
+ * @param format format of the data word
+ * @param word Arinc 429 data word
+ * @return value in engineering units
+ */
+static AI_INLINE AiDouble api429_codec_decode(const struct api429_codec_format* format, AiUInt32 word)
+{
+    AiUInt32 field;
+    AiUInt32 digits;
+    AiUInt32 i;
+    AiDouble value;
+    AiDouble factor;
+
+    switch(format->type)
+    {
+        case API429_CODEC_BCD:
+            field  = (word & api429_codec_field_mask(format)) >> (format->lsb - 1);
+            digits = (AiUInt32) (format->msb - format->lsb + 4) / 4;
+            value  = 0.0;
+            factor = format->resolution;
+            for(i = 0; i < digits; i++)
+            {
+                value  += (AiDouble) (field & 0xF) * factor;
+                factor *= 10.0;
+                field >>= 4;
+            }
+            return value * api429_codec_bcd_sign_table[api429_codec_ssm_get(word)];
+
+        case API429_CODEC_DISCRETE:
+            return (AiDouble) api429_codec_raw_get(format, word);
+
+        case API429_CODEC_BNR:
+        default:
+            return (AiDouble) api429_codec_raw_get(format, word) * format->resolution;
+    }
+}
+
+
+/*! \brief Encode a value into an Arinc 429 data word
+ *
+ * Values exceeding the range of the format are saturated.
+ * For BCD formats with \ref API429_SSM_NORMAL status, the SSM field is set according to the sign of the value.
+ * @param format format of the data word
+ * @param label label ID to put into bits 1..8
+ * @param sdi SDI to put into bits 9..10
+ * @param status SSM status to encode. See \ref api429_ssm_status
+ * @param value value in engineering units
+ * @return the data word with parity bit cleared. Use \ref api429_codec_parity_set if the channel does not generate parity
+ */
+static AI_INLINE AiUInt32 api429_codec_encode(const struct api429_codec_format* format, AiUInt8 label, AiUInt8 sdi,
+                                              enum api429_ssm_status status, AiDouble value)
+{
+    AiUInt32 width = (AiUInt32) (format->msb - format->lsb + 1);
+    AiUInt32 ssm   = api429_codec_ssm_encode_table[format->type][status];
+    AiUInt32 field = 0;
+    AiUInt32 digits;
+    AiUInt32 top;
+    AiUInt32 i;
+    AiDouble scaled;
+    AiDouble max;
+    AiDouble min;
+
+    scaled = value / format->resolution;
+
+    switch(format->type)
+    {
+        case API429_CODEC_BCD:
+            if(scaled < 0.0)
+            {
+                ssm = (status == API429_SSM_NORMAL) ? 3 : ssm;
+                scaled = -scaled;
+            }
+            digits = (width + 3) / 4;
+
+            /* The top digit may have less than 4 bits, e.g. 3 bits hold at most 7 */
+            top = (1u << (width - (digits - 1) * 4)) - 1;
+            max = (AiDouble) (top < 9 ? top : 9);
+            for(i = 1; i < digits; i++)
+            {
+                max = max * 10.0 + 9.0;
+            }
+            scaled = scaled + 0.5;
+            scaled = scaled < max + 1.0 ? scaled : max;
+            for(i = 0; i < digits; i++)
+            {
+                field |= ((AiUInt32) scaled % 10) << (i * 4);
+                scaled /= 10.0;
+            }
+            break;
+
+        case API429_CODEC_DISCRETE:
+            /* Converting negative or too large values to an unsigned integer is undefined, NaN ends up as 0 */
+            max    = (AiDouble) ((((AiInt64) 1) << width) - 1);
+            scaled = value > 0.0 ? value : 0.0;
+            scaled = scaled < max ? scaled : max;
+            field  = (AiUInt32) scaled;
+            break;
+
+        case API429_CODEC_BNR:
+        default:
+            max = (AiDouble) ((((AiInt64) 1) << width) - 1);
+            min = format->is_signed ? -(max + 1.0) : 0.0;
+            scaled = scaled < 0.0 ? scaled - 0.5 : scaled + 0.5;
+            scaled = scaled > max ? max : scaled;
+            scaled = scaled < min ? min : scaled;
+            field  = (AiUInt32) (AiInt32) scaled;
+            break;
+    }
+
+    return ((field << (format->lsb - 1)) & api429_codec_field_mask(format))
+         | ((AiUInt32) label)
+         | (((AiUInt32) sdi << API429_WORD_SDI_POS) & API429_WORD_SDI_MASK)
+         | (ssm << API429_WORD_SSM_POS);
+}
+
+
+/*! \brief Decode an array of data words into engineering units
+ *
+ * The loops of this function contain no data dependent branches and no function calls,
+ * so that compilers can vectorize them (SSE/AVX/NEON) when optimization is enabled.
+ * @param format format of the data words
+ * @param words array of data words, e.g. the content of a label receive buffer
+ * @param count number of data words to decode
+ * @param values array of at least 'count' entries that decoded values are stored to
+ * @param status optional array of at least 'count' entries that decoded \ref api429_ssm_status values are stored to. May be NULL
+ */
+static AI_INLINE void api429_codec_decode_batch(const struct api429_codec_format* format, const AiUInt32* words, AiSize count,
+                                                AiDouble* values, AiUInt8* status)
+{
+    AiUInt32 mask  = api429_codec_field_mask(format);
+    AiUInt32 shift = (AiUInt32) (format->lsb - 1);
+    AiUInt32 sign  = (AiUInt32) (format->is_signed ? 1 : 0) << (format->msb - format->lsb + 1);
+    AiDouble resolution = format->resolution;
+    const AiUInt8* ssm_table = api429_codec_ssm_status_table[format->type];
+    AiSize i;
+
+    switch(format->type)
+    {
+        case API429_CODEC_BCD:
+            for(i = 0; i < count; i++)
+            {
+                values[i] = api429_codec_decode(format, words[i]);
+            }
+            break;
+
+        case API429_CODEC_DISCRETE:
+            resolution = 1.0;
+            /* fall through */
+
+        case API429_CODEC_BNR:
+        default:
+            for(i = 0; i < count; i++)
+            {
+                AiUInt32 field = (words[i] & mask) >> shift;
+
+                values[i] = (AiDouble) (AiInt32) ((field ^ sign) - sign) * resolution;
+            }
+            break;
+    }
+
+    if(status)
+    {
+        for(i = 0; i < count; i++)
+        {
+            status[i] = ssm_table[(words[i] & API429_WORD_SSM_MASK) >> API429_WORD_SSM_POS];
+        }
+    }
+}
+
+
+/*! \brief Decode the content of a label receive buffer into engineering units
+ *
+ * See \ref api429_codec_decode_batch
+ * @param format format of the label
+ * @param entries receive buffer entries as read with \ref Api429RxLabelBufferRead
+ * @param count number of entries to decode
+ * @param values array of at least 'count' entries that decoded values are stored to
+ * @param status optional array of at least 'count' entries that decoded \ref api429_ssm_status values are stored to. May be NULL
+ */
+static AI_INLINE void api429_codec_decode_rx_batch(const struct api429_codec_format* format, const struct api429_rx_buf_entry* entries,
+                                                   AiSize count, AiDouble* values, AiUInt8* status)
+{
+    api429_codec_decode_batch(format, &entries->lab_data, count, values, status);
+}
+
+
+/*! \brief Decode all monitor entries of a specific label into engineering units
+ *
+ * Monitor buffers contain words of all monitored labels. This function
+ * picks the words with matching label and SDI and decodes them. The output arrays are filled
+ * without data dependent branches by always storing and advancing the output index only on a match.
+ * @param format format of the label
+ * @param entries monitor entries as read with \ref Api429RmDataRead
+ * @param count number of monitor entries
+ * @param label label ID to decode
+ * @param sdi SDI to decode. If set to 4, words with any SDI are decoded
+ * @param values array of at least 'count' entries that decoded values are stored to
+ * @param indices optional array of at least 'count' entries the monitor entry index of each decoded value is stored to. May be NULL
+ * @return number of decoded values
+ */
+static AI_INLINE AiSize api429_codec_decode_rm_batch(const struct api429_codec_format* format, const struct api429_rcv_stack_entry* entries,
+                                                     AiSize count, AiUInt8 label, AiUInt8 sdi, AiDouble* values, AiSize* indices)
+{
+    AiUInt32 key_mask = API429_WORD_LABEL_MASK | (sdi < 4 ? API429_WORD_SDI_MASK : 0);
+    AiUInt32 key      = ((AiUInt32) label | ((AiUInt32) sdi << API429_WORD_SDI_POS)) & key_mask;
+    AiUInt32 mask     = api429_codec_field_mask(format);
+    AiUInt32 shift    = (AiUInt32) (format->lsb - 1);
+    AiUInt32 sign     = (AiUInt32) (format->is_signed ? 1 : 0) << (format->msb - format->lsb + 1);
+    AiSize decoded    = 0;
+    AiSize i;
+
+    for(i = 0; i < count; i++)
+    {
+        AiUInt32 word  = entries[i].ldata;
+        AiUInt32 field = (word & mask) >> shift;
+
+        values[decoded] = format->type == API429_CODEC_BCD ? api429_codec_decode(format, word)
+                        : (AiDouble) (AiInt32) ((field ^ sign) - sign) * (format->type == API429_CODEC_BNR ? format->resolution : 1.0);
+        if(indices)
+        {
+            indices[decoded] = i;
+        }
+
+        decoded += ((word & key_mask) == key) ? 1 : 0;
+    }
+
+    return decoded;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429CODEC_H_ */
@@ -0,0 +1,1064 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429EventAwait.h
+ *
+ *  This header file contains inline helper functions
+ *  for waiting for channel events without blocking a thread
+ */
+
+#ifndef API429EVENTAWAIT_H_
+#define API429EVENTAWAIT_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429EventDispatch.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup event_await Awaitable Events
+  This module lets test sequences wait for channel events like \ref API429_EVENT_TX_HALT,
+  \ref API429_EVENT_REPLAY_STOP or \ref API429_EVENT_RM_TRIGGER without polling and without a blocked thread per channel. \n
+  An executor (\ref api429_event_executor) runs short tasks on a few threads. A wait (\ref api429_event_await_wait)
+  is started with \ref api429_event_await_start and holds a task, that is posted to the executor once the event occurs
+  or the timeout expires. So thousands of sequences can wait at the same time, each one only taking the memory of its wait. \n
+  The awaiter (\ref api429_event_await) receives the events as handler of a \ref api429_event_dispatch, which registers
+  the channels with \ref Api429ChannelCallbackRegister. Set \ref api429_event_await_handler for each event type to await. \n
+  When compiled as C++20, the namespace api429 additionally provides coroutines: a sequence is written as
+  api429::flow and uses co_await api429::wait_event(...) or co_await api429::sleep_for(...),
+  and is started on the executor with api429::flow_group::spawn.
+* @{
+*/
+
+
+
+/*! \def API429_EVENT_AWAIT_INFINITE
+ * Timeout of a wait that only ends with the event
+ */
+#define API429_EVENT_AWAIT_INFINITE         0xFFFFFFFFu
+
+/*! \def API429_EVENT_AWAIT_MAX_THREADS
+ * Maximum number of threads of an executor
+ */
+#define API429_EVENT_AWAIT_MAX_THREADS      16
+
+/*! \def API429_EVENT_AWAIT_POLL_US
+ * Maximum time an idle thread sleeps before checking for a stop request
+ */
+#define API429_EVENT_AWAIT_POLL_US          100000
+
+/*! \def API429_EVENT_AWAIT_NO_HEAP
+ * Heap index of a wait without timeout
+ */
+#define API429_EVENT_AWAIT_NO_HEAP          0xFFFFFFFFu
+
+
+
+/*! \typedef API429_EVENT_TASK_ROUTINE
+ * Prototype of a function run by an executor
+ */
+typedef void (AI_CALL_CONV *API429_EVENT_TASK_ROUTINE)(void* arg);
+
+
+/*! \struct api429_event_task
+ *
+ * This structure holds a task of an executor. It is provided by the caller and must stay valid until the task ran
+ */
+struct api429_event_task
+{
+    API429_EVENT_TASK_ROUTINE routine;          /*!< Function to run */
+    void* arg;                                  /*!< Argument passed to 'routine' */
+    struct api429_event_task* next;             /*!< Next task in the queue */
+};
+
+/*! \typedef TY_API429_EVENT_TASK
+ * Convenience typedef for \ref api429_event_task
+ */
+typedef struct api429_event_task TY_API429_EVENT_TASK;
+
+
+/*! \struct api429_event_executor
+ *
+ * This structure holds an executor.
+ * It is created with \ref api429_event_executor_create
+ */
+struct api429_event_executor
+{
+    struct api429_event_task* head;                             /*!< Oldest queued task */
+    struct api429_event_task* tail;                             /*!< Newest queued task */
+    AiUInt32 idle;                                              /*!< Number of threads waiting for tasks */
+    AiUInt64 executed;                                          /*!< Number of tasks run */
+    struct ai_mutex* lock;                                      /*!< Protects the queue */
+    struct ai_event* wake;                                      /*!< Wakes idle threads */
+    struct ai_thread* threads[API429_EVENT_AWAIT_MAX_THREADS];  /*!< The threads */
+    AiUInt32 thread_count;                                      /*!< Number of threads */
+    volatile AiUInt32 stop;                                     /*!< Set to stop the threads */
+};
+
+/*! \typedef TY_API429_EVENT_EXECUTOR
+ * Convenience typedef for \ref api429_event_executor
+ */
+typedef struct api429_event_executor TY_API429_EVENT_EXECUTOR;
+
+
+/*! \struct api429_event_await_wait
+ *
+ * This structure holds a wait for a channel event. It is provided by the caller and must stay valid until its task ran
+ */
+struct api429_event_await_wait
+{
+    struct api429_event_task task;              /*!< Task posted to the executor when the wait ends */
+    AiUInt8 module;                             /*!< Handle to the board of the awaited event */
+    AiUInt8 channel;                            /*!< ID of the channel of the awaited event */
+    enum api429_event_type type;                /*!< Type of the awaited event */
+    AiBoolean listed;                           /*!< AiTrue if the wait is ended by an event */
+    AiBoolean pending;                          /*!< AiTrue while the wait has not ended */
+    AiUInt64 deadline_us;                       /*!< Host time the wait times out, see \ref ai_clock_us */
+    AiUInt32 heap_index;                        /*!< Position in the timeout heap, or \ref API429_EVENT_AWAIT_NO_HEAP */
+    struct api429_event_await_wait* prev;       /*!< Previous wait for the same event */
+    struct api429_event_await_wait* next;       /*!< Next wait for the same event */
+    AiReturn result;                            /*!< API_OK if the event occurred, AI429_ERR_TIMEOUT otherwise */
+    struct api429_event_dispatch_event event;   /*!< The event, valid if 'result' is API_OK */
+};
+
+/*! \typedef TY_API429_EVENT_AWAIT_WAIT
+ * Convenience typedef for \ref api429_event_await_wait
+ */
+typedef struct api429_event_await_wait TY_API429_EVENT_AWAIT_WAIT;
+
+
+/*! \struct api429_event_await
+ *
+ * This structure holds the pending waits for channel events.
+ * It is created with \ref api429_event_await_create
+ */
+struct api429_event_await
+{
+    struct api429_event_executor* executor;     /*!< Executor the tasks of ended waits are posted to */
+    struct api429_event_await_wait** waits;     /*!< Lists of waits per board, channel and event type */
+    struct api429_event_await_wait** heap;      /*!< Waits with timeout, ordered by deadline */
+    AiUInt32 heap_count;                        /*!< Number of waits in 'heap' */
+    AiUInt32 heap_capacity;                     /*!< Size of 'heap' */
+    AiUInt64 events;                            /*!< Number of events received */
+    AiUInt64 completed;                         /*!< Number of waits ended by an event */
+    AiUInt64 timeouts;                          /*!< Number of waits ended by a timeout or cancelled */
+    struct ai_mutex* lock;                      /*!< Protects all of the above */
+    struct ai_event* wake;                      /*!< Wakes the timer thread */
+    struct ai_thread* timer;                    /*!< Timer thread */
+    volatile AiUInt32 stop;                     /*!< Set to stop the timer thread */
+};
+
+/*! \typedef TY_API429_EVENT_AWAIT
+ * Convenience typedef for \ref api429_event_await
+ */
+typedef struct api429_event_await TY_API429_EVENT_AWAIT;
+
+
+
+
+/*! \brief Post a task to an executor
+ *
+ * May be called from any thread, including tasks of the executor.
+ * @param [in] executor the executor
+ * @param [in] task the task. Must stay valid until it ran
+ */
+static AI_INLINE void api429_event_executor_post(struct api429_event_executor* executor, struct api429_event_task* task)
+{
+    AiBoolean idle;
+
+    task->next = NULL;
+
+    ai_mutex_lock(executor->lock);
+
+    if(executor->tail)
+    {
+        executor->tail->next = task;
+    }
+    else
+    {
+        executor->head = task;
+    }
+
+    executor->tail = task;
+    idle           = executor->idle != 0;
+
+    ai_mutex_release(executor->lock);
+
+    if(idle)
+    {
+        ai_event_signal(executor->wake);
+    }
+}
+
+
+/*! \brief Routine of the executor threads
+ */
+static void api429_event_executor_thread(void* arg)
+{
+    struct api429_event_executor* executor = (struct api429_event_executor*) arg;
+    struct api429_event_task* task;
+    AiUInt32 value;
+
+    ai_mutex_lock(executor->lock);
+
+    for(;;)
+    {
+        task = executor->head;
+
+        if(task)
+        {
+            executor->head = task->next;
+            executor->tail = executor->head ? executor->tail : NULL;
+            executor->executed++;
+
+            ai_mutex_release(executor->lock);
+
+            /* The task may be released by its routine */
+            task->routine(task->arg);
+
+            ai_mutex_lock(executor->lock);
+            continue;
+        }
+
+        /* Tasks queued before stopping are still run */
+        if(ai_atomic_u32_load(&executor->stop))
+        {
+            break;
+        }
+
+        executor->idle++;
+        value = ai_event_value(executor->wake);
+
+        ai_mutex_release(executor->lock);
+
+        ai_event_wait(executor->wake, value, API429_EVENT_AWAIT_POLL_US);
+
+        ai_mutex_lock(executor->lock);
+        executor->idle--;
+    }
+
+    ai_mutex_release(executor->lock);
+}
+
+
+/*! \brief Release an executor
+ *
+ * Runs the queued tasks and stops the threads.
+ * @param executor executor to release. May be NULL
+ */
+static AI_INLINE void api429_event_executor_free(struct api429_event_executor* executor)
+{
+    AiUInt32 i;
+
+    if(!executor)
+    {
+        return;
+    }
+
+    ai_atomic_u32_store(&executor->stop, 1);
+
+    if(executor->wake)
+    {
+        ai_event_signal(executor->wake);
+    }
+
+    for(i = 0; i < executor->thread_count; i++)
+    {
+        ai_thread_join(executor->threads[i]);
+    }
+
+    if(executor->lock)
+    {
+        ai_mutex_free(executor->lock);
+    }
+
+    if(executor->wake)
+    {
+        ai_event_free(executor->wake);
+    }
+
+    free(executor);
+}
+
+
+/*! \brief Create an executor
+ *
+ * @param [in] threads number of threads, at most \ref API429_EVENT_AWAIT_MAX_THREADS
+ * @param [out] executor_out the created executor is stored here. Must be released with \ref api429_event_executor_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_executor_create(AiUInt32 threads, struct api429_event_executor** executor_out)
+{
+    struct api429_event_executor* executor;
+    AiUInt32 i;
+
+    if(!executor_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *executor_out = NULL;
+
+    if(!threads || threads > API429_EVENT_AWAIT_MAX_THREADS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    executor = (struct api429_event_executor*) calloc(1, sizeof(struct api429_event_executor));
+    if(!executor)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    executor->lock = ai_mutex_create();
+    executor->wake = ai_event_create();
+
+    if(!executor->lock || !executor->wake)
+    {
+        api429_event_executor_free(executor);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    for(i = 0; i < threads; i++)
+    {
+        executor->threads[i] = ai_thread_create(api429_event_executor_thread, executor);
+        if(!executor->threads[i])
+        {
+            api429_event_executor_free(executor);
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+
+        executor->thread_count++;
+    }
+
+    *executor_out = executor;
+
+    return API_OK;
+}
+
+
+/*! \brief Swap two entries of the timeout heap
+ */
+static AI_INLINE void api429_event_await_heap_swap(struct api429_event_await* await, AiUInt32 a, AiUInt32 b)
+{
+    struct api429_event_await_wait* wait = await->heap[a];
+
+    await->heap[a] = await->heap[b];
+    await->heap[b] = wait;
+
+    await->heap[a]->heap_index = a;
+    await->heap[b]->heap_index = b;
+}
+
+
+/*! \brief Restore the heap order of an entry of the timeout heap
+ */
+static AI_INLINE void api429_event_await_heap_fix(struct api429_event_await* await, AiUInt32 i)
+{
+    AiUInt32 child;
+
+    while(i > 0 && await->heap[i]->deadline_us < await->heap[(i - 1) / 2]->deadline_us)
+    {
+        api429_event_await_heap_swap(await, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+
+    for(;;)
+    {
+        child = 2 * i + 1;
+
+        if(child >= await->heap_count)
+        {
+            break;
+        }
+
+        if(child + 1 < await->heap_count && await->heap[child + 1]->deadline_us < await->heap[child]->deadline_us)
+        {
+            child++;
+        }
+
+        if(await->heap[i]->deadline_us <= await->heap[child]->deadline_us)
+        {
+            break;
+        }
+
+        api429_event_await_heap_swap(await, i, child);
+        i = child;
+    }
+}
+
+
+/*! \brief Get the list of waits for an event
+ */
+static AI_INLINE struct api429_event_await_wait** api429_event_await_list(struct api429_event_await* await, AiUInt8 module,
+                                                                          AiUInt8 channel, enum api429_event_type type)
+{
+    return &await->waits[((AiUInt32) module * API429_EVENT_DISPATCH_CHANNELS + channel) * API429_EVENT_DISPATCH_TYPES + type];
+}
+
+
+/*! \brief End a wait and post its task
+ *
+ * Must be called with the lock held. The wait must not be accessed afterwards.
+ */
+static AI_INLINE void api429_event_await_end(struct api429_event_await* await, struct api429_event_await_wait* wait, AiReturn result)
+{
+    struct api429_event_await_wait** list;
+    AiUInt32 i = wait->heap_index;
+
+    if(wait->listed)
+    {
+        list = api429_event_await_list(await, wait->module, wait->channel, wait->type);
+
+        if(wait->prev)
+        {
+            wait->prev->next = wait->next;
+        }
+        else
+        {
+            *list = wait->next;
+        }
+
+        if(wait->next)
+        {
+            wait->next->prev = wait->prev;
+        }
+    }
+
+    if(i != API429_EVENT_AWAIT_NO_HEAP)
+    {
+        await->heap_count--;
+
+        if(i != await->heap_count)
+        {
+            api429_event_await_heap_swap(await, i, await->heap_count);
+            api429_event_await_heap_fix(await, i);
+        }
+    }
+
+    wait->heap_index = API429_EVENT_AWAIT_NO_HEAP;
+    wait->pending    = AiFalse;
+    wait->result     = result;
+
+    if(result == API_OK)
+    {
+        await->completed++;
+    }
+    else
+    {
+        await->timeouts++;
+    }
+
+    api429_event_executor_post(await->executor, &wait->task);
+}
+
+
+/*! \brief Add a wait
+ */
+static AI_INLINE AiReturn api429_event_await_add(struct api429_event_await* await, struct api429_event_await_wait* wait, AiBoolean listed,
+                                                 AiUInt32 timeout_us, API429_EVENT_TASK_ROUTINE routine, void* arg)
+{
+    struct api429_event_await_wait** heap;
+    struct api429_event_await_wait** list;
+    AiBoolean earliest = AiFalse;
+
+    wait->task.routine = routine;
+    wait->task.arg     = arg;
+    wait->listed       = listed;
+    wait->pending      = AiTrue;
+    wait->heap_index   = API429_EVENT_AWAIT_NO_HEAP;
+    wait->prev         = NULL;
+    wait->next         = NULL;
+    wait->result       = AI429_ERR_TIMEOUT;
+    wait->deadline_us  = ai_clock_us() + timeout_us;
+
+    ai_mutex_lock(await->lock);
+
+    if(timeout_us != API429_EVENT_AWAIT_INFINITE)
+    {
+        if(await->heap_count == await->heap_capacity)
+        {
+            heap = (struct api429_event_await_wait**) realloc(await->heap, (await->heap_capacity * 2 + 64) * sizeof(struct api429_event_await_wait*));
+            if(!heap)
+            {
+                ai_mutex_release(await->lock);
+                return AI429_ERR_NO_MORE_MEMORY;
+            }
+
+            await->heap           = heap;
+            await->heap_capacity  = await->heap_capacity * 2 + 64;
+        }
+
+        wait->heap_index = await->heap_count;
+        await->heap[await->heap_count++] = wait;
+        api429_event_await_heap_fix(await, wait->heap_index);
+
+        earliest = wait->heap_index == 0;
+    }
+
+    if(listed)
+    {
+        list = api429_event_await_list(await, wait->module, wait->channel, wait->type);
+
+        wait->next = *list;
+        if(*list)
+        {
+            (*list)->prev = wait;
+        }
+        *list = wait;
+    }
+
+    ai_mutex_release(await->lock);
+
+    if(earliest)
+    {
+        ai_event_signal(await->wake);
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Start waiting for a channel event
+ *
+ * The wait ends with the next event of the given type on the channel, or when the timeout expires.
+ * Then 'routine' is run by the executor. Start the wait before the action that causes the event.
+ * @param [in] await the awaiter
+ * @param [in] wait the wait. Must stay valid until 'routine' ran
+ * @param [in] module handle to the board of the event
+ * @param [in] channel ID of the channel of the event
+ * @param [in] type type of the event
+ * @param [in] timeout_us maximum time to wait in microseconds, or \ref API429_EVENT_AWAIT_INFINITE
+ * @param [in] routine function run when the wait ended. The result is stored in the wait
+ * @param [in] arg argument passed to 'routine'
+ * @return
+ * - API_OK on success. 'routine' will be run exactly once
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet. 'routine' will not be run
+ */
+static AI_INLINE AiReturn api429_event_await_start(struct api429_event_await* await, struct api429_event_await_wait* wait, AiUInt8 module,
+                                                   AiUInt8 channel, enum api429_event_type type, AiUInt32 timeout_us,
+                                                   API429_EVENT_TASK_ROUTINE routine, void* arg)
+{
+    if(!await || !wait || !routine)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS || (AiUInt32) type >= API429_EVENT_DISPATCH_TYPES)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    wait->module  = module;
+    wait->channel = channel;
+    wait->type    = type;
+
+    return api429_event_await_add(await, wait, AiTrue, timeout_us, routine, arg);
+}
+
+
+/*! \brief Start waiting for a time
+ *
+ * After the time expired, 'routine' is run by the executor. The result of the wait is AI429_ERR_TIMEOUT.
+ * @param [in] await the awaiter
+ * @param [in] wait the wait. Must stay valid until 'routine' ran
+ * @param [in] time_us time to wait in microseconds
+ * @param [in] routine function run when the time expired
+ * @param [in] arg argument passed to 'routine'
+ * @return
+ * - API_OK on success. 'routine' will be run exactly once
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet. 'routine' will not be run
+ */
+static AI_INLINE AiReturn api429_event_await_sleep(struct api429_event_await* await, struct api429_event_await_wait* wait, AiUInt32 time_us,
+                                                   API429_EVENT_TASK_ROUTINE routine, void* arg)
+{
+    if(!await || !wait || !routine)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(time_us == API429_EVENT_AWAIT_INFINITE)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    return api429_event_await_add(await, wait, AiFalse, time_us, routine, arg);
+}
+
+
+/*! \brief End a wait early
+ *
+ * If the wait has not ended yet, it ends with AI429_ERR_TIMEOUT and its routine is run by the executor.
+ * @param [in] await the awaiter
+ * @param [in] wait the wait
+ * @return AiTrue if the wait was ended, AiFalse if it had already ended
+ */
+static AI_INLINE AiBoolean api429_event_await_cancel(struct api429_event_await* await, struct api429_event_await_wait* wait)
+{
+    AiBoolean pending;
+
+    ai_mutex_lock(await->lock);
+
+    pending = wait->pending;
+    if(pending)
+    {
+        api429_event_await_end(await, wait, AI429_ERR_TIMEOUT);
+    }
+
+    ai_mutex_release(await->lock);
+
+    return pending;
+}
+
+
+/*! \brief Handler for \ref api429_event_dispatch_handler_set
+ *
+ * Pass the awaiter as context and set the handler for each event type that is awaited.
+ * Ends all waits for the event.
+ */
+static AI_INLINE void AI_CALL_CONV api429_event_await_handler(const struct api429_event_dispatch_event* event, void* context)
+{
+    struct api429_event_await* await = (struct api429_event_await*) context;
+    struct api429_event_await_wait* wait;
+    struct api429_event_await_wait* next;
+
+    if(event->module >= API429_EVENT_DISPATCH_MODULES || event->channel >= API429_EVENT_DISPATCH_CHANNELS
+       || (AiUInt32) event->type >= API429_EVENT_DISPATCH_TYPES)
+    {
+        return;
+    }
+
+    ai_mutex_lock(await->lock);
+
+    await->events++;
+
+    for(wait = *api429_event_await_list(await, event->module, event->channel, event->type); wait; wait = next)
+    {
+        next        = wait->next;
+        wait->event = *event;
+
+        api429_event_await_end(await, wait, API_OK);
+    }
+
+    ai_mutex_release(await->lock);
+}
+
+
+/*! \brief Routine of the timer thread
+ */
+static void api429_event_await_timer(void* arg)
+{
+    struct api429_event_await* await = (struct api429_event_await*) arg;
+    AiUInt64 now;
+    AiUInt64 wait_us;
+    AiUInt32 value;
+
+    while(!ai_atomic_u32_load(&await->stop))
+    {
+        value   = ai_event_value(await->wake);
+        wait_us = API429_EVENT_AWAIT_POLL_US;
+
+        ai_mutex_lock(await->lock);
+
+        now = ai_clock_us();
+
+        while(await->heap_count && await->heap[0]->deadline_us <= now)
+        {
+            api429_event_await_end(await, await->heap[0], AI429_ERR_TIMEOUT);
+        }
+
+        if(await->heap_count && await->heap[0]->deadline_us - now < wait_us)
+        {
+            wait_us = await->heap[0]->deadline_us - now;
+        }
+
+        ai_mutex_release(await->lock);
+
+        ai_event_wait(await->wake, value, (AiUInt32) wait_us);
+    }
+}
+
+
+/*! \brief Release an awaiter
+ *
+ * Waits that have not ended yet end with AI429_ERR_TIMEOUT. Their routines are run by the executor,
+ * which must be released after the awaiter. Remove the handler from the dispatcher before.
+ * @param await awaiter to release. May be NULL
+ */
+static AI_INLINE void api429_event_await_free(struct api429_event_await* await)
+{
+    AiUInt32 i, count;
+
+    if(!await)
+    {
+        return;
+    }
+
+    if(await->timer)
+    {
+        ai_atomic_u32_store(&await->stop, 1);
+        ai_event_signal(await->wake);
+        ai_thread_join(await->timer);
+    }
+
+    if(await->waits)
+    {
+        count = API429_EVENT_DISPATCH_MODULES * API429_EVENT_DISPATCH_CHANNELS * API429_EVENT_DISPATCH_TYPES;
+
+        for(i = 0; i < count; i++)
+        {
+            while(await->waits[i])
+            {
+                api429_event_await_end(await, await->waits[i], AI429_ERR_TIMEOUT);
+            }
+        }
+    }
+
+    /* Sleeps are only held by the heap */
+    while(await->heap_count)
+    {
+        api429_event_await_end(await, await->heap[0], AI429_ERR_TIMEOUT);
+    }
+
+    if(await->lock)
+    {
+        ai_mutex_free(await->lock);
+    }
+
+    if(await->wake)
+    {
+        ai_event_free(await->wake);
+    }
+
+    free(await->waits);
+    free(await->heap);
+    free(await);
+}
+
+
+/*! \brief Create an awaiter
+ *
+ * @param [in] executor executor that runs the routines of ended waits
+ * @param [out] await_out the created awaiter is stored here. Must be released with \ref api429_event_await_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_await_create(struct api429_event_executor* executor, struct api429_event_await** await_out)
+{
+    struct api429_event_await* await;
+
+    if(!executor || !await_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *await_out = NULL;
+
+    await = (struct api429_event_await*) calloc(1, sizeof(struct api429_event_await));
+    if(!await)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    await->executor = executor;
+    await->waits    = (struct api429_event_await_wait**) calloc(API429_EVENT_DISPATCH_MODULES * API429_EVENT_DISPATCH_CHANNELS
+                                                                * API429_EVENT_DISPATCH_TYPES, sizeof(struct api429_event_await_wait*));
+    await->lock     = ai_mutex_create();
+    await->wake     = ai_event_create();
+
+    if(!await->waits || !await->lock || !await->wake)
+    {
+        api429_event_await_free(await);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    await->timer = ai_thread_create(api429_event_await_timer, await);
+    if(!await->timer)
+    {
+        api429_event_await_free(await);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *await_out = await;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#if defined(__cplusplus) && __cplusplus >= 202002L
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+
+namespace api429
+{
+    /*! \brief Result of an awaited event
+     */
+    struct event_result
+    {
+        AiReturn result;                            /*!< API_OK if the event occurred, AI429_ERR_TIMEOUT otherwise */
+        struct api429_event_dispatch_event event;   /*!< The event, valid if 'result' is API_OK */
+    };
+
+
+    /*! \brief Awaitable that ends with a channel event, a timeout or the given time
+     *
+     * Created by \ref wait_event and \ref sleep_for. The coroutine is resumed on the executor of the awaiter.
+     */
+    class event_awaitable
+    {
+    public:
+        event_awaitable(struct api429_event_await* await, AiUInt8 module, AiUInt8 channel, enum api429_event_type type,
+                        AiUInt32 timeout_us, bool listed) noexcept
+            : await_(await), module_(module), channel_(channel), type_(type), timeout_us_(timeout_us), listed_(listed), ret_(API_OK)
+        {
+        }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle) noexcept
+        {
+            AiReturn ret;
+
+            handle_ = handle;
+
+            ret = listed_ ? api429_event_await_start(await_, &wait_, module_, channel_, type_, timeout_us_, resume, this)
+                          : api429_event_await_sleep(await_, &wait_, timeout_us_, resume, this);
+
+            /* On success the coroutine may already run on the executor, so this object must not be touched anymore */
+            if(ret != API_OK)
+            {
+                ret_ = ret;
+                return false;
+            }
+
+            return true;
+        }
+
+        event_result await_resume() const noexcept
+        {
+            event_result result;
+
+            result.result = ret_ != API_OK ? ret_ : wait_.result;
+            result.event  = wait_.event;
+
+            return result;
+        }
+
+    private:
+        static void AI_CALL_CONV resume(void* arg)
+        {
+            static_cast<event_awaitable*>(arg)->handle_.resume();
+        }
+
+        struct api429_event_await* await_;
+        AiUInt8 module_;
+        AiUInt8 channel_;
+        enum api429_event_type type_;
+        AiUInt32 timeout_us_;
+        bool listed_;
+        AiReturn ret_;
+        struct api429_event_await_wait wait_ {};
+        std::coroutine_handle<> handle_;
+    };
+
+
+    /*! \brief Wait for a channel event
+     *
+     * co_await api429::wait_event(...) returns an \ref event_result. Use \ref api429_event_await_start directly,
+     * if the wait has to be started before an action that is awaited later.
+     */
+    inline event_awaitable wait_event(struct api429_event_await* await, AiUInt8 module, AiUInt8 channel, enum api429_event_type type,
+                                      AiUInt32 timeout_us = API429_EVENT_AWAIT_INFINITE) noexcept
+    {
+        return event_awaitable(await, module, channel, type, timeout_us, true);
+    }
+
+
+    /*! \brief Wait for a time without blocking a thread
+     */
+    inline event_awaitable sleep_for(struct api429_event_await* await, AiUInt32 time_us) noexcept
+    {
+        return event_awaitable(await, 0, 0, API429_EVENT_UNDEFINED, time_us, false);
+    }
+
+
+    class flow_group;
+
+
+    /*! \brief Coroutine of a test sequence
+     *
+     * A flow does not run until it is passed to \ref flow_group::spawn.
+     * It runs on the threads of the executor and must not block them.
+     */
+    class flow
+    {
+    public:
+        struct promise_type
+        {
+            struct api429_event_task task {};
+            flow_group* group = nullptr;
+
+            flow get_return_object() noexcept
+            {
+                return flow(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            {
+            }
+
+            void unhandled_exception() const noexcept
+            {
+                std::terminate();
+            }
+
+            ~promise_type();
+        };
+
+        flow(flow&& other) noexcept : handle_(std::exchange(other.handle_, nullptr))
+        {
+        }
+
+        flow(const flow&) = delete;
+        flow& operator=(const flow&) = delete;
+        flow& operator=(flow&&) = delete;
+
+        ~flow()
+        {
+            if(handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+    private:
+        friend class flow_group;
+
+        explicit flow(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle)
+        {
+        }
+
+        static void AI_CALL_CONV start(void* arg)
+        {
+            std::coroutine_handle<promise_type>::from_address(arg).resume();
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+
+    /*! \brief Set of running flows
+     *
+     * Starts flows on an executor and waits until all of them finished.
+     */
+    class flow_group
+    {
+    public:
+        flow_group() = default;
+        flow_group(const flow_group&) = delete;
+        flow_group& operator=(const flow_group&) = delete;
+
+        ~flow_group()
+        {
+            wait();
+        }
+
+        /*! \brief Start a flow on an executor */
+        void spawn(struct api429_event_executor* executor, flow f) noexcept
+        {
+            std::coroutine_handle<flow::promise_type> handle = std::exchange(f.handle_, nullptr);
+            flow::promise_type& promise = handle.promise();
+
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                active_++;
+            }
+
+            promise.group        = this;
+            promise.task.routine = flow::start;
+            promise.task.arg     = handle.address();
+
+            api429_event_executor_post(executor, &promise.task);
+        }
+
+        /*! \brief Wait until all started flows finished */
+        void wait()
+        {
+            std::unique_lock<std::mutex> guard(lock_);
+            done_.wait(guard, [this] { return active_ == 0; });
+        }
+
+    private:
+        friend struct flow::promise_type;
+
+        void finished() noexcept
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+
+            /* Notify with the lock held, so the group may be destroyed as soon as wait returns */
+            if(--active_ == 0)
+            {
+                done_.notify_all();
+            }
+        }
+
+        std::mutex lock_;
+        std::condition_variable done_;
+        AiUInt64 active_ = 0;
+    };
+
+
+    inline flow::promise_type::~promise_type()
+    {
+        if(group)
+        {
+            group->finished();
+        }
+    }
+}
+
+#endif /* __cplusplus >= 202002L */
+
+
+
+#endif /* API429EVENTAWAIT_H_ */
@@ -0,0 +1,650 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429EventCoalesce.h
+ *
+ *  This header file contains inline helper functions
+ *  for delivering high-rate label events in batches
+ */
+
+#ifndef API429EVENTCOALESCE_H_
+#define API429EVENTCOALESCE_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429EventDispatch.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup event_coalesce Event Coalescing
+  This module groups label events, so a busy channel with an interrupt per received or sent label
+  does not result in a callback per data word. \n
+  Events of type \ref API429_EVENT_RX_ANY_LABEL and \ref API429_EVENT_TX_LABEL are collected per board, channel,
+  type and label ID (receive) or transfer index (transmit), as found in the
+  info field of \ref api429_intr_loglist_entry.x_Llc. A group is closed when it holds the configured number of events,
+  or when the configured time passed since its first event. Closed groups are delivered as one batch with an
+  array of \ref api429_intr_loglist_entry by a service thread, never by the thread that reported the event. \n
+  Counts are exact: if no batch buffer is free when an event arrives, the event is not stored,
+  but still counted in \ref api429_event_coalesce_batch.dropped of the next batch of its group,
+  which is delivered without entries if the group stays quiet.
+  The group table grows when more groups are seen than given at creation. \n
+  Events are fed with \ref api429_event_coalesce_event, e.g. from a driver callback, or by setting
+  \ref api429_event_coalesce_handler as handler of both event types of a \ref api429_event_dispatch.
+* @{
+*/
+
+
+
+/*! \def API429_EVENT_COALESCE_MIN_WAIT_US
+ * Shortest time the service thread sleeps between two checks for expired groups
+ */
+#define API429_EVENT_COALESCE_MIN_WAIT_US   1000
+
+
+
+/*! \struct api429_event_coalesce_batch
+ *
+ * This structure holds the events of one group
+ */
+struct api429_event_coalesce_batch
+{
+    AiUInt8 module;                             /*!< Handle to the board that raised the events */
+    AiUInt8 channel;                            /*!< ID of the channel that raised the events */
+    enum api429_event_type type;                /*!< Type of the events */
+    AiUInt32 id;                                /*!< Label ID or transfer index of the events */
+    AiUInt32 count;                             /*!< Number of events in 'entries' */
+    AiUInt64 dropped;                           /*!< Number of further events of the group that were not stored */
+    AiUInt64 first_us;                          /*!< Host time the first event of the group was received, see \ref ai_clock_us */
+    AiUInt64 last_us;                           /*!< Host time the last event of the group was received */
+    struct api429_intr_loglist_entry* entries;  /*!< The events in the order they were received */
+};
+
+/*! \typedef TY_API429_EVENT_COALESCE_BATCH
+ * Convenience typedef for \ref api429_event_coalesce_batch
+ */
+typedef struct api429_event_coalesce_batch TY_API429_EVENT_COALESCE_BATCH;
+
+
+/*! \typedef API429_EVENT_COALESCE_DELIVER
+ * Prototype of a function that receives batches of events. \n
+ * The batch is only valid until the function returns.
+ */
+typedef void (AI_CALL_CONV *API429_EVENT_COALESCE_DELIVER)(const struct api429_event_coalesce_batch* batch, void* context);
+
+
+/*! \struct api429_event_coalesce_group
+ *
+ * This structure holds the state of one group
+ */
+struct api429_event_coalesce_group
+{
+    AiUInt64 key;                               /*!< Board, channel, type and ID of the group */
+    AiBoolean used;                             /*!< AiTrue if the slot holds a group */
+    struct api429_event_coalesce_batch* batch;  /*!< Batch the group collects into. NULL if none */
+    AiUInt64 dropped;                           /*!< Events not stored since the last batch */
+};
+
+/*! \typedef TY_API429_EVENT_COALESCE_GROUP
+ * Convenience typedef for \ref api429_event_coalesce_group
+ */
+typedef struct api429_event_coalesce_group TY_API429_EVENT_COALESCE_GROUP;
+
+
+/*! \struct api429_event_coalesce_metrics
+ *
+ * This structure reports the metrics of a coalescer
+ */
+struct api429_event_coalesce_metrics
+{
+    AiUInt64 events;                            /*!< Number of events received */
+    AiUInt64 batches;                           /*!< Number of batches delivered */
+    AiUInt64 dropped;                           /*!< Number of events that were counted, but not stored */
+    AiUInt64 untracked;                         /*!< Number of events lost because the group table could not grow for lack of memory */
+    AiUInt32 groups;                            /*!< Number of groups */
+};
+
+/*! \typedef TY_API429_EVENT_COALESCE_METRICS
+ * Convenience typedef for \ref api429_event_coalesce_metrics
+ */
+typedef struct api429_event_coalesce_metrics TY_API429_EVENT_COALESCE_METRICS;
+
+
+/*! \struct api429_event_coalesce
+ *
+ * This structure holds a coalescer.
+ * It is created with \ref api429_event_coalesce_create
+ */
+struct api429_event_coalesce
+{
+    API429_EVENT_COALESCE_DELIVER deliver;          /*!< Receives the batches */
+    void* context;                                  /*!< User data passed to 'deliver' */
+    AiUInt32 count_max;                             /*!< Number of events that closes a group */
+    AiUInt32 window_us;                             /*!< Time after the first event that closes a group */
+    struct api429_event_coalesce_group* groups;     /*!< Hash table of groups */
+    AiUInt32 group_mask;                            /*!< Size of 'groups' minus one */
+    struct api429_event_coalesce_batch* batches;    /*!< All batch buffers */
+    struct api429_intr_loglist_entry* storage;      /*!< Entries of all batch buffers */
+    AiUInt32 batch_count;                           /*!< Number of batch buffers */
+    struct api429_event_coalesce_batch** free;      /*!< Stack of free batch buffers */
+    AiUInt32 free_count;                            /*!< Number of free batch buffers */
+    struct api429_event_coalesce_batch** ready;     /*!< Ring of closed batches in the order they were closed */
+    AiUInt32 ready_head;                            /*!< Index of the oldest closed batch */
+    AiUInt32 ready_count;                           /*!< Number of closed batches */
+    struct api429_event_coalesce_metrics metrics;   /*!< Metrics */
+    struct ai_mutex* lock;                          /*!< Protects all of the above */
+    struct ai_event* wake;                          /*!< Wakes the service thread */
+    struct ai_thread* thread;                       /*!< Service thread */
+    volatile AiUInt32 stop;                         /*!< Set to stop the service thread */
+};
+
+/*! \typedef TY_API429_EVENT_COALESCE
+ * Convenience typedef for \ref api429_event_coalesce
+ */
+typedef struct api429_event_coalesce TY_API429_EVENT_COALESCE;
+
+
+
+
+/*! \brief Close the batch of a group
+ *
+ * Must be called with the lock held.
+ */
+static AI_INLINE void api429_event_coalesce_close(struct api429_event_coalesce* coalesce, struct api429_event_coalesce_group* group)
+{
+    coalesce->ready[(coalesce->ready_head + coalesce->ready_count) % coalesce->batch_count] = group->batch;
+    coalesce->ready_count++;
+
+    group->batch = NULL;
+}
+
+
+/*! \brief Open a batch for a group
+ *
+ * Must be called with the lock held and a free batch buffer.
+ */
+static AI_INLINE void api429_event_coalesce_open(struct api429_event_coalesce* coalesce, struct api429_event_coalesce_group* group, AiUInt64 now)
+{
+    struct api429_event_coalesce_batch* batch = coalesce->free[--coalesce->free_count];
+
+    batch->module   = (AiUInt8) (group->key >> 40);
+    batch->channel  = (AiUInt8) (group->key >> 32);
+    batch->type     = (enum api429_event_type) ((group->key >> 24) & 0xFF);
+    batch->id       = (AiUInt32) (group->key & 0xFFFFFF);
+    batch->count    = 0;
+    batch->dropped  = group->dropped;
+    batch->first_us = now;
+    batch->last_us  = now;
+
+    group->batch   = batch;
+    group->dropped = 0;
+}
+
+
+/*! \brief Get the slot of a group in the hash table
+ *
+ * Must be called with the lock held.
+ * @return the slot holding the group, or the free slot the group is added to
+ */
+static AI_INLINE struct api429_event_coalesce_group* api429_event_coalesce_group_slot(struct api429_event_coalesce_group* groups, AiUInt32 mask,
+                                                                                      AiUInt64 key)
+{
+    AiUInt32 hash = (AiUInt32) (key ^ (key >> 29)) * 0x9E3779B1u;
+
+    /* The table is never full, so the search ends */
+    while(groups[hash & mask].used && groups[hash & mask].key != key)
+    {
+        hash++;
+    }
+
+    return &groups[hash & mask];
+}
+
+
+/*! \brief Double the size of the hash table
+ *
+ * Must be called with the lock held.
+ * @return AiTrue on success, AiFalse if no memory is available
+ */
+static AI_INLINE AiBoolean api429_event_coalesce_grow(struct api429_event_coalesce* coalesce)
+{
+    struct api429_event_coalesce_group* groups;
+    AiUInt32 mask = coalesce->group_mask * 2 + 1;
+    AiUInt32 i;
+
+    if(mask < coalesce->group_mask)
+    {
+        return AiFalse;
+    }
+
+    groups = (struct api429_event_coalesce_group*) calloc((AiSize) mask + 1, sizeof(struct api429_event_coalesce_group));
+    if(!groups)
+    {
+        return AiFalse;
+    }
+
+    for(i = 0; i <= coalesce->group_mask; i++)
+    {
+        if(coalesce->groups[i].used)
+        {
+            *api429_event_coalesce_group_slot(groups, mask, coalesce->groups[i].key) = coalesce->groups[i];
+        }
+    }
+
+    free(coalesce->groups);
+
+    coalesce->groups     = groups;
+    coalesce->group_mask = mask;
+
+    return AiTrue;
+}
+
+
+/*! \brief Find or add the group of an event
+ *
+ * Must be called with the lock held. Grows the table if it would be more than half full.
+ * @return the group, or NULL if the table can not grow
+ */
+static AI_INLINE struct api429_event_coalesce_group* api429_event_coalesce_group_get(struct api429_event_coalesce* coalesce, AiUInt64 key)
+{
+    struct api429_event_coalesce_group* group;
+
+    group = api429_event_coalesce_group_slot(coalesce->groups, coalesce->group_mask, key);
+
+    if(group->used)
+    {
+        return group;
+    }
+
+    if(coalesce->metrics.groups + 1 > (coalesce->group_mask + 1) / 2)
+    {
+        if(!api429_event_coalesce_grow(coalesce))
+        {
+            return NULL;
+        }
+
+        group = api429_event_coalesce_group_slot(coalesce->groups, coalesce->group_mask, key);
+    }
+
+    group->used = AiTrue;
+    group->key  = key;
+    coalesce->metrics.groups++;
+
+    return group;
+}
+
+
+/*! \brief Collect an event
+ *
+ * May be called from any thread, e.g. from the callback registered with \ref Api429ChannelCallbackRegister.
+ * Never calls the delivery function.
+ * @param [in] coalesce the coalescer
+ * @param [in] module handle to the board that raised the event
+ * @param [in] channel ID of the channel that raised the event
+ * @param [in] type type of the event
+ * @param [in] info information about the source of the event
+ * @return AiTrue if the event was collected, AiFalse if the event type is not coalesced and must be handled by the caller
+ */
+static AI_INLINE AiBoolean api429_event_coalesce_event(struct api429_event_coalesce* coalesce, AiUInt8 module, AiUInt8 channel,
+                                                       enum api429_event_type type, const struct api429_intr_loglist_entry* info)
+{
+    struct api429_event_coalesce_group* group;
+    struct api429_event_coalesce_batch* batch;
+    AiUInt64 now = ai_clock_us();
+    AiUInt32 id;
+    AiBoolean closed = AiFalse;
+
+    if(!coalesce || !info || (type != API429_EVENT_RX_ANY_LABEL && type != API429_EVENT_TX_LABEL))
+    {
+        return AiFalse;
+    }
+
+    id = info->x_Llc.t.ul_Info;
+
+    ai_mutex_lock(coalesce->lock);
+
+    coalesce->metrics.events++;
+
+    group = api429_event_coalesce_group_get(coalesce, ((AiUInt64) module << 40) | ((AiUInt64) channel << 32) | ((AiUInt64) type << 24) | id);
+    if(!group)
+    {
+        coalesce->metrics.untracked++;
+        ai_mutex_release(coalesce->lock);
+        return AiTrue;
+    }
+
+    if(!group->batch && coalesce->free_count)
+    {
+        api429_event_coalesce_open(coalesce, group, now);
+    }
+
+    batch = group->batch;
+
+    if(batch)
+    {
+        batch->entries[batch->count++] = *info;
+        batch->last_us = now;
+
+        if(batch->count == coalesce->count_max)
+        {
+            api429_event_coalesce_close(coalesce, group);
+            closed = AiTrue;
+        }
+    }
+    else
+    {
+        /* No buffer free, keep the count for the next batch of the group */
+        group->dropped++;
+        coalesce->metrics.dropped++;
+    }
+
+    ai_mutex_release(coalesce->lock);
+
+    if(closed)
+    {
+        ai_event_signal(coalesce->wake);
+    }
+
+    return AiTrue;
+}
+
+
+/*! \brief Handler for \ref api429_event_dispatch_handler_set
+ *
+ * Pass the coalescer as context and set the handler for \ref API429_EVENT_RX_ANY_LABEL and \ref API429_EVENT_TX_LABEL.
+ */
+static AI_INLINE void AI_CALL_CONV api429_event_coalesce_handler(const struct api429_event_dispatch_event* event, void* context)
+{
+    api429_event_coalesce_event((struct api429_event_coalesce*) context, event->module, event->channel, event->type, &event->info);
+}
+
+
+/*! \brief Close expired groups and deliver closed batches
+ *
+ * Called by the service thread. If the service thread is not started, it must be called cyclically by
+ * a single thread.
+ * @param [in] coalesce the coalescer
+ * @return time in microseconds until the next group expires, at most the time window
+ */
+static AI_INLINE AiUInt32 api429_event_coalesce_service(struct api429_event_coalesce* coalesce)
+{
+    struct api429_event_coalesce_group* group;
+    struct api429_event_coalesce_batch* batch;
+    AiUInt64 now = ai_clock_us();
+    AiUInt64 next = coalesce->window_us;
+    AiUInt64 age;
+    AiUInt32 i;
+
+    ai_mutex_lock(coalesce->lock);
+
+    for(i = 0; i <= coalesce->group_mask; i++)
+    {
+        group = &coalesce->groups[i];
+
+        /* Report events counted after the last batch of a quiet group in a batch without entries */
+        if(!group->batch && group->dropped && coalesce->free_count)
+        {
+            api429_event_coalesce_open(coalesce, group, now);
+            api429_event_coalesce_close(coalesce, group);
+            continue;
+        }
+
+        if(!group->batch)
+        {
+            continue;
+        }
+
+        age = now - group->batch->first_us;
+
+        if(age >= coalesce->window_us)
+        {
+            api429_event_coalesce_close(coalesce, group);
+        }
+        else if(coalesce->window_us - age < next)
+        {
+            next = coalesce->window_us - age;
+        }
+    }
+
+    /* Deliver without the lock, so events can be collected meanwhile */
+    while(coalesce->ready_count)
+    {
+        batch = coalesce->ready[coalesce->ready_head];
+        coalesce->ready_head = (coalesce->ready_head + 1) % coalesce->batch_count;
+        coalesce->ready_count--;
+
+        ai_mutex_release(coalesce->lock);
+
+        coalesce->deliver(batch, coalesce->context);
+
+        ai_mutex_lock(coalesce->lock);
+
+        coalesce->metrics.batches++;
+        coalesce->free[coalesce->free_count++] = batch;
+    }
+
+    ai_mutex_release(coalesce->lock);
+
+    return (AiUInt32) next;
+}
+
+
+/*! \brief Check if a coalescer holds events that were not delivered yet
+ */
+static AI_INLINE AiBoolean api429_event_coalesce_pending(struct api429_event_coalesce* coalesce)
+{
+    AiBoolean pending = AiFalse;
+    AiUInt32 i;
+
+    ai_mutex_lock(coalesce->lock);
+
+    for(i = 0; i <= coalesce->group_mask && !pending; i++)
+    {
+        pending = coalesce->groups[i].batch || coalesce->groups[i].dropped;
+    }
+
+    ai_mutex_release(coalesce->lock);
+
+    return pending;
+}
+
+
+/*! \brief Routine of the service thread
+ */
+static void api429_event_coalesce_thread(void* arg)
+{
+    struct api429_event_coalesce* coalesce = (struct api429_event_coalesce*) arg;
+    AiUInt32 value;
+    AiUInt32 wait;
+
+    while(!ai_atomic_u32_load(&coalesce->stop))
+    {
+        value = ai_event_value(coalesce->wake);
+        wait  = api429_event_coalesce_service(coalesce);
+
+        ai_event_wait(coalesce->wake, value, wait > API429_EVENT_COALESCE_MIN_WAIT_US ? wait : API429_EVENT_COALESCE_MIN_WAIT_US);
+    }
+
+    /* Deliver what is left. Counts of dropped events may need buffers returned by the previous pass */
+    coalesce->window_us = 0;
+
+    do
+    {
+        api429_event_coalesce_service(coalesce);
+    }
+    while(api429_event_coalesce_pending(coalesce));
+}
+
+
+/*! \brief Release a coalescer
+ *
+ * Stops the service thread, which delivers all collected events before.
+ * @param coalesce coalescer to release. May be NULL
+ */
+static AI_INLINE void api429_event_coalesce_free(struct api429_event_coalesce* coalesce)
+{
+    if(!coalesce)
+    {
+        return;
+    }
+
+    if(coalesce->thread)
+    {
+        ai_atomic_u32_store(&coalesce->stop, 1);
+        ai_event_signal(coalesce->wake);
+        ai_thread_join(coalesce->thread);
+    }
+
+    if(coalesce->lock)
+    {
+        ai_mutex_free(coalesce->lock);
+    }
+
+    if(coalesce->wake)
+    {
+        ai_event_free(coalesce->wake);
+    }
+
+    free(coalesce->groups);
+    free(coalesce->batches);
+    free(coalesce->storage);
+    free(coalesce->free);
+    free(coalesce->ready);
+    free(coalesce);
+}
+
+
+/*! \brief Create a coalescer
+ *
+ * @param [in] count_max number of events that closes a group
+ * @param [in] window_us time in microseconds after the first event of a group that closes the group
+ * @param [in] max_groups expected number of distinct board, channel, type and ID combinations. The group table grows if more are seen
+ * @param [in] batch_count number of batch buffers. Should be larger than the number of groups that are active at the same time
+ * @param [in] deliver function that receives the batches
+ * @param [in] context user data passed to 'deliver'
+ * @param [in] start AiTrue to start a service thread that delivers the batches,
+ *                   AiFalse to call \ref api429_event_coalesce_service cyclically instead
+ * @param [out] coalesce_out the created coalescer is stored here. Must be released with \ref api429_event_coalesce_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_coalesce_create(AiUInt32 count_max, AiUInt32 window_us, AiUInt32 max_groups, AiUInt32 batch_count,
+                                                       API429_EVENT_COALESCE_DELIVER deliver, void* context, AiBoolean start,
+                                                       struct api429_event_coalesce** coalesce_out)
+{
+    struct api429_event_coalesce* coalesce;
+    AiUInt32 size = 2;
+    AiUInt32 i;
+
+    if(!deliver || !coalesce_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *coalesce_out = NULL;
+
+    if(!count_max || !max_groups || max_groups > 0x10000000u || !batch_count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    coalesce = (struct api429_event_coalesce*) calloc(1, sizeof(struct api429_event_coalesce));
+    if(!coalesce)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    /* Keep the hash table at most half full */
+    while(size < max_groups * 2)
+    {
+        size *= 2;
+    }
+
+    coalesce->deliver     = deliver;
+    coalesce->context     = context;
+    coalesce->count_max   = count_max;
+    coalesce->window_us   = window_us;
+    coalesce->group_mask  = size - 1;
+    coalesce->batch_count = batch_count;
+    coalesce->groups      = (struct api429_event_coalesce_group*) calloc(size, sizeof(struct api429_event_coalesce_group));
+    coalesce->batches     = (struct api429_event_coalesce_batch*) calloc(batch_count, sizeof(struct api429_event_coalesce_batch));
+    coalesce->storage     = (struct api429_intr_loglist_entry*) malloc((AiSize) batch_count * count_max * sizeof(struct api429_intr_loglist_entry));
+    coalesce->free        = (struct api429_event_coalesce_batch**) malloc(batch_count * sizeof(struct api429_event_coalesce_batch*));
+    coalesce->ready       = (struct api429_event_coalesce_batch**) malloc(batch_count * sizeof(struct api429_event_coalesce_batch*));
+    coalesce->lock        = ai_mutex_create();
+    coalesce->wake        = ai_event_create();
+
+    if(!coalesce->groups || !coalesce->batches || !coalesce->storage || !coalesce->free || !coalesce->ready
+       || !coalesce->lock || !coalesce->wake)
+    {
+        api429_event_coalesce_free(coalesce);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    for(i = 0; i < batch_count; i++)
+    {
+        coalesce->batches[i].entries = coalesce->storage + (AiSize) i * count_max;
+        coalesce->free[i]            = &coalesce->batches[batch_count - 1 - i];
+    }
+
+    coalesce->free_count = batch_count;
+
+    if(start)
+    {
+        coalesce->thread = ai_thread_create(api429_event_coalesce_thread, coalesce);
+        if(!coalesce->thread)
+        {
+            api429_event_coalesce_free(coalesce);
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+    }
+
+    *coalesce_out = coalesce;
+
+    return API_OK;
+}
+
+
+/*! \brief Get the metrics of a coalescer
+ *
+ * @param [in] coalesce the coalescer
+ * @param [out] metrics the metrics are stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_coalesce_metrics(struct api429_event_coalesce* coalesce, struct api429_event_coalesce_metrics* metrics)
+{
+    if(!coalesce || !metrics)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(coalesce->lock);
+    *metrics = coalesce->metrics;
+    ai_mutex_release(coalesce->lock);
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429EVENTCOALESCE_H_ */
@@ -0,0 +1,676 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429EventDispatch.h
+ *
+ *  This header file contains inline helper functions
+ *  for handling channel events in worker threads
+ */
+
+#ifndef API429EVENTDISPATCH_H_
+#define API429EVENTDISPATCH_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Histogram.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+#include "Ai_queue.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup event_dispatch Event Dispatcher
+  This module moves the handling of channel events off the thread of the driver. \n
+  \ref Api429ChannelCallbackRegister calls one function per channel on the thread that delivers the interrupts,
+  so a slow handler delays all following events. A dispatcher (\ref api429_event_dispatch) registers its own
+  callback for all event types of the added channels. The callback only copies the event with its
+  \ref api429_intr_loglist_entry into a lock-free queue and returns. \n
+  Worker threads take the events from the queues and call the handler registered for the event type
+  with \ref api429_event_dispatch_handler_set. Each channel is assigned to one worker, so the events of a channel
+  are handled one after the other in the order they occurred, while different channels are handled in parallel. \n
+  If a queue is full, the event is dropped and counted instead of blocking the interrupt delivery.
+  \ref api429_event_dispatch_metrics reports the queue depths, the drops and histograms of the time events waited
+  in the queue and the time the handlers took. \n
+  The callback has no user context, so the dispatcher of a channel is looked up in \ref api429_event_dispatch_registry.
+  The registry has one definition shared by all translation units (\ref AI_SELECTANY), and counts the callbacks
+  that are running, so \ref api429_event_dispatch_free waits for them before releasing the dispatcher.
+* @{
+*/
+
+
+
+/*! \def API429_EVENT_DISPATCH_MODULES
+ * Number of board handles the dispatcher table can hold
+ */
+#define API429_EVENT_DISPATCH_MODULES       32
+
+/*! \def API429_EVENT_DISPATCH_CHANNELS
+ * Number of channels per board the dispatcher table can hold
+ */
+#define API429_EVENT_DISPATCH_CHANNELS      32
+
+/*! \def API429_EVENT_DISPATCH_TYPES
+ * Number of event types, see \ref api429_event_type
+ */
+#define API429_EVENT_DISPATCH_TYPES         (API429_EVENT_TX_FIFO + 1)
+
+/*! \def API429_EVENT_DISPATCH_ALL
+ * Event type that selects the handler of all types without own handler
+ */
+#define API429_EVENT_DISPATCH_ALL           API429_EVENT_DISPATCH_TYPES
+
+/*! \def API429_EVENT_DISPATCH_MAX_WORKERS
+ * Maximum number of worker threads of a dispatcher
+ */
+#define API429_EVENT_DISPATCH_MAX_WORKERS   16
+
+/*! \def API429_EVENT_DISPATCH_POLL_US
+ * Maximum time an idle worker sleeps before checking for a stop request
+ */
+#define API429_EVENT_DISPATCH_POLL_US       100000
+
+/*! \def API429_EVENT_DISPATCH_DRAIN_US
+ * Time \ref api429_event_dispatch_free sleeps while waiting for running callbacks
+ */
+#define API429_EVENT_DISPATCH_DRAIN_US      1000
+
+
+
+/*! \struct api429_event_dispatch_event
+ *
+ * This structure holds a copy of a channel event
+ */
+struct api429_event_dispatch_event
+{
+    AiUInt8 module;                             /*!< Handle to the board that raised the event */
+    AiUInt8 channel;                            /*!< ID of the channel that raised the event */
+    enum api429_event_type type;                /*!< Type of the event */
+    struct api429_intr_loglist_entry info;      /*!< Information about the source of the event */
+    AiUInt64 time_us;                           /*!< Host time the event was received, see \ref ai_clock_us */
+};
+
+/*! \typedef TY_API429_EVENT_DISPATCH_EVENT
+ * Convenience typedef for \ref api429_event_dispatch_event
+ */
+typedef struct api429_event_dispatch_event TY_API429_EVENT_DISPATCH_EVENT;
+
+
+/*! \typedef API429_EVENT_DISPATCH_HANDLER
+ * Prototype of a function that handles events in a worker thread. \n
+ * The event is only valid until the function returns.
+ */
+typedef void (AI_CALL_CONV *API429_EVENT_DISPATCH_HANDLER)(const struct api429_event_dispatch_event* event, void* context);
+
+
+/*! \struct api429_event_dispatch_metrics
+ *
+ * This structure reports the metrics of a dispatcher or one of its workers
+ */
+struct api429_event_dispatch_metrics
+{
+    AiUInt64 received;                          /*!< Number of events received from the driver */
+    AiUInt64 dropped;                           /*!< Number of events dropped because the queue was full */
+    AiUInt64 dispatched;                        /*!< Number of events passed to a handler */
+    AiUInt64 unhandled;                         /*!< Number of events without handler */
+    AiUInt32 depth;                             /*!< Number of queued events */
+    AiUInt32 depth_max;                         /*!< Largest number of queued events */
+    struct api429_histogram latency;            /*!< Time in microseconds from receiving an event to calling its handler */
+    struct api429_histogram runtime;            /*!< Time in microseconds a handler took */
+};
+
+/*! \typedef TY_API429_EVENT_DISPATCH_METRICS
+ * Convenience typedef for \ref api429_event_dispatch_metrics
+ */
+typedef struct api429_event_dispatch_metrics TY_API429_EVENT_DISPATCH_METRICS;
+
+
+struct api429_event_dispatch;
+
+
+/*! \struct api429_event_dispatch_worker
+ *
+ * This structure holds a worker thread and the queue of the channels assigned to it
+ */
+struct api429_event_dispatch_worker
+{
+    struct api429_event_dispatch* dispatch;     /*!< The dispatcher the worker belongs to */
+    struct ai_mpmc_queue* queue;                /*!< Queued events */
+    struct ai_event* wake;                      /*!< Wakes the worker */
+    volatile AiUInt32 sleeping;                 /*!< Set while the worker waits for 'wake' */
+    struct ai_thread* thread;                   /*!< The worker thread */
+    volatile AiUInt64 received;                 /*!< Number of received events */
+    volatile AiUInt64 dropped;                  /*!< Number of dropped events */
+    volatile AiUInt32 depth_max;                /*!< Largest number of queued events */
+    struct ai_mutex* lock;                      /*!< Protects 'metrics' */
+    struct api429_event_dispatch_metrics metrics; /*!< Metrics updated by the worker */
+};
+
+/*! \typedef TY_API429_EVENT_DISPATCH_WORKER
+ * Convenience typedef for \ref api429_event_dispatch_worker
+ */
+typedef struct api429_event_dispatch_worker TY_API429_EVENT_DISPATCH_WORKER;
+
+
+/*! \struct api429_event_dispatch
+ *
+ * This structure holds an event dispatcher.
+ * It is created with \ref api429_event_dispatch_create
+ */
+struct api429_event_dispatch
+{
+    API429_EVENT_DISPATCH_HANDLER handlers[API429_EVENT_DISPATCH_TYPES + 1]; /*!< Handler by event type, the last one for all types */
+    void* contexts[API429_EVENT_DISPATCH_TYPES + 1];                        /*!< User data passed to the handlers */
+    struct api429_event_dispatch_worker workers[API429_EVENT_DISPATCH_MAX_WORKERS]; /*!< The workers */
+    AiUInt32 worker_count;                                                  /*!< Number of workers */
+    volatile AiUInt32 stop;                                                 /*!< Set to stop the workers */
+};
+
+/*! \typedef TY_API429_EVENT_DISPATCH
+ * Convenience typedef for \ref api429_event_dispatch
+ */
+typedef struct api429_event_dispatch TY_API429_EVENT_DISPATCH;
+
+
+/*! \struct api429_event_dispatch_slots
+ *
+ * This structure holds the dispatchers of all channels
+ */
+struct api429_event_dispatch_slots
+{
+    struct api429_event_dispatch* volatile dispatch[API429_EVENT_DISPATCH_MODULES][API429_EVENT_DISPATCH_CHANNELS]; /*!< Dispatcher by board handle and channel ID */
+    volatile AiUInt32 running[API429_EVENT_DISPATCH_MODULES][API429_EVENT_DISPATCH_CHANNELS];                    /*!< Number of running callbacks */
+};
+
+/*! \typedef TY_API429_EVENT_DISPATCH_SLOTS
+ * Convenience typedef for \ref api429_event_dispatch_slots
+ */
+typedef struct api429_event_dispatch_slots TY_API429_EVENT_DISPATCH_SLOTS;
+
+
+/*! \var api429_event_dispatch_registry
+ * Dispatcher of each channel. Shared by all translation units
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+AI_SELECTANY struct api429_event_dispatch_slots api429_event_dispatch_registry = { { { NULL } }, { { 0 } } };
+#ifdef __cplusplus
+}
+#endif
+
+
+
+
+/*! \brief Get the worker a channel is assigned to
+ */
+static AI_INLINE struct api429_event_dispatch_worker* api429_event_dispatch_worker_get(struct api429_event_dispatch* dispatch,
+                                                                                        AiUInt8 module, AiUInt8 channel)
+{
+    return &dispatch->workers[((AiUInt32) module * API429_EVENT_DISPATCH_CHANNELS + channel) % dispatch->worker_count];
+}
+
+
+/*! \brief Queue an event
+ *
+ * Called by the driver callback. Never blocks.
+ */
+static AI_INLINE void api429_event_dispatch_post(struct api429_event_dispatch* dispatch, AiUInt8 module, AiUInt8 channel,
+                                                 enum api429_event_type type, const struct api429_intr_loglist_entry* info)
+{
+    struct api429_event_dispatch_worker* worker = api429_event_dispatch_worker_get(dispatch, module, channel);
+    struct api429_event_dispatch_event event;
+    AiUInt32 depth, depth_max;
+
+    event.module  = module;
+    event.channel = channel;
+    event.type    = type;
+    event.time_us = ai_clock_us();
+
+    if(info)
+    {
+        event.info = *info;
+    }
+    else
+    {
+        memset(&event.info, 0, sizeof(event.info));
+    }
+
+    ai_atomic_u64_fetch_add(&worker->received, 1);
+
+    if(!ai_mpmc_push(worker->queue, &event))
+    {
+        ai_atomic_u64_fetch_add(&worker->dropped, 1);
+        return;
+    }
+
+    depth     = ai_mpmc_size(worker->queue);
+    depth_max = ai_atomic_u32_load(&worker->depth_max);
+
+    while(depth > depth_max && !ai_atomic_u32_cas(&worker->depth_max, depth_max, depth))
+    {
+        depth_max = ai_atomic_u32_load(&worker->depth_max);
+    }
+
+    /* Only take the lock of the event if the worker sleeps */
+    if(ai_atomic_u32_cas(&worker->sleeping, 1, 0))
+    {
+        ai_event_signal(worker->wake);
+    }
+}
+
+
+/*! \brief Callback registered with \ref Api429ChannelCallbackRegister
+ */
+static void AI_CALL_CONV api429_event_dispatch_callback(AiUInt8 module, AiUInt8 channel, enum api429_event_type type,
+                                                        struct api429_intr_loglist_entry* info)
+{
+    struct api429_event_dispatch* dispatch;
+
+    if(module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return;
+    }
+
+    /* Announce the callback before the look-up, so a dispatcher is not released while it is used */
+    ai_atomic_u32_fetch_add(&api429_event_dispatch_registry.running[module][channel], 1);
+
+    dispatch = (struct api429_event_dispatch*) AI_ATOMIC_PTR_LOAD(&api429_event_dispatch_registry.dispatch[module][channel]);
+
+    if(dispatch)
+    {
+        api429_event_dispatch_post(dispatch, module, channel, type, info);
+    }
+
+    ai_atomic_u32_fetch_add(&api429_event_dispatch_registry.running[module][channel], (AiUInt32) -1);
+}
+
+
+/*! \brief Pass an event to its handler
+ */
+static AI_INLINE void api429_event_dispatch_handle(struct api429_event_dispatch_worker* worker, const struct api429_event_dispatch_event* event)
+{
+    struct api429_event_dispatch* dispatch = worker->dispatch;
+    AiUInt32 type = (AiUInt32) event->type < API429_EVENT_DISPATCH_TYPES ? (AiUInt32) event->type : API429_EVENT_DISPATCH_TYPES;
+    AiUInt64 start, end;
+
+    type = dispatch->handlers[type] ? type : API429_EVENT_DISPATCH_ALL;
+
+    start = ai_clock_us();
+
+    if(dispatch->handlers[type])
+    {
+        dispatch->handlers[type](event, dispatch->contexts[type]);
+    }
+
+    end = ai_clock_us();
+
+    ai_mutex_lock(worker->lock);
+
+    if(dispatch->handlers[type])
+    {
+        worker->metrics.dispatched++;
+        api429_histogram_add(&worker->metrics.latency, (AiInt64) (start - event->time_us));
+        api429_histogram_add(&worker->metrics.runtime, (AiInt64) (end - start));
+    }
+    else
+    {
+        worker->metrics.unhandled++;
+    }
+
+    ai_mutex_release(worker->lock);
+}
+
+
+/*! \brief Routine of a worker thread
+ */
+static void api429_event_dispatch_thread(void* arg)
+{
+    struct api429_event_dispatch_worker* worker = (struct api429_event_dispatch_worker*) arg;
+    struct api429_event_dispatch_event event;
+    AiUInt32 value;
+
+    while(!ai_atomic_u32_load(&worker->dispatch->stop))
+    {
+        while(ai_mpmc_pop(worker->queue, &event))
+        {
+            api429_event_dispatch_handle(worker, &event);
+        }
+
+        value = ai_event_value(worker->wake);
+
+        /* Announce the sleep before the last check, so a producer either sees the flag or the worker sees the event */
+        ai_atomic_u32_cas(&worker->sleeping, 0, 1);
+
+        if(ai_mpmc_pop(worker->queue, &event))
+        {
+            ai_atomic_u32_store(&worker->sleeping, 0);
+            api429_event_dispatch_handle(worker, &event);
+            continue;
+        }
+
+        ai_event_wait(worker->wake, value, API429_EVENT_DISPATCH_POLL_US);
+        ai_atomic_u32_store(&worker->sleeping, 0);
+    }
+}
+
+
+/*! \brief Stop dispatching events of a channel
+ *
+ * Unregisters the callback of the channel. Events already queued are still handled.
+ * A callback that is running may still queue an event afterwards.
+ * @param [in] dispatch the dispatcher
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the channel
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_dispatch_channel_remove(struct api429_event_dispatch* dispatch, AiUInt8 board_handle, AiUInt8 channel)
+{
+    AiReturn ret;
+
+    if(!dispatch)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(board_handle >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS
+       || api429_event_dispatch_registry.dispatch[board_handle][channel] != dispatch)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    ret = Api429ChannelCallbackUnregister(board_handle, channel, 0);
+
+    /* Sequentially consistent, so the slot is cleared before api429_event_dispatch_free checks for running callbacks */
+    (void) AI_ATOMIC_PTR_EXCHANGE(&api429_event_dispatch_registry.dispatch[board_handle][channel], NULL);
+
+    return ret;
+}
+
+
+/*! \brief Release a dispatcher
+ *
+ * Removes all channels of the dispatcher, waits for callbacks that are still running and stops the workers.
+ * Events still queued are discarded. Must not be called from a handler of the dispatcher.
+ * @param dispatch dispatcher to release. May be NULL
+ */
+static AI_INLINE void api429_event_dispatch_free(struct api429_event_dispatch* dispatch)
+{
+    struct api429_event_dispatch_worker* worker;
+    AiUInt32 module, channel, i;
+    AiUInt32 removed[API429_EVENT_DISPATCH_MODULES];
+
+    if(!dispatch)
+    {
+        return;
+    }
+
+    for(module = 0; module < API429_EVENT_DISPATCH_MODULES; module++)
+    {
+        removed[module] = 0;
+
+        for(channel = 0; channel < API429_EVENT_DISPATCH_CHANNELS; channel++)
+        {
+            if(api429_event_dispatch_registry.dispatch[module][channel] == dispatch)
+            {
+                api429_event_dispatch_channel_remove(dispatch, (AiUInt8) module, (AiUInt8) channel);
+                removed[module] |= 1u << channel;
+            }
+        }
+    }
+
+    /* A callback may have looked up the dispatcher before its channel was removed */
+    for(module = 0; module < API429_EVENT_DISPATCH_MODULES; module++)
+    {
+        for(channel = 0; channel < API429_EVENT_DISPATCH_CHANNELS; channel++)
+        {
+            while((removed[module] & (1u << channel))
+                  && ai_atomic_u32_fetch_add(&api429_event_dispatch_registry.running[module][channel], 0))
+            {
+                ai_clock_sleep_us(API429_EVENT_DISPATCH_DRAIN_US);
+            }
+        }
+    }
+
+    ai_atomic_u32_store(&dispatch->stop, 1);
+
+    for(i = 0; i < dispatch->worker_count; i++)
+    {
+        worker = &dispatch->workers[i];
+
+        if(worker->thread)
+        {
+            ai_event_signal(worker->wake);
+            ai_thread_join(worker->thread);
+        }
+
+        ai_mpmc_free(worker->queue);
+
+        if(worker->wake)
+        {
+            ai_event_free(worker->wake);
+        }
+
+        if(worker->lock)
+        {
+            ai_mutex_free(worker->lock);
+        }
+    }
+
+    free(dispatch);
+}
+
+
+/*! \brief Create a dispatcher
+ *
+ * Starts the worker threads. Handlers should be set before channels are added.
+ * @param [in] worker_count number of worker threads, 1 .. \ref API429_EVENT_DISPATCH_MAX_WORKERS
+ * @param [in] queue_size maximum number of queued events of each worker. Must be a power of two
+ * @param [out] dispatch_out the created dispatcher is stored here. Must be released with \ref api429_event_dispatch_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_dispatch_create(AiUInt32 worker_count, AiUInt32 queue_size, struct api429_event_dispatch** dispatch_out)
+{
+    struct api429_event_dispatch_worker* worker;
+    struct api429_event_dispatch* dispatch;
+    AiUInt32 i;
+
+    if(!dispatch_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *dispatch_out = NULL;
+
+    if(!worker_count || worker_count > API429_EVENT_DISPATCH_MAX_WORKERS || queue_size < 2 || (queue_size & (queue_size - 1)))
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    dispatch = (struct api429_event_dispatch*) calloc(1, sizeof(struct api429_event_dispatch));
+    if(!dispatch)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    dispatch->worker_count = worker_count;
+
+    for(i = 0; i < worker_count; i++)
+    {
+        worker = &dispatch->workers[i];
+
+        api429_histogram_init(&worker->metrics.latency);
+        api429_histogram_init(&worker->metrics.runtime);
+
+        worker->dispatch = dispatch;
+        worker->queue    = ai_mpmc_create(queue_size, sizeof(struct api429_event_dispatch_event));
+        worker->wake     = ai_event_create();
+        worker->lock     = ai_mutex_create();
+
+        if(!worker->queue || !worker->wake || !worker->lock)
+        {
+            api429_event_dispatch_free(dispatch);
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+
+        worker->thread = ai_thread_create(api429_event_dispatch_thread, worker);
+        if(!worker->thread)
+        {
+            api429_event_dispatch_free(dispatch);
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+    }
+
+    *dispatch_out = dispatch;
+
+    return API_OK;
+}
+
+
+/*! \brief Set the handler of an event type
+ *
+ * Should be called before channels are added. Events of types without handler are passed to the handler
+ * of \ref API429_EVENT_DISPATCH_ALL, if any.
+ * @param [in] dispatch the dispatcher
+ * @param [in] type event type, see \ref api429_event_type, or \ref API429_EVENT_DISPATCH_ALL
+ * @param [in] handler function called by a worker thread for each event of the type. NULL to remove the handler
+ * @param [in] context user data passed to 'handler'
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_dispatch_handler_set(struct api429_event_dispatch* dispatch, AiUInt32 type,
+                                                            API429_EVENT_DISPATCH_HANDLER handler, void* context)
+{
+    if(!dispatch)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(type > API429_EVENT_DISPATCH_ALL)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    dispatch->contexts[type] = context;
+    dispatch->handlers[type] = handler;
+
+    return API_OK;
+}
+
+
+/*! \brief Dispatch the events of a channel
+ *
+ * Registers the callback of the dispatcher with \ref Api429ChannelCallbackRegister, which receives all event types.
+ * @param [in] dispatch the dispatcher
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the channel
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_dispatch_channel_add(struct api429_event_dispatch* dispatch, AiUInt8 board_handle, AiUInt8 channel)
+{
+    AiReturn ret;
+
+    if(!dispatch)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(board_handle >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS
+       || api429_event_dispatch_registry.dispatch[board_handle][channel])
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    AI_ATOMIC_PTR_STORE(&api429_event_dispatch_registry.dispatch[board_handle][channel], dispatch);
+
+    ret = Api429ChannelCallbackRegister(board_handle, channel, 0, api429_event_dispatch_callback);
+    if(ret != API_OK)
+    {
+        AI_ATOMIC_PTR_STORE(&api429_event_dispatch_registry.dispatch[board_handle][channel], NULL);
+    }
+
+    return ret;
+}
+
+
+/*! \brief Get the metrics of a dispatcher
+ *
+ * @param [in] dispatch the dispatcher
+ * @param [in] worker index of the worker to report, or dispatch->worker_count for the sum of all workers
+ * @param [out] metrics the metrics are stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_dispatch_metrics(struct api429_event_dispatch* dispatch, AiUInt32 worker,
+                                                        struct api429_event_dispatch_metrics* metrics)
+{
+    struct api429_event_dispatch_worker* w;
+    AiUInt32 first, last, depth_max, i;
+
+    if(!dispatch || !metrics)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(worker > dispatch->worker_count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    first = worker < dispatch->worker_count ? worker : 0;
+    last  = worker < dispatch->worker_count ? worker + 1 : dispatch->worker_count;
+
+    memset(metrics, 0, sizeof(*metrics));
+    api429_histogram_init(&metrics->latency);
+    api429_histogram_init(&metrics->runtime);
+
+    for(i = first; i < last; i++)
+    {
+        w = &dispatch->workers[i];
+
+        ai_mutex_lock(w->lock);
+
+        metrics->dispatched += w->metrics.dispatched;
+        metrics->unhandled  += w->metrics.unhandled;
+        api429_histogram_merge(&metrics->latency, &w->metrics.latency);
+        api429_histogram_merge(&metrics->runtime, &w->metrics.runtime);
+
+        ai_mutex_release(w->lock);
+
+        depth_max = ai_atomic_u32_load(&w->depth_max);
+
+        metrics->received  += ai_atomic_u64_load(&w->received);
+        metrics->dropped   += ai_atomic_u64_load(&w->dropped);
+        metrics->depth     += ai_mpmc_size(w->queue);
+        metrics->depth_max  = depth_max > metrics->depth_max ? depth_max : metrics->depth_max;
+    }
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429EVENTDISPATCH_H_ */
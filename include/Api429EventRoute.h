@@ -0,0 +1,613 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429EventRoute.h
+ *
+ *  This header file contains inline helper functions
+ *  for routing FIFO interrupts by their tag
+ */
+
+#ifndef API429EVENTROUTE_H_
+#define API429EVENTROUTE_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429EventDispatch.h"
+#include "Ai_atomic.h"
+#include "Ai_mutex.h"
+
+
+/**
+* \defgroup event_route Event Tag Routing
+  This module routes \ref API429_EVENT_TX_FIFO events by the tag of the interrupt entry
+  (\ref Api429TxFifoInterruptCreate, \ref API429_CHANNEL_EVENT_TAG), so callbacks need no switch over the tags. \n
+  A router (\ref api429_event_route) holds a table of 256 tags for each channel and finds the target of an event
+  with two array lookups. A tag can have a handler, that is called for each of its interrupts, set with
+  \ref api429_event_route_set. \n
+  In addition, one-shot notifications (\ref api429_event_route_pending) can be queued per tag with
+  \ref api429_event_route_push, e.g. right before writing the interrupt entry behind a batch. As the board processes
+  the FIFO in order, the interrupts of a tag arrive in the order the entries were written, so each interrupt ends the
+  oldest notification of its tag. This allows to reuse the 256 tags for any number of batches in flight. \n
+  Events are fed with \ref api429_event_route_event, or by setting \ref api429_event_route_handler as handler
+  of \ref API429_EVENT_TX_FIFO of a \ref api429_event_dispatch.
+* @{
+*/
+
+
+
+/*! \def API429_EVENT_ROUTE_TAGS
+ * Number of interrupt tags per channel
+ */
+#define API429_EVENT_ROUTE_TAGS     256
+
+
+
+/*! \typedef API429_EVENT_ROUTE_HANDLER
+ * Prototype of a function that handles a routed event. \n
+ * 'event' is NULL, if a notification was discarded by \ref api429_event_route_clear.
+ * The event is only valid until the function returns.
+ */
+typedef void (AI_CALL_CONV *API429_EVENT_ROUTE_HANDLER)(const struct api429_event_dispatch_event* event, void* context);
+
+
+/*! \struct api429_event_route_pending
+ *
+ * This structure holds a one-shot notification. It is provided by the caller and must stay valid until it is done
+ */
+struct api429_event_route_pending
+{
+    API429_EVENT_ROUTE_HANDLER handler;             /*!< Function called when the notification ends. May be NULL */
+    void* context;                                  /*!< User data passed to 'handler' */
+    volatile AiUInt32 done;                         /*!< Set to 1 after the notification ended and 'handler' returned */
+    AiBoolean discarded;                            /*!< AiTrue if the notification was ended by \ref api429_event_route_clear */
+    struct api429_event_dispatch_event event;       /*!< The interrupt that ended the notification */
+    struct api429_event_route_pending* next;        /*!< Next notification of the same tag */
+};
+
+/*! \typedef TY_API429_EVENT_ROUTE_PENDING
+ * Convenience typedef for \ref api429_event_route_pending
+ */
+typedef struct api429_event_route_pending TY_API429_EVENT_ROUTE_PENDING;
+
+
+/*! \struct api429_event_route_tag
+ *
+ * This structure holds the targets of one tag
+ */
+struct api429_event_route_tag
+{
+    API429_EVENT_ROUTE_HANDLER handler;             /*!< Function called for each interrupt of the tag. May be NULL */
+    void* context;                                  /*!< User data passed to 'handler' */
+    struct api429_event_route_pending* head;        /*!< Oldest queued notification */
+    struct api429_event_route_pending* tail;        /*!< Newest queued notification */
+};
+
+/*! \typedef TY_API429_EVENT_ROUTE_TAG
+ * Convenience typedef for \ref api429_event_route_tag
+ */
+typedef struct api429_event_route_tag TY_API429_EVENT_ROUTE_TAG;
+
+
+/*! \struct api429_event_route_channel
+ *
+ * This structure holds the tag table of one channel
+ */
+struct api429_event_route_channel
+{
+    struct api429_event_route_tag tags[API429_EVENT_ROUTE_TAGS];    /*!< Targets by tag */
+    AiUInt64 pending;                                               /*!< Number of queued notifications */
+    AiUInt64 routed;                                                /*!< Number of interrupts with a target */
+    AiUInt64 unrouted;                                              /*!< Number of interrupts without target */
+    struct ai_mutex* lock;                                          /*!< Protects the table */
+};
+
+/*! \typedef TY_API429_EVENT_ROUTE_CHANNEL
+ * Convenience typedef for \ref api429_event_route_channel
+ */
+typedef struct api429_event_route_channel TY_API429_EVENT_ROUTE_CHANNEL;
+
+
+/*! \struct api429_event_route_metrics
+ *
+ * This structure reports the metrics of the tag table of one channel
+ */
+struct api429_event_route_metrics
+{
+    AiUInt64 pending;           /*!< Number of queued notifications */
+    AiUInt64 routed;            /*!< Number of interrupts with a target */
+    AiUInt64 unrouted;          /*!< Number of interrupts without target */
+};
+
+/*! \typedef TY_API429_EVENT_ROUTE_METRICS
+ * Convenience typedef for \ref api429_event_route_metrics
+ */
+typedef struct api429_event_route_metrics TY_API429_EVENT_ROUTE_METRICS;
+
+
+/*! \struct api429_event_route
+ *
+ * This structure holds a router.
+ * It is created with \ref api429_event_route_create
+ */
+struct api429_event_route
+{
+    struct api429_event_route_channel* channels[API429_EVENT_DISPATCH_MODULES][API429_EVENT_DISPATCH_CHANNELS]; /*!< Tag tables, NULL for unused channels */
+    struct ai_mutex* lock;                                                                                     /*!< Serializes adding channels */
+};
+
+/*! \typedef TY_API429_EVENT_ROUTE
+ * Convenience typedef for \ref api429_event_route
+ */
+typedef struct api429_event_route TY_API429_EVENT_ROUTE;
+
+
+
+
+/*! \brief Get the tag table of a channel
+ *
+ * @param [in] route the router
+ * @param [in] module handle to the board
+ * @param [in] channel ID of the channel
+ * @param [in] add AiTrue to create the table if the channel has none yet
+ * @return the tag table, or NULL if the channel is out of range, has no table, or no memory is left
+ */
+static AI_INLINE struct api429_event_route_channel* api429_event_route_channel_get(struct api429_event_route* route, AiUInt8 module,
+                                                                                   AiUInt8 channel, AiBoolean add)
+{
+    struct api429_event_route_channel* table;
+
+    if(module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return NULL;
+    }
+
+    table = (struct api429_event_route_channel*) AI_ATOMIC_PTR_LOAD(&route->channels[module][channel]);
+    if(table || !add)
+    {
+        return table;
+    }
+
+    ai_mutex_lock(route->lock);
+
+    table = route->channels[module][channel];
+
+    if(!table)
+    {
+        table = (struct api429_event_route_channel*) calloc(1, sizeof(struct api429_event_route_channel));
+
+        if(table)
+        {
+            table->lock = ai_mutex_create();
+
+            if(!table->lock)
+            {
+                free(table);
+                table = NULL;
+            }
+        }
+
+        if(table)
+        {
+            /* Publish the table after it is initialized, as events are routed without the lock */
+            AI_ATOMIC_PTR_STORE(&route->channels[module][channel], table);
+        }
+    }
+
+    ai_mutex_release(route->lock);
+
+    return table;
+}
+
+
+/*! \brief Set the handler of a tag
+ *
+ * The handler is called for each interrupt of the tag, after the oldest queued notification of the tag, if any.
+ * @param [in] route the router
+ * @param [in] module handle to the board
+ * @param [in] channel ID of the channel
+ * @param [in] tag tag of the interrupt entries, 0 to 255
+ * @param [in] handler function to call, or NULL to remove the handler
+ * @param [in] context user data passed to 'handler'
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_route_set(struct api429_event_route* route, AiUInt8 module, AiUInt8 channel, AiUInt32 tag,
+                                                 API429_EVENT_ROUTE_HANDLER handler, void* context)
+{
+    struct api429_event_route_channel* table;
+
+    if(!route)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(tag >= API429_EVENT_ROUTE_TAGS || module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    table = api429_event_route_channel_get(route, module, channel, AiTrue);
+    if(!table)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    ai_mutex_lock(table->lock);
+    table->tags[tag].handler = handler;
+    table->tags[tag].context = context;
+    ai_mutex_release(table->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Queue a one-shot notification for a tag
+ *
+ * The notification ends with the first interrupt of the tag, that is not consumed by an older notification.
+ * Push it before writing the interrupt entry, so the interrupt cannot arrive first.
+ * @param [in] route the router
+ * @param [in] module handle to the board
+ * @param [in] channel ID of the channel
+ * @param [in] tag tag of the interrupt entry, 0 to 255
+ * @param [in] pending the notification. 'handler' and 'context' must be set, the other members are initialized.
+ *                     Must stay valid until 'done' is set
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_route_push(struct api429_event_route* route, AiUInt8 module, AiUInt8 channel, AiUInt32 tag,
+                                                  struct api429_event_route_pending* pending)
+{
+    struct api429_event_route_channel* table;
+    struct api429_event_route_tag* target;
+
+    if(!route || !pending)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(tag >= API429_EVENT_ROUTE_TAGS || module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    table = api429_event_route_channel_get(route, module, channel, AiTrue);
+    if(!table)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    pending->done      = 0;
+    pending->discarded = AiFalse;
+    pending->next      = NULL;
+
+    ai_mutex_lock(table->lock);
+
+    target = &table->tags[tag];
+
+    if(target->tail)
+    {
+        target->tail->next = pending;
+    }
+    else
+    {
+        target->head = pending;
+    }
+
+    target->tail = pending;
+    table->pending++;
+
+    ai_mutex_release(table->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Check if a notification ended
+ *
+ * @param [in] pending the notification
+ * @return AiTrue if the notification ended and its handler returned
+ */
+static AI_INLINE AiBoolean api429_event_route_done(struct api429_event_route_pending* pending)
+{
+    return ai_atomic_u32_load(&pending->done) != 0;
+}
+
+
+/*! \brief End a notification
+ *
+ * The notification must not be accessed afterwards, as it may be released as soon as 'done' is set.
+ */
+static AI_INLINE void api429_event_route_finish(struct api429_event_route_pending* pending, const struct api429_event_dispatch_event* event)
+{
+    if(event)
+    {
+        pending->event = *event;
+    }
+    else
+    {
+        pending->discarded = AiTrue;
+    }
+
+    if(pending->handler)
+    {
+        pending->handler(event, pending->context);
+    }
+
+    ai_atomic_u32_store(&pending->done, 1);
+}
+
+
+/*! \brief Route an event
+ *
+ * Ends the oldest notification of the tag and calls the handler of the tag.
+ * Handlers are called without locks held, so they may push new notifications.
+ * @param [in] route the router
+ * @param [in] event the event
+ * @return AiTrue if the event had a target, AiFalse otherwise
+ */
+static AI_INLINE AiBoolean api429_event_route_event(struct api429_event_route* route, const struct api429_event_dispatch_event* event)
+{
+    struct api429_event_route_channel* table;
+    struct api429_event_route_tag* target;
+    struct api429_event_route_pending* pending;
+    API429_EVENT_ROUTE_HANDLER handler;
+    void* context;
+
+    if(!route || !event || event->type != API429_EVENT_TX_FIFO)
+    {
+        return AiFalse;
+    }
+
+    table = api429_event_route_channel_get(route, event->module, event->channel, AiFalse);
+    if(!table)
+    {
+        return AiFalse;
+    }
+
+    target = &table->tags[API429_CHANNEL_EVENT_TAG(&event->info)];
+
+    ai_mutex_lock(table->lock);
+
+    pending = target->head;
+
+    if(pending)
+    {
+        target->head = pending->next;
+        target->tail = target->head ? target->tail : NULL;
+        table->pending--;
+    }
+
+    handler = target->handler;
+    context = target->context;
+
+    if(pending || handler)
+    {
+        table->routed++;
+    }
+    else
+    {
+        table->unrouted++;
+    }
+
+    ai_mutex_release(table->lock);
+
+    if(pending)
+    {
+        api429_event_route_finish(pending, event);
+    }
+
+    if(handler)
+    {
+        handler(event, context);
+    }
+
+    return pending || handler;
+}
+
+
+/*! \brief Handler for \ref api429_event_dispatch_handler_set
+ *
+ * Pass the router as context and set the handler for \ref API429_EVENT_TX_FIFO.
+ */
+static AI_INLINE void AI_CALL_CONV api429_event_route_handler(const struct api429_event_dispatch_event* event, void* context)
+{
+    api429_event_route_event((struct api429_event_route*) context, event);
+}
+
+
+/*! \brief Discard the notifications of a channel
+ *
+ * Use this after the FIFO of the channel was reset, as the queued interrupt entries will not be sent anymore.
+ * The handlers of the notifications are called with NULL as event. The tag handlers are kept.
+ * @param [in] route the router
+ * @param [in] module handle to the board
+ * @param [in] channel ID of the channel
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_route_clear(struct api429_event_route* route, AiUInt8 module, AiUInt8 channel)
+{
+    struct api429_event_route_channel* table;
+    struct api429_event_route_pending* pending;
+    struct api429_event_route_pending* next;
+    AiUInt32 i;
+
+    if(!route)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    table = api429_event_route_channel_get(route, module, channel, AiFalse);
+    if(!table)
+    {
+        return API_OK;
+    }
+
+    for(i = 0; i < API429_EVENT_ROUTE_TAGS; i++)
+    {
+        ai_mutex_lock(table->lock);
+
+        pending = table->tags[i].head;
+
+        table->tags[i].head = NULL;
+        table->tags[i].tail = NULL;
+
+        for(next = pending; next; next = next->next)
+        {
+            table->pending--;
+        }
+
+        ai_mutex_release(table->lock);
+
+        for(; pending; pending = next)
+        {
+            next = pending->next;
+            api429_event_route_finish(pending, NULL);
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Get the metrics of a channel
+ *
+ * @param [in] route the router
+ * @param [in] module handle to the board
+ * @param [in] channel ID of the channel
+ * @param [out] metrics the metrics are stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_route_metrics(struct api429_event_route* route, AiUInt8 module, AiUInt8 channel,
+                                                     struct api429_event_route_metrics* metrics)
+{
+    struct api429_event_route_channel* table;
+
+    if(!route || !metrics)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(module >= API429_EVENT_DISPATCH_MODULES || channel >= API429_EVENT_DISPATCH_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    memset(metrics, 0, sizeof(struct api429_event_route_metrics));
+
+    table = api429_event_route_channel_get(route, module, channel, AiFalse);
+    if(!table)
+    {
+        return API_OK;
+    }
+
+    ai_mutex_lock(table->lock);
+    metrics->pending  = table->pending;
+    metrics->routed   = table->routed;
+    metrics->unrouted = table->unrouted;
+    ai_mutex_release(table->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Release a router
+ *
+ * Remove the handler from the dispatcher before. Notifications still queued are discarded.
+ * @param route router to release. May be NULL
+ */
+static AI_INLINE void api429_event_route_free(struct api429_event_route* route)
+{
+    AiUInt32 module, channel;
+
+    if(!route)
+    {
+        return;
+    }
+
+    for(module = 0; module < API429_EVENT_DISPATCH_MODULES; module++)
+    {
+        for(channel = 0; channel < API429_EVENT_DISPATCH_CHANNELS; channel++)
+        {
+            if(route->channels[module][channel])
+            {
+                api429_event_route_clear(route, (AiUInt8) module, (AiUInt8) channel);
+                ai_mutex_free(route->channels[module][channel]->lock);
+                free(route->channels[module][channel]);
+            }
+        }
+    }
+
+    if(route->lock)
+    {
+        ai_mutex_free(route->lock);
+    }
+
+    free(route);
+}
+
+
+/*! \brief Create a router
+ *
+ * Tag tables are allocated on first use of a channel.
+ * @param [out] route_out the created router is stored here. Must be released with \ref api429_event_route_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_event_route_create(struct api429_event_route** route_out)
+{
+    struct api429_event_route* route;
+
+    if(!route_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *route_out = NULL;
+
+    route = (struct api429_event_route*) calloc(1, sizeof(struct api429_event_route));
+    if(!route)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    route->lock = ai_mutex_create();
+    if(!route->lock)
+    {
+        api429_event_route_free(route);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *route_out = route;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429EVENTROUTE_H_ */
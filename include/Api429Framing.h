@@ -0,0 +1,708 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Framing.h
+ *
+ *  This header file contains inline helper functions
+ *  for calculating minor/major framings of framing based
+ *  transmit channels from transfer rates
+ */
+
+#ifndef API429FRAMING_H_
+#define API429FRAMING_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+
+
+/**
+* \defgroup framing Framing Calculation
+  This module contains a host-side framing compiler for channels initialized
+  with \ref API429_TX_MODE_FRAMING. \n
+  It takes the transfers with their transmission rates and calculates a framing
+  where each transfer is sent with exactly its requested rate: \n
+  The minor frame time is the greatest common divisor of all rates, and the
+  major frame spans their least common multiple. Transfers are assigned
+  in rate-monotonic order (shortest period first), each to the phase
+  that keeps the busiest minor frame it occupies as short as possible, so high rate
+  transfers are always at the start of their minor frames and have minimum jitter.
+  Identical minor frames are shared in order to save frame IDs. \n
+  The result can be installed with \ref api429_framing_apply.
+* @{
+*/
+
+
+
+/*! \def API429_FRAMING_MAX_FRAME_ID
+ * Highest minor frame ID that can be used with \ref Api429TxMinorFrameCreate
+ */
+#define API429_FRAMING_MAX_FRAME_ID         1203
+
+/*! \def API429_FRAMING_MAX_MINOR_FRAMES
+ * Maximum number of minor frames in a major frame
+ */
+#define API429_FRAMING_MAX_MINOR_FRAMES     2000
+
+/*! \def API429_FRAMING_MAX_FRAME_XFERS
+ * Maximum number of transfers in a minor frame
+ */
+#define API429_FRAMING_MAX_FRAME_XFERS      2000
+
+/*! \def API429_FRAMING_MAX_FRAME_TIME
+ * Maximum minor frame time in milliseconds
+ */
+#define API429_FRAMING_MAX_FRAME_TIME       65535
+
+
+
+/*! \struct api429_framing_label
+ *
+ * This structure describes a transfer that shall be scheduled
+ * with a specific rate
+ */
+struct api429_framing_label
+{
+    struct api429_xfer xfer;    /*!< Transfer set-up as used for \ref Api429TxXferCreate. The 'xfer_gap' member specifies the gap that has to follow the data word */
+    AiUInt32 rate_ms;           /*!< Transmission period of the transfer in milliseconds */
+};
+
+/*! \typedef TY_API429_FRAMING_LABEL
+ * Convenience typedef for \ref api429_framing_label
+ */
+typedef struct api429_framing_label TY_API429_FRAMING_LABEL;
+
+
+/*! \struct api429_framing_setup
+ *
+ * This structure comprises global settings for calculating a framing
+ */
+struct api429_framing_setup
+{
+    enum api429_speed speed;    /*!< Speed of the transmit channel. See \ref api429_speed */
+    AiUInt32 nop_xfer_id;       /*!< ID of a NOP transfer that is created and put into minor frames which do not contain any transfer.
+                                     Only required if such minor frames occur. Must not be used by any of the labels */
+};
+
+/*! \typedef TY_API429_FRAMING_SETUP
+ * Convenience typedef for \ref api429_framing_setup
+ */
+typedef struct api429_framing_setup TY_API429_FRAMING_SETUP;
+
+
+/*! \struct api429_framing_label_report
+ *
+ * This structure holds the calculated timing of one transfer
+ */
+struct api429_framing_label_report
+{
+    AiUInt32 xfer_id;           /*!< ID of the transfer */
+    AiUInt32 rate_ms;           /*!< Transmission period of the transfer in milliseconds */
+    AiUInt32 phase;             /*!< Index of the first minor frame in the major frame the transfer is sent in */
+    AiUInt32 min_offset_us;     /*!< Earliest start of transmission relative to the start of a minor frame in microseconds */
+    AiUInt32 max_offset_us;     /*!< Latest start of transmission relative to the start of a minor frame in microseconds */
+    AiUInt32 jitter_us;         /*!< Worst case deviation of the transmission period in microseconds */
+};
+
+/*! \typedef TY_API429_FRAMING_LABEL_REPORT
+ * Convenience typedef for \ref api429_framing_label_report
+ */
+typedef struct api429_framing_label_report TY_API429_FRAMING_LABEL_REPORT;
+
+
+/*! \struct api429_framing_plan
+ *
+ * This structure holds a calculated framing.
+ * It is created with \ref api429_framing_compile and must be released with \ref api429_framing_plan_free
+ */
+struct api429_framing_plan
+{
+    enum api429_speed speed;                        /*!< Channel speed the framing was calculated for */
+    AiUInt32 minor_frame_time;                      /*!< Minor frame time in milliseconds */
+    AiUInt32 major_frame_count;                     /*!< Number of minor frames in the major frame */
+    AiUInt32* major_frame;                          /*!< Index of the minor frame for each position in the major frame */
+    AiUInt32 minor_frame_count;                     /*!< Number of distinct minor frames */
+    AiUInt32* minor_frame_start;                    /*!< Index of the first transfer of each minor frame in 'minor_frame_xfers'. Holds 'minor_frame_count' + 1 entries */
+    AiUInt32* minor_frame_xfers;                    /*!< Transfer IDs of all distinct minor frames */
+    AiUInt32 label_count;                           /*!< Number of scheduled transfers */
+    struct api429_xfer* xfers;                      /*!< Set-up of all scheduled transfers */
+    struct api429_framing_label_report* labels;     /*!< Calculated timing of all scheduled transfers */
+    AiBoolean nop_required;                         /*!< AiTrue if the NOP transfer is used for empty minor frames */
+    AiUInt32 nop_xfer_id;                           /*!< ID of the NOP transfer */
+    AiDouble utilization;                           /*!< Average bus utilization of the framing (0.0 .. 1.0) */
+    AiDouble peak_utilization;                      /*!< Bus utilization of the busiest minor frame (0.0 .. 1.0) */
+    AiUInt32 max_jitter_us;                         /*!< Worst case jitter of all transfers in microseconds */
+};
+
+/*! \typedef TY_API429_FRAMING_PLAN
+ * Convenience typedef for \ref api429_framing_plan
+ */
+typedef struct api429_framing_plan TY_API429_FRAMING_PLAN;
+
+
+
+
+/*! \brief Calculate greatest common divisor
+ */
+static AI_INLINE AiUInt64 api429_framing_gcd(AiUInt64 a, AiUInt64 b)
+{
+    AiUInt64 t;
+
+    while(b)
+    {
+        t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+
+/*! \brief Get number of bit times a transfer occupies the bus
+ */
+static AI_INLINE AiUInt32 api429_framing_xfer_bits(const struct api429_xfer* xfer)
+{
+    switch(xfer->xfer_type)
+    {
+        case API429_TX_LAB_XFER:
+        case API429_TX_LAB_XFER_TT:
+        case API429_TX_LAB_XFER_32:
+        case API429_TX_LAB_XFER_TT_32:
+            return api429_timing_word_bits(xfer->xfer_gap);
+
+        default:
+            return 0;
+    }
+}
+
+
+/*! \brief Release a framing plan
+ *
+ * @param plan plan to release. May be NULL
+ */
+static AI_INLINE void api429_framing_plan_free(struct api429_framing_plan* plan)
+{
+    if(!plan)
+    {
+        return;
+    }
+
+    free(plan->major_frame);
+    free(plan->minor_frame_start);
+    free(plan->minor_frame_xfers);
+    free(plan->xfers);
+    free(plan->labels);
+    free(plan);
+}
+
+
+/*! \brief Calculate a framing for a set of transfers with given rates
+ *
+ * @param [in] setup global framing settings. See \ref api429_framing_setup
+ * @param [in] labels array of transfers to schedule
+ * @param [in] label_count number of entries in 'labels'
+ * @param [out] plan_out the calculated plan is stored here. Must be released with \ref api429_framing_plan_free
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_INVALID_RATE if the rates do not fit into a major frame or the bus capacity is exceeded
+ * - AI429_ERR_INVALID_FRAME if the framing exceeds the frame limits of the board
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_framing_compile(const struct api429_framing_setup* setup, const struct api429_framing_label* labels,
+                                                 AiUInt32 label_count, struct api429_framing_plan** plan_out)
+{
+    struct api429_framing_plan* plan = NULL;
+    AiUInt32* order = NULL;
+    AiUInt32* load = NULL;
+    AiUInt32* slot_fill = NULL;
+    AiUInt32* slot_start = NULL;
+    AiUInt32* slot_xfers = NULL;
+    AiUInt32* slot_hash = NULL;
+    AiUInt64 minor;
+    AiUInt64 major;
+    AiUInt64 busy_bits;
+    AiUInt32 slots;
+    AiUInt32 total;
+    AiUInt32 peak;
+    AiUInt32 bit_ns;
+    AiUInt32 i, j, k, s, u;
+    AiReturn ret = API_OK;
+
+    if(!setup || !labels || !plan_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *plan_out = NULL;
+
+    if(label_count == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    /* Minor frame time is GCD of all rates, major frame is LCM of all rates */
+    minor = 0;
+    major = 1;
+    for(i = 0; i < label_count; i++)
+    {
+        if(labels[i].rate_ms == 0 || labels[i].xfer.xfer_id == 0 || labels[i].xfer.xfer_id == setup->nop_xfer_id)
+        {
+            return AI429_ERR_PARAMETER_RANGE;
+        }
+
+        minor = api429_framing_gcd(minor, labels[i].rate_ms);
+        major = major / api429_framing_gcd(major, labels[i].rate_ms) * labels[i].rate_ms;
+
+        if(major > (AiUInt64) API429_FRAMING_MAX_MINOR_FRAMES * API429_FRAMING_MAX_FRAME_TIME)
+        {
+            return AI429_ERR_INVALID_RATE;
+        }
+    }
+
+    if(minor > API429_FRAMING_MAX_FRAME_TIME || major / minor > API429_FRAMING_MAX_MINOR_FRAMES)
+    {
+        return AI429_ERR_INVALID_RATE;
+    }
+
+    slots  = (AiUInt32) (major / minor);
+    bit_ns = api429_timing_bit_time_ns(setup->speed);
+
+    plan       = (struct api429_framing_plan*) calloc(1, sizeof(struct api429_framing_plan));
+    order      = (AiUInt32*) calloc(label_count, sizeof(AiUInt32));
+    load       = (AiUInt32*) calloc(slots, sizeof(AiUInt32));
+    slot_fill  = (AiUInt32*) calloc(slots, sizeof(AiUInt32));
+    slot_start = (AiUInt32*) calloc(slots + 1, sizeof(AiUInt32));
+    slot_hash  = (AiUInt32*) calloc(slots, sizeof(AiUInt32));
+    if(!plan || !order || !load || !slot_fill || !slot_start || !slot_hash)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    plan->speed             = setup->speed;
+    plan->minor_frame_time  = (AiUInt32) minor;
+    plan->major_frame_count = slots;
+    plan->label_count       = label_count;
+    plan->nop_xfer_id       = setup->nop_xfer_id;
+    plan->xfers  = (struct api429_xfer*) calloc(label_count, sizeof(struct api429_xfer));
+    plan->labels = (struct api429_framing_label_report*) calloc(label_count, sizeof(struct api429_framing_label_report));
+    plan->major_frame = (AiUInt32*) calloc(slots, sizeof(AiUInt32));
+    if(!plan->xfers || !plan->labels || !plan->major_frame)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    /* Rate-monotonic order: shortest period first, ties are resolved by transfer ID */
+    for(i = 0; i < label_count; i++)
+    {
+        for(j = i; j > 0; j--)
+        {
+            const struct api429_framing_label* a = &labels[order[j - 1]];
+            const struct api429_framing_label* b = &labels[i];
+
+            if(a->rate_ms < b->rate_ms || (a->rate_ms == b->rate_ms && a->xfer.xfer_id < b->xfer.xfer_id))
+            {
+                break;
+            }
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+
+    /* Assign each transfer to the phase with the lowest peak load, then the lowest load spread.
+     * The load of a minor frame before adding a transfer is the transfer's start offset in that frame. */
+    total = 0;
+    for(i = 0; i < label_count; i++)
+    {
+        const struct api429_framing_label* label = &labels[order[i]];
+        struct api429_framing_label_report* report = &plan->labels[i];
+        AiUInt32 period = label->rate_ms / (AiUInt32) minor;
+        AiUInt32 bits = api429_framing_xfer_bits(&label->xfer);
+        AiUInt32 best_phase = 0;
+        AiUInt32 best_max = 0xFFFFFFFF;
+        AiUInt32 best_min = 0;
+
+        for(j = 0; j < period; j++)
+        {
+            AiUInt32 max = 0;
+            AiUInt32 min = 0xFFFFFFFF;
+
+            for(s = j; s < slots; s += period)
+            {
+                max = load[s] > max ? load[s] : max;
+                min = load[s] < min ? load[s] : min;
+            }
+
+            if(max < best_max || (max == best_max && max - min < best_max - best_min))
+            {
+                best_phase = j;
+                best_max   = max;
+                best_min   = min;
+            }
+        }
+
+        for(s = best_phase; s < slots; s += period)
+        {
+            load[s] += bits;
+            slot_fill[s]++;
+            total++;
+        }
+
+        plan->xfers[i]         = label->xfer;
+        report->xfer_id        = label->xfer.xfer_id;
+        report->rate_ms        = label->rate_ms;
+        report->phase          = best_phase;
+        report->min_offset_us  = (AiUInt32) (((AiUInt64) best_min * bit_ns) / 1000);
+        report->max_offset_us  = (AiUInt32) (((AiUInt64) best_max * bit_ns) / 1000);
+        report->jitter_us      = report->max_offset_us - report->min_offset_us;
+        plan->max_jitter_us    = report->jitter_us > plan->max_jitter_us ? report->jitter_us : plan->max_jitter_us;
+    }
+
+    /* Check bus capacity */
+    peak = 0;
+    busy_bits = 0;
+    for(s = 0; s < slots; s++)
+    {
+        peak = load[s] > peak ? load[s] : peak;
+        busy_bits += load[s];
+
+        if(slot_fill[s] > API429_FRAMING_MAX_FRAME_XFERS)
+        {
+            ret = AI429_ERR_INVALID_FRAME;
+            goto out;
+        }
+
+        if(slot_fill[s] == 0)
+        {
+            plan->nop_required = AiTrue;
+            slot_fill[s] = 1;
+            total++;
+        }
+    }
+
+    if((AiUInt64) peak * bit_ns > minor * 1000000)
+    {
+        ret = AI429_ERR_INVALID_RATE;
+        goto out;
+    }
+
+    if(plan->nop_required && plan->nop_xfer_id == 0)
+    {
+        ret = AI429_ERR_INVALID_FRAME;
+        goto out;
+    }
+
+    plan->peak_utilization = (AiDouble) peak * bit_ns / ((AiDouble) minor * 1000000.0);
+    plan->utilization      = (AiDouble) busy_bits * bit_ns / ((AiDouble) major * 1000000.0);
+
+    /* Fill the transfer lists of all minor frames in rate-monotonic order */
+    slot_xfers = (AiUInt32*) calloc(total, sizeof(AiUInt32));
+    if(!slot_xfers)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    for(s = 0; s < slots; s++)
+    {
+        slot_start[s + 1] = slot_start[s] + slot_fill[s];
+        slot_fill[s] = 0;
+    }
+
+    for(i = 0; i < label_count; i++)
+    {
+        AiUInt32 period = plan->labels[i].rate_ms / (AiUInt32) minor;
+
+        for(s = plan->labels[i].phase; s < slots; s += period)
+        {
+            slot_xfers[slot_start[s] + slot_fill[s]++] = plan->labels[i].xfer_id;
+        }
+    }
+
+    for(s = 0; s < slots; s++)
+    {
+        if(slot_fill[s] == 0)
+        {
+            slot_xfers[slot_start[s]] = plan->nop_xfer_id;
+            slot_fill[s] = 1;
+        }
+
+        /* FNV-1a hash of the transfer list for fast detection of identical minor frames */
+        slot_hash[s] = 2166136261u;
+        for(k = slot_start[s]; k < slot_start[s + 1]; k++)
+        {
+            slot_hash[s] = (slot_hash[s] ^ slot_xfers[k]) * 16777619u;
+        }
+    }
+
+    /* Share identical minor frames. Distinct frames are collected in place at the front of the slot arrays */
+    plan->minor_frame_start = (AiUInt32*) calloc(slots + 1, sizeof(AiUInt32));
+    plan->minor_frame_xfers = (AiUInt32*) calloc(total, sizeof(AiUInt32));
+    if(!plan->minor_frame_start || !plan->minor_frame_xfers)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    u = 0;
+    for(s = 0; s < slots; s++)
+    {
+        AiUInt32 len = slot_fill[s];
+
+        for(k = 0; k < u; k++)
+        {
+            AiUInt32 first = plan->minor_frame_start[k];
+
+            if(slot_hash[k] == slot_hash[s] && plan->minor_frame_start[k + 1] - first == len
+               && !memcmp(&plan->minor_frame_xfers[first], &slot_xfers[slot_start[s]], len * sizeof(AiUInt32)))
+            {
+                break;
+            }
+        }
+
+        if(k == u)
+        {
+            memcpy(&plan->minor_frame_xfers[plan->minor_frame_start[u]], &slot_xfers[slot_start[s]], len * sizeof(AiUInt32));
+            plan->minor_frame_start[u + 1] = plan->minor_frame_start[u] + len;
+            slot_hash[u] = slot_hash[s];
+            u++;
+        }
+
+        plan->major_frame[s] = k;
+    }
+
+    plan->minor_frame_count = u;
+    if(u > API429_FRAMING_MAX_FRAME_ID + 1)
+    {
+        ret = AI429_ERR_INVALID_FRAME;
+        goto out;
+    }
+
+out:
+    free(order);
+    free(load);
+    free(slot_fill);
+    free(slot_start);
+    free(slot_xfers);
+    free(slot_hash);
+
+    if(ret != API_OK)
+    {
+        api429_framing_plan_free(plan);
+        return ret;
+    }
+
+    *plan_out = plan;
+
+    return API_OK;
+}
+
+
+/*! \brief Create all transfers of a framing plan
+ *
+ * Creates all scheduled transfers and, if required, the NOP transfer for empty minor frames
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] plan plan as calculated by \ref api429_framing_compile
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_framing_xfers_create(AiUInt8 board_handle, AiUInt8 channel, const struct api429_framing_plan* plan)
+{
+    struct api429_xfer xfer;
+    struct api429_xfer_out xfer_out;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        xfer = plan->xfers[i];
+        ret = Api429TxXferCreate(board_handle, channel, &xfer, &xfer_out);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        if(xfer_out.ul_Status != 0)
+        {
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+    }
+
+    if(plan->nop_required)
+    {
+        memset(&xfer, 0, sizeof(xfer));
+        xfer.xfer_id   = plan->nop_xfer_id;
+        xfer.xfer_type = API429_TX_NOP_XFER;
+        xfer.err_type  = API429_XFER_ERR_DIS;
+        xfer.buf_size  = 1;
+        xfer.ir_index  = 1;
+
+        ret = Api429TxXferCreate(board_handle, channel, &xfer, &xfer_out);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Create all distinct minor frames of a framing plan
+ *
+ * The minor frames get consecutive frame IDs starting at 'first_frame_id'
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] plan plan as calculated by \ref api429_framing_compile
+ * @param [in] first_frame_id ID of the first minor frame
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_framing_minor_frames_create(AiUInt8 board_handle, AiUInt8 channel, const struct api429_framing_plan* plan,
+                                                             AiUInt32 first_frame_id)
+{
+    struct api429_mframe_in frame_in;
+    struct api429_mframe_out frame_out;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(first_frame_id + plan->minor_frame_count - 1 > API429_FRAMING_MAX_FRAME_ID)
+    {
+        return AI429_ERR_MIN_FRM_ID;
+    }
+
+    for(i = 0; i < plan->minor_frame_count; i++)
+    {
+        frame_in.ul_FrmId   = first_frame_id + i;
+        frame_in.ul_XferCnt = plan->minor_frame_start[i + 1] - plan->minor_frame_start[i];
+        frame_in.pul_Xfers  = &plan->minor_frame_xfers[plan->minor_frame_start[i]];
+
+        ret = Api429TxMinorFrameCreate(board_handle, channel, &frame_in, &frame_out);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Create the major frame of a framing plan
+ *
+ * The minor frames must have been created with \ref api429_framing_minor_frames_create before.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] plan plan as calculated by \ref api429_framing_compile
+ * @param [in] first_frame_id ID of the first minor frame as used for \ref api429_framing_minor_frames_create
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_framing_major_frame_create(AiUInt8 board_handle, AiUInt8 channel, const struct api429_framing_plan* plan,
+                                                            AiUInt32 first_frame_id)
+{
+    AiUInt32* frames;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    frames = (AiUInt32*) malloc(plan->major_frame_count * sizeof(AiUInt32));
+    if(!frames)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    for(i = 0; i < plan->major_frame_count; i++)
+    {
+        frames[i] = first_frame_id + plan->major_frame[i];
+    }
+
+    ret = Api429TxMajorFrameCreate(board_handle, channel, plan->major_frame_count, frames);
+
+    free(frames);
+
+    return ret;
+}
+
+
+/*! \brief Install a framing plan on a transmit channel
+ *
+ * Sets the minor frame time, creates all transfers, the minor frames and the major frame.
+ * The channel must be initialized with \ref API429_TX_MODE_FRAMING and must not contain any
+ * transfers or frames with the IDs used by the plan.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] plan plan as calculated by \ref api429_framing_compile
+ * @param [in] first_frame_id ID of the first minor frame. Distinct minor frames use consecutive IDs
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_framing_apply(AiUInt8 board_handle, AiUInt8 channel, const struct api429_framing_plan* plan,
+                                               AiUInt32 first_frame_id)
+{
+    AiReturn ret;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ret = Api429TxFrameTimeSet(board_handle, channel, (AiUInt16) plan->minor_frame_time);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    ret = api429_framing_xfers_create(board_handle, channel, plan);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    ret = api429_framing_minor_frames_create(board_handle, channel, plan, first_frame_id);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    return api429_framing_major_frame_create(board_handle, channel, plan, first_frame_id);
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429FRAMING_H_ */
@@ -0,0 +1,607 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429FramingSwitch.h
+ *
+ *  This header file contains inline helper functions
+ *  for changing the framing of a running transmit channel
+ */
+
+#ifndef API429FRAMINGSWITCH_H_
+#define API429FRAMINGSWITCH_H_
+
+
+#include "Api429.h"
+#include "Api429Framing.h"
+#include "Ai_mutex.h"
+
+
+/**
+* \defgroup framing_switch Double-Buffered Framing
+  This module allows to exchange the framing of a running transmit channel
+  without halting it. \n
+  The minor frame IDs are split into two banks. While the major frame built from the
+  minor frames of the active bank is sent, the new framing is set up in the other bank.
+  The first minor frame of each major frame starts with a marker NOP transfer that raises
+  an \ref API429_EVENT_TX_LABEL event. When the marker of the active bank signals the start of a
+  major frame, the major frame is re-created from the staged bank, so the exchange is done early in
+  the major frame and takes effect at the following major frame boundary.
+  When the marker of the staged bank is seen, the old bank is no longer in use, and its minor frames
+  and transfers that are not part of the new framing are deleted. \n
+  Transfers with the same ID and the same setup in the old and the new framing are kept as they are, so
+  their buffers continue without interruption. Using an ID of the old framing with a different setup
+  fails with AI429_ERR_XFER_ID. \n
+  The events must be forwarded to \ref api429_framing_switch_event from the channel's event handler
+  that is registered with \ref Api429ChannelCallbackRegister.
+* @{
+*/
+
+
+
+/*! \def API429_FRAMING_BANK_FRAMES
+ * Number of minor frame IDs available for each bank
+ */
+#define API429_FRAMING_BANK_FRAMES  ((API429_FRAMING_MAX_FRAME_ID + 1) / 2)
+
+
+
+/*! \enum api429_framing_switch_state
+ *
+ * Enumeration of all states of a framing switch
+ */
+enum api429_framing_switch_state
+{
+    API429_FRAMING_SWITCH_IDLE = 0,     /*!< No framing change is pending */
+    API429_FRAMING_SWITCH_STAGED,       /*!< New framing is set up and waits for the start of a major frame */
+    API429_FRAMING_SWITCH_COMMITTED     /*!< Major frame was exchanged, waiting for the new framing to start */
+};
+
+/*! \typedef TY_E_API429_FRAMING_SWITCH_STATE
+ * Convenience typedef for \ref api429_framing_switch_state
+ */
+typedef enum api429_framing_switch_state TY_E_API429_FRAMING_SWITCH_STATE;
+
+
+/*! \struct api429_framing_switch
+ *
+ * This structure holds the state of a double-buffered framing on one transmit channel.
+ * It is created with \ref api429_framing_switch_create
+ */
+struct api429_framing_switch
+{
+    AiUInt8 board_handle;                           /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                                /*!< ID of the transmit channel */
+    struct ai_mutex* lock;                          /*!< Protects the switch state against the event handler */
+    AiUInt32 marker_xfer_id[2];                     /*!< IDs of the marker NOP transfers of both banks */
+    struct api429_framing_plan* plan[2];            /*!< Framing installed in each bank. NULL if bank is empty */
+    AiUInt32* frames;                               /*!< Major frame of the staged bank */
+    AiUInt32 active;                                /*!< Index of the bank that is currently sent */
+    volatile enum api429_framing_switch_state state;/*!< Current state. See \ref api429_framing_switch_state */
+    AiUInt32 switch_count;                          /*!< Number of completed framing changes */
+};
+
+/*! \typedef TY_API429_FRAMING_SWITCH
+ * Convenience typedef for \ref api429_framing_switch
+ */
+typedef struct api429_framing_switch TY_API429_FRAMING_SWITCH;
+
+
+
+
+/*! \brief Get ID of the first minor frame of a bank
+ */
+static AI_INLINE AiUInt32 api429_framing_switch_first_frame(AiUInt32 bank)
+{
+    return bank * API429_FRAMING_BANK_FRAMES;
+}
+
+
+/*! \brief Find the setup of a transfer in a plan
+ *
+ * The NOP transfer of a plan is returned with the setup it is created with.
+ * @return AiTrue if the transfer is part of the plan. Its setup is stored in 'setup'
+ */
+static AI_INLINE AiBoolean api429_framing_switch_plan_xfer_get(const struct api429_framing_plan* plan, AiUInt32 xfer_id,
+                                                               struct api429_xfer* setup)
+{
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AiFalse;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        if(plan->xfers[i].xfer_id == xfer_id)
+        {
+            *setup = plan->xfers[i];
+            return AiTrue;
+        }
+    }
+
+    if(plan->nop_required && plan->nop_xfer_id == xfer_id)
+    {
+        memset(setup, 0, sizeof(struct api429_xfer));
+        setup->xfer_id   = xfer_id;
+        setup->xfer_type = API429_TX_NOP_XFER;
+        setup->err_type  = API429_XFER_ERR_DIS;
+        setup->buf_size  = 1;
+        setup->ir_index  = 1;
+        return AiTrue;
+    }
+
+    return AiFalse;
+}
+
+
+/*! \brief Check if a transfer is part of a plan
+ */
+static AI_INLINE AiBoolean api429_framing_switch_plan_has_xfer(const struct api429_framing_plan* plan, AiUInt32 xfer_id)
+{
+    struct api429_xfer setup;
+
+    return api429_framing_switch_plan_xfer_get(plan, xfer_id, &setup);
+}
+
+
+/*! \brief Create a transfer if it is not part of another plan yet
+ *
+ * A transfer of the other plan is only reused if its setup is identical,
+ * as the timing of the new plan depends on gap and type of its transfers.
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_XFER_ID if the other plan uses the ID with a different setup
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_framing_switch_xfer_create(struct api429_framing_switch* sw, const struct api429_framing_plan* other,
+                                                            const struct api429_xfer* setup)
+{
+    struct api429_xfer xfer = *setup;
+    struct api429_xfer existing;
+    struct api429_xfer_out xfer_out;
+    AiReturn ret;
+
+    if(api429_framing_switch_plan_xfer_get(other, xfer.xfer_id, &existing))
+    {
+        if(existing.xfer_type != xfer.xfer_type || existing.err_type != xfer.err_type || existing.xfer_gap != xfer.xfer_gap
+           || existing.ir_index != xfer.ir_index || existing.buf_size != xfer.buf_size || existing.xfer_ir != xfer.xfer_ir)
+        {
+            return AI429_ERR_XFER_ID;
+        }
+
+        return API_OK;
+    }
+
+    ret = Api429TxXferCreate(sw->board_handle, sw->channel, &xfer, &xfer_out);
+    if(ret == API_OK && xfer_out.ul_Status != 0)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    return ret;
+}
+
+
+/*! \brief Create all transfers, the marker and the minor frames of a plan in a bank
+ *
+ * The major frame of the bank is stored in 'sw->frames'.
+ * The first minor frame of the major frame is duplicated with the bank's marker in front of it
+ * and gets the ID following the plan's minor frames.
+ */
+static AI_INLINE AiReturn api429_framing_switch_bank_setup(struct api429_framing_switch* sw, AiUInt32 bank,
+                                                           const struct api429_framing_plan* plan)
+{
+    const struct api429_framing_plan* other = sw->plan[bank ^ 1];
+    struct api429_mframe_in frame_in;
+    struct api429_mframe_out frame_out;
+    struct api429_xfer xfer;
+    AiUInt32 first_frame = api429_framing_switch_first_frame(bank);
+    AiUInt32 entry;
+    AiUInt32 len;
+    AiUInt32* entry_xfers;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(plan->minor_frame_count + 1 > API429_FRAMING_BANK_FRAMES)
+    {
+        return AI429_ERR_MIN_FRM_ID;
+    }
+
+    entry = plan->major_frame[0];
+    len = plan->minor_frame_start[entry + 1] - plan->minor_frame_start[entry];
+    if(len + 1 > API429_FRAMING_MAX_FRAME_XFERS)
+    {
+        return AI429_ERR_INVALID_FRAME;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        if(plan->xfers[i].xfer_id == sw->marker_xfer_id[0] || plan->xfers[i].xfer_id == sw->marker_xfer_id[1])
+        {
+            return AI429_ERR_XFER_ID;
+        }
+
+        ret = api429_framing_switch_xfer_create(sw, other, &plan->xfers[i]);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    memset(&xfer, 0, sizeof(xfer));
+    xfer.xfer_type = API429_TX_NOP_XFER;
+    xfer.err_type  = API429_XFER_ERR_DIS;
+    xfer.buf_size  = 1;
+    xfer.ir_index  = 1;
+
+    if(plan->nop_required)
+    {
+        xfer.xfer_id = plan->nop_xfer_id;
+        ret = api429_framing_switch_xfer_create(sw, other, &xfer);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    /* The marker raises an event each time the major frame of this bank starts */
+    xfer.xfer_id = sw->marker_xfer_id[bank];
+    xfer.xfer_ir = 1;
+    ret = api429_framing_switch_xfer_create(sw, NULL, &xfer);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    for(i = 0; i < plan->minor_frame_count; i++)
+    {
+        frame_in.ul_FrmId   = first_frame + i;
+        frame_in.ul_XferCnt = plan->minor_frame_start[i + 1] - plan->minor_frame_start[i];
+        frame_in.pul_Xfers  = &plan->minor_frame_xfers[plan->minor_frame_start[i]];
+
+        ret = Api429TxMinorFrameCreate(sw->board_handle, sw->channel, &frame_in, &frame_out);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    entry_xfers = (AiUInt32*) malloc((len + 1) * sizeof(AiUInt32));
+    sw->frames  = (AiUInt32*) malloc(plan->major_frame_count * sizeof(AiUInt32));
+    if(!entry_xfers || !sw->frames)
+    {
+        free(entry_xfers);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    entry_xfers[0] = sw->marker_xfer_id[bank];
+    memcpy(&entry_xfers[1], &plan->minor_frame_xfers[plan->minor_frame_start[entry]], len * sizeof(AiUInt32));
+
+    frame_in.ul_FrmId   = first_frame + plan->minor_frame_count;
+    frame_in.ul_XferCnt = len + 1;
+    frame_in.pul_Xfers  = entry_xfers;
+
+    ret = Api429TxMinorFrameCreate(sw->board_handle, sw->channel, &frame_in, &frame_out);
+
+    free(entry_xfers);
+
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    sw->frames[0] = first_frame + plan->minor_frame_count;
+    for(i = 1; i < plan->major_frame_count; i++)
+    {
+        sw->frames[i] = first_frame + plan->major_frame[i];
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Delete the minor frames and all transfers of a bank that are not used by the other bank
+ *
+ * The plan of the bank is not released
+ */
+static AI_INLINE void api429_framing_switch_bank_release(struct api429_framing_switch* sw, AiUInt32 bank)
+{
+    struct api429_framing_plan* plan = sw->plan[bank];
+    const struct api429_framing_plan* other = sw->plan[bank ^ 1];
+    AiUInt32 first_frame = api429_framing_switch_first_frame(bank);
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return;
+    }
+
+    for(i = 0; i <= plan->minor_frame_count; i++)
+    {
+        Api429TxMinorFrameDelete(sw->board_handle, sw->channel, first_frame + i);
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        if(!api429_framing_switch_plan_has_xfer(other, plan->xfers[i].xfer_id))
+        {
+            Api429TxXferDelete(sw->board_handle, sw->channel, plan->xfers[i].xfer_id);
+        }
+    }
+
+    if(plan->nop_required && !api429_framing_switch_plan_has_xfer(other, plan->nop_xfer_id))
+    {
+        Api429TxXferDelete(sw->board_handle, sw->channel, plan->nop_xfer_id);
+    }
+
+    Api429TxXferDelete(sw->board_handle, sw->channel, sw->marker_xfer_id[bank]);
+}
+
+
+/*! \brief Create a double-buffered framing for a transmit channel
+ *
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel. Must be initialized with \ref API429_TX_MODE_FRAMING
+ * @param [in] marker_xfer_id_a ID of the marker transfer of the first bank. Must not be used by any framing
+ * @param [in] marker_xfer_id_b ID of the marker transfer of the second bank. Must not be used by any framing
+ * @param [out] sw_out the created framing switch is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_framing_switch_create(AiUInt8 board_handle, AiUInt8 channel, AiUInt32 marker_xfer_id_a,
+                                                       AiUInt32 marker_xfer_id_b, struct api429_framing_switch** sw_out)
+{
+    struct api429_framing_switch* sw;
+
+    if(!sw_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(marker_xfer_id_a == 0 || marker_xfer_id_b == 0 || marker_xfer_id_a == marker_xfer_id_b)
+    {
+        return AI429_ERR_XFER_ID;
+    }
+
+    sw = (struct api429_framing_switch*) calloc(1, sizeof(struct api429_framing_switch));
+    if(!sw)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    sw->lock = ai_mutex_create();
+    if(!sw->lock)
+    {
+        free(sw);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    sw->board_handle      = board_handle;
+    sw->channel           = channel;
+    sw->marker_xfer_id[0] = marker_xfer_id_a;
+    sw->marker_xfer_id[1] = marker_xfer_id_b;
+    sw->state             = API429_FRAMING_SWITCH_IDLE;
+
+    *sw_out = sw;
+
+    return API_OK;
+}
+
+
+/*! \brief Release a double-buffered framing
+ *
+ * The framings installed on the board are not deleted.
+ * The event handler must not forward events to the switch any more.
+ * @param sw the framing switch to release. May be NULL
+ */
+static AI_INLINE void api429_framing_switch_free(struct api429_framing_switch* sw)
+{
+    if(!sw)
+    {
+        return;
+    }
+
+    api429_framing_plan_free(sw->plan[0]);
+    api429_framing_plan_free(sw->plan[1]);
+    free(sw->frames);
+    ai_mutex_free(sw->lock);
+    free(sw);
+}
+
+
+/*! \brief Install the initial framing
+ *
+ * The channel must not be started yet. \n
+ * The switch takes ownership of the plan on success, it must not be freed by the caller.
+ * @param [in] sw the framing switch
+ * @param [in] plan framing as calculated by \ref api429_framing_compile
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_framing_switch_init(struct api429_framing_switch* sw, struct api429_framing_plan* plan)
+{
+    AiReturn ret;
+
+    if(!sw || !plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(sw->plan[0] || sw->plan[1])
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    ret = Api429TxFrameTimeSet(sw->board_handle, sw->channel, (AiUInt16) plan->minor_frame_time);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    sw->plan[0] = plan;
+    sw->active  = 0;
+
+    ret = api429_framing_switch_bank_setup(sw, 0, plan);
+    if(ret == API_OK)
+    {
+        ret = Api429TxMajorFrameCreate(sw->board_handle, sw->channel, plan->major_frame_count, sw->frames);
+    }
+
+    free(sw->frames);
+    sw->frames = NULL;
+
+    if(ret != API_OK)
+    {
+        api429_framing_switch_bank_release(sw, 0);
+        sw->plan[0] = NULL;
+    }
+
+    return ret;
+}
+
+
+/*! \brief Stage a new framing on a running channel
+ *
+ * Transfers and minor frames of the new framing are created in the inactive bank.
+ * The framing is exchanged at the next major frame boundary by \ref api429_framing_switch_event. \n
+ * The new plan must use the same minor frame time as the active one. \n
+ * The switch takes ownership of the plan on success, it must not be freed by the caller.
+ * @param [in] sw the framing switch
+ * @param [in] plan framing as calculated by \ref api429_framing_compile
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_CHANNEL_ACTIVE if a previous framing change is still pending
+ * - AI429_ERR_INVALID_RATE if the minor frame time differs from the active framing
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_framing_switch_stage(struct api429_framing_switch* sw, struct api429_framing_plan* plan)
+{
+    AiUInt32 bank;
+    AiReturn ret;
+
+    if(!sw || !plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(sw->lock);
+
+    bank = sw->active ^ 1;
+
+    if(sw->state != API429_FRAMING_SWITCH_IDLE || !sw->plan[sw->active] || sw->plan[bank])
+    {
+        ai_mutex_release(sw->lock);
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    if(plan->minor_frame_time != sw->plan[sw->active]->minor_frame_time)
+    {
+        ai_mutex_release(sw->lock);
+        return AI429_ERR_INVALID_RATE;
+    }
+
+    ret = api429_framing_switch_bank_setup(sw, bank, plan);
+    if(ret != API_OK)
+    {
+        /* Clean up what has been created so far */
+        free(sw->frames);
+        sw->frames = NULL;
+        sw->plan[bank] = plan;
+        api429_framing_switch_bank_release(sw, bank);
+        sw->plan[bank] = NULL;
+        ai_mutex_release(sw->lock);
+        return ret;
+    }
+
+    sw->plan[bank] = plan;
+    sw->state = API429_FRAMING_SWITCH_STAGED;
+
+    ai_mutex_release(sw->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Check if a framing change is pending
+ *
+ * @param [in] sw the framing switch
+ * @return AiTrue if a staged framing has not been activated yet
+ */
+static AI_INLINE AiBoolean api429_framing_switch_pending(const struct api429_framing_switch* sw)
+{
+    return sw->state != API429_FRAMING_SWITCH_IDLE;
+}
+
+
+/*! \brief Process a channel event
+ *
+ * Must be called from the event handler of the channel for each event.
+ * @param [in] sw the framing switch
+ * @param [in] type type of the event
+ * @param [in] info additional event information as passed to the event handler
+ * @return AiTrue if the event was raised by one of the marker transfers, AiFalse otherwise
+ */
+static AI_INLINE AiBoolean api429_framing_switch_event(struct api429_framing_switch* sw, enum api429_event_type type,
+                                                       const struct api429_intr_loglist_entry* info)
+{
+    AiUInt32 xfer_id;
+    AiUInt32 staged;
+
+    if(!sw || !info || type != API429_EVENT_TX_LABEL)
+    {
+        return AiFalse;
+    }
+
+    xfer_id = info->x_Llc.t.ul_Info;
+    if(xfer_id != sw->marker_xfer_id[0] && xfer_id != sw->marker_xfer_id[1])
+    {
+        return AiFalse;
+    }
+
+    ai_mutex_lock(sw->lock);
+
+    staged = sw->active ^ 1;
+
+    if(sw->state == API429_FRAMING_SWITCH_STAGED && xfer_id == sw->marker_xfer_id[sw->active])
+    {
+        /* Old major frame just started, so there is a whole major frame left for exchanging it */
+        if(Api429TxMajorFrameCreate(sw->board_handle, sw->channel, sw->plan[staged]->major_frame_count, sw->frames) == API_OK)
+        {
+            free(sw->frames);
+            sw->frames = NULL;
+            sw->state = API429_FRAMING_SWITCH_COMMITTED;
+        }
+    }
+    else if(sw->state == API429_FRAMING_SWITCH_COMMITTED && xfer_id == sw->marker_xfer_id[staged])
+    {
+        /* New major frame is running, old bank is not referenced any more */
+        sw->active = staged;
+        api429_framing_switch_bank_release(sw, staged ^ 1);
+        api429_framing_plan_free(sw->plan[staged ^ 1]);
+        sw->plan[staged ^ 1] = NULL;
+        sw->state = API429_FRAMING_SWITCH_IDLE;
+        sw->switch_count++;
+    }
+
+    ai_mutex_release(sw->lock);
+
+    return AiTrue;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429FRAMINGSWITCH_H_ */
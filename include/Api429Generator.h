@@ -0,0 +1,836 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Generator.h
+ *
+ *  This header file contains inline helper functions
+ *  for generating dynamic transfer data on the host
+ */
+
+#ifndef API429GENERATOR_H_
+#define API429GENERATOR_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+#include "Ai_atomic.h"
+
+
+/**
+* \defgroup generator Dynamic Data Generators
+  This module generates waveforms for transfers on framing based transmit channels. \n
+  A generator engine holds a set of signals (sine, triangle, noise, scripted profiles and
+  signals derived from other signals) and a set of outputs. Each output connects a signal with
+  a transfer and describes how the values are encoded (see \ref api429_codec_format). \n
+  The transfer buffer of an output is used as a ring of samples, one sample per transmission.
+  It is completely filled by \ref api429_gen_prefill. The transfer raises an
+  \ref API429_EVENT_TX_INDEX event in the middle of the buffer and on buffer reload, i.e.
+  each time one half of the buffer has been sent. Such events must be passed to
+  \ref api429_gen_event, and \ref api429_gen_service then refills the half that was sent. \n
+  Signals are evaluated for a whole half buffer at once. The sample loops avoid function calls
+  and data dependent branches, so that an optimizing compiler can vectorize them.
+* @{
+*/
+
+
+
+/*! \def API429_GEN_MAX_BUF_SIZE
+ * Maximum transfer buffer size that can be used for generator outputs
+ */
+#define API429_GEN_MAX_BUF_SIZE     1023
+
+/*! \def API429_GEN_MAX_XFER_ID
+ * Maximum transfer ID
+ */
+#define API429_GEN_MAX_XFER_ID      1023
+
+
+
+/*! \enum api429_gen_type
+ *
+ * Enumeration of all signal types
+ */
+enum api429_gen_type
+{
+    API429_GEN_CONST = 0,       /*!< Constant value 'offset' */
+    API429_GEN_SINE,            /*!< offset + amplitude * sin(2 * pi * frequency * t + phase) */
+    API429_GEN_TRIANGLE,        /*!< Triangle between offset - amplitude and offset + amplitude with 'frequency'. 'phase' is given in cycles */
+    API429_GEN_NOISE_UNIFORM,   /*!< offset + uniformly distributed noise in the range -amplitude .. amplitude */
+    API429_GEN_NOISE_GAUSS,     /*!< offset + approximately gaussian noise with standard deviation 'amplitude' */
+    API429_GEN_PROFILE,         /*!< Piecewise linear interpolation of a table of points */
+    API429_GEN_LINEAR,          /*!< offset + gain * value of signal 'source' */
+    API429_GEN_INTEGRAL         /*!< offset + gain * time integral of signal 'source' */
+};
+
+/*! \typedef TY_E_API429_GEN_TYPE
+ * Convenience typedef for \ref api429_gen_type
+ */
+typedef enum api429_gen_type TY_E_API429_GEN_TYPE;
+
+
+/*! \struct api429_gen_signal
+ *
+ * This structure describes a signal.
+ * Members not used by a signal type are ignored.
+ */
+struct api429_gen_signal
+{
+    enum api429_gen_type type;      /*!< Type of the signal. See \ref api429_gen_type */
+    AiDouble offset;                /*!< Constant value that is added to the signal */
+    AiDouble amplitude;             /*!< Amplitude of periodic and noise signals */
+    AiDouble frequency;             /*!< Frequency of periodic signals in Hz */
+    AiDouble phase;                 /*!< Phase of periodic signals. Radian for sine, cycles for triangle */
+    AiUInt32 seed;                  /*!< Seed of noise signals */
+    AiUInt32 point_count;           /*!< Number of points in 'point_time' and 'point_value' for profiles */
+    const AiDouble* point_time;     /*!< Strictly increasing times of profile points in seconds. Copied by \ref api429_gen_signal_add */
+    const AiDouble* point_value;    /*!< Values of profile points. Copied by \ref api429_gen_signal_add */
+    AiBoolean loop;                 /*!< If AiTrue, the profile is repeated after the last point, otherwise the last value is held */
+    AiUInt32 source;                /*!< Index of the source signal of derived signals. Must be lower than the index of this signal */
+    AiDouble gain;                  /*!< Gain of derived signals */
+};
+
+/*! \typedef TY_API429_GEN_SIGNAL
+ * Convenience typedef for \ref api429_gen_signal
+ */
+typedef struct api429_gen_signal TY_API429_GEN_SIGNAL;
+
+
+/*! \struct api429_gen_output_setup
+ *
+ * This structure describes how a signal is sent with a transfer
+ */
+struct api429_gen_output_setup
+{
+    AiUInt32 xfer_id;                       /*!< ID of the transfer. It must be set up with \ref api429_gen_xfer_prepare */
+    AiUInt16 buf_size;                      /*!< Buffer size of the transfer. Ranges from 2 to \ref API429_GEN_MAX_BUF_SIZE */
+    AiDouble period;                        /*!< Transmission period of the transfer in seconds */
+    AiUInt32 signal;                        /*!< Index of the signal to send */
+    struct api429_codec_format format;      /*!< Encoding of the signal values */
+    AiUInt8 label;                          /*!< Label ID */
+    AiUInt8 sdi;                            /*!< SDI */
+    enum api429_ssm_status status;          /*!< SSM status */
+};
+
+/*! \typedef TY_API429_GEN_OUTPUT_SETUP
+ * Convenience typedef for \ref api429_gen_output_setup
+ */
+typedef struct api429_gen_output_setup TY_API429_GEN_OUTPUT_SETUP;
+
+
+/*! \struct api429_gen_output
+ *
+ * This structure holds the state of a generator output
+ */
+struct api429_gen_output
+{
+    struct api429_gen_output_setup setup;   /*!< Set-up of the output */
+    AiUInt64 sample;                        /*!< Index of the next sample to generate */
+    AiUInt32 next_half;                     /*!< Buffer half that is refilled next. 0 for first half, 1 for second half */
+    volatile AiUInt32 events;               /*!< Number of half buffer events received */
+    AiUInt32 serviced;                      /*!< Number of half buffers refilled */
+    AiUInt32 overruns;                      /*!< Number of half buffers that were not refilled in time */
+    AiDouble integral;                      /*!< Accumulated integral of derived integral signals */
+    AiDouble integral_last;                 /*!< Last source sample of derived integral signals */
+};
+
+/*! \typedef TY_API429_GEN_OUTPUT
+ * Convenience typedef for \ref api429_gen_output
+ */
+typedef struct api429_gen_output TY_API429_GEN_OUTPUT;
+
+
+/*! \struct api429_gen_engine
+ *
+ * This structure holds a generator engine for one transmit channel.
+ * It is created with \ref api429_gen_create
+ */
+struct api429_gen_engine
+{
+    AiUInt8 board_handle;                   /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                        /*!< ID of the transmit channel */
+    AiUInt32 signal_count;                  /*!< Number of signals */
+    AiUInt32 signal_capacity;               /*!< Maximum number of signals */
+    struct api429_gen_signal* signals;      /*!< Signals with engine owned profile tables */
+    AiUInt32 output_count;                  /*!< Number of outputs */
+    AiUInt32 output_capacity;               /*!< Maximum number of outputs */
+    struct api429_gen_output* outputs;      /*!< Outputs */
+    AiUInt16 xfer_output[API429_GEN_MAX_XFER_ID + 1]; /*!< Output index + 1 for each transfer ID, 0 if transfer is not used */
+};
+
+/*! \typedef TY_API429_GEN_ENGINE
+ * Convenience typedef for \ref api429_gen_engine
+ */
+typedef struct api429_gen_engine TY_API429_GEN_ENGINE;
+
+
+
+
+/*! \brief Prepare a transfer set-up for use as generator output
+ *
+ * Sets buffer size and interrupt settings, so that the transfer raises an event
+ * each time half of the buffer was sent.
+ * @param [in,out] xfer transfer set-up that is passed to \ref Api429TxXferCreate afterwards
+ * @param [in] buf_size buffer size. Ranges from 2 to \ref API429_GEN_MAX_BUF_SIZE
+ */
+static AI_INLINE void api429_gen_xfer_prepare(struct api429_xfer* xfer, AiUInt16 buf_size)
+{
+    xfer->buf_size = buf_size;
+    xfer->ir_index = buf_size / 2;
+    xfer->xfer_ir  = 2;
+}
+
+
+/*! \brief Evaluate sine for an array of angles
+ *
+ * Uses range reduction to -pi/2 .. pi/2 and a Taylor polynomial of degree 13.
+ * Absolute error is below 1e-9 for angles up to some million radians.
+ */
+static AI_INLINE void api429_gen_sin_block(const AiDouble* x, AiDouble* y, AiUInt32 count)
+{
+    const AiDouble two_pi = 6.283185307179586476925;
+    const AiDouble pi = 3.141592653589793238463;
+    const AiDouble half_pi = 1.570796326794896619231;
+    AiDouble r, r2;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        r = x[i] - two_pi * floor(x[i] / two_pi + 0.5);
+        r = r > half_pi ? pi - r : r;
+        r = r < -half_pi ? -pi - r : r;
+        r2 = r * r;
+        y[i] = r * (1.0 + r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0
+                    + r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0)))))));
+    }
+}
+
+
+/*! \brief Get uniformly distributed pseudo random number in -1 .. 1 for a sample index
+ *
+ * Counter based (splitmix64), so every sample can be calculated independently.
+ */
+static AI_INLINE AiDouble api429_gen_noise(AiUInt32 seed, AiUInt64 index)
+{
+    AiUInt64 z = index * 0x9E3779B97F4A7C15ull + ((AiUInt64) seed << 32) + seed;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z = z ^ (z >> 31);
+
+    return (AiDouble) (z >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+
+/*! \brief Evaluate a profile for a block of equidistant samples
+ */
+static AI_INLINE void api429_gen_profile_block(const struct api429_gen_signal* signal, AiUInt64 first, AiDouble period,
+                                               AiDouble* y, AiUInt32 count)
+{
+    const AiDouble* pt = signal->point_time;
+    const AiDouble* pv = signal->point_value;
+    AiUInt32 n = signal->point_count;
+    AiDouble span = pt[n - 1] - pt[0];
+    AiDouble tt;
+    AiUInt32 k = 0;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        tt = (AiDouble) (first + i) * period;
+        if(signal->loop && span > 0.0 && tt > pt[n - 1])
+        {
+            tt = pt[0] + fmod(tt - pt[0], span);
+        }
+
+        if(tt <= pt[0])
+        {
+            y[i] = pv[0];
+            continue;
+        }
+
+        if(tt >= pt[n - 1])
+        {
+            y[i] = pv[n - 1];
+            continue;
+        }
+
+        /* Times increase within a block except at loop wrap-around */
+        if(tt < pt[k])
+        {
+            k = 0;
+        }
+
+        while(tt >= pt[k + 1])
+        {
+            k++;
+        }
+
+        y[i] = pv[k] + (pv[k + 1] - pv[k]) * (tt - pt[k]) / (pt[k + 1] - pt[k]);
+    }
+}
+
+
+/*! \brief Evaluate a signal for a block of samples of an output
+ *
+ * @param engine the generator engine
+ * @param output the output the samples are generated for. Holds the integrator state
+ * @param index index of the signal
+ * @param first index of first sample. Sample times are multiples of the output period
+ * @param y values are stored here
+ * @param count number of samples
+ */
+static AI_INLINE void api429_gen_eval(struct api429_gen_engine* engine, struct api429_gen_output* output, AiUInt32 index,
+                                      AiUInt64 first, AiDouble* y, AiUInt32 count)
+{
+    const struct api429_gen_signal* signal = &engine->signals[index];
+    AiDouble a = signal->amplitude;
+    AiDouble o = signal->offset;
+    AiDouble g = signal->gain;
+    AiDouble dt = output->setup.period;
+    AiDouble t0 = (AiDouble) first * dt;
+    AiDouble w, f, acc, last;
+    AiUInt32 i;
+
+    switch(signal->type)
+    {
+        case API429_GEN_SINE:
+            w = 6.283185307179586476925 * signal->frequency;
+            for(i = 0; i < count; i++)
+            {
+                y[i] = w * (t0 + (AiDouble) i * dt) + signal->phase;
+            }
+            api429_gen_sin_block(y, y, count);
+            for(i = 0; i < count; i++)
+            {
+                y[i] = o + a * y[i];
+            }
+            break;
+
+        case API429_GEN_TRIANGLE:
+            for(i = 0; i < count; i++)
+            {
+                f = signal->frequency * (t0 + (AiDouble) i * dt) + signal->phase;
+                f = f - floor(f);
+                y[i] = o + a * (f < 0.5 ? 4.0 * f - 1.0 : 3.0 - 4.0 * f);
+            }
+            break;
+
+        case API429_GEN_NOISE_UNIFORM:
+            for(i = 0; i < count; i++)
+            {
+                y[i] = o + a * api429_gen_noise(signal->seed, first + i);
+            }
+            break;
+
+        case API429_GEN_NOISE_GAUSS:
+            /* Sum of four uniform values has variance 4/3 */
+            for(i = 0; i < count; i++)
+            {
+                y[i] = o + a * 0.8660254037844386 * (api429_gen_noise(signal->seed, 4 * (first + i))
+                                                   + api429_gen_noise(signal->seed, 4 * (first + i) + 1)
+                                                   + api429_gen_noise(signal->seed, 4 * (first + i) + 2)
+                                                   + api429_gen_noise(signal->seed, 4 * (first + i) + 3));
+            }
+            break;
+
+        case API429_GEN_PROFILE:
+            api429_gen_profile_block(signal, first, dt, y, count);
+            break;
+
+        case API429_GEN_LINEAR:
+            api429_gen_eval(engine, output, signal->source, first, y, count);
+            for(i = 0; i < count; i++)
+            {
+                y[i] = o + g * y[i];
+            }
+            break;
+
+        case API429_GEN_INTEGRAL:
+            /* Trapezoidal integration on the sample grid of the output */
+            api429_gen_eval(engine, output, signal->source, first, y, count);
+            acc  = output->integral;
+            last = first == 0 ? y[0] : output->integral_last;
+            for(i = 0; i < count; i++)
+            {
+                acc += (last + y[i]) * 0.5 * dt;
+                last = y[i];
+                y[i] = o + g * acc;
+            }
+            output->integral      = acc;
+            output->integral_last = last;
+            break;
+
+        case API429_GEN_CONST:
+        default:
+            for(i = 0; i < count; i++)
+            {
+                y[i] = o;
+            }
+            break;
+    }
+}
+
+
+/*! \brief Release a generator engine
+ *
+ * @param engine the engine to release. May be NULL
+ */
+static AI_INLINE void api429_gen_free(struct api429_gen_engine* engine)
+{
+    AiUInt32 i;
+
+    if(!engine)
+    {
+        return;
+    }
+
+    for(i = 0; i < engine->signal_count; i++)
+    {
+        free((void*) engine->signals[i].point_time);
+        free((void*) engine->signals[i].point_value);
+    }
+
+    free(engine->signals);
+    free(engine->outputs);
+    free(engine);
+}
+
+
+/*! \brief Create a generator engine for a transmit channel
+ *
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] signal_capacity maximum number of signals
+ * @param [in] output_capacity maximum number of outputs
+ * @param [out] engine_out the created engine is stored here. Must be released with \ref api429_gen_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_gen_create(AiUInt8 board_handle, AiUInt8 channel, AiUInt32 signal_capacity, AiUInt32 output_capacity,
+                                            struct api429_gen_engine** engine_out)
+{
+    struct api429_gen_engine* engine;
+
+    if(!engine_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *engine_out = NULL;
+
+    if(signal_capacity == 0 || output_capacity == 0 || output_capacity > API429_GEN_MAX_XFER_ID)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    engine = (struct api429_gen_engine*) calloc(1, sizeof(struct api429_gen_engine));
+    if(!engine)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    engine->board_handle    = board_handle;
+    engine->channel         = channel;
+    engine->signal_capacity = signal_capacity;
+    engine->output_capacity = output_capacity;
+    engine->signals = (struct api429_gen_signal*) calloc(signal_capacity, sizeof(struct api429_gen_signal));
+    engine->outputs = (struct api429_gen_output*) calloc(output_capacity, sizeof(struct api429_gen_output));
+    if(!engine->signals || !engine->outputs)
+    {
+        api429_gen_free(engine);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *engine_out = engine;
+
+    return API_OK;
+}
+
+
+/*! \brief Check if a signal or any signal it is derived from is an integral
+ */
+static AI_INLINE AiBoolean api429_gen_chain_integral(const struct api429_gen_engine* engine, AiUInt32 index)
+{
+    const struct api429_gen_signal* signal;
+
+    /* Sources always have a lower index, so the chain ends */
+    for(;;)
+    {
+        signal = &engine->signals[index];
+
+        if(signal->type == API429_GEN_INTEGRAL)
+        {
+            return AiTrue;
+        }
+
+        if(signal->type != API429_GEN_LINEAR)
+        {
+            return AiFalse;
+        }
+
+        index = signal->source;
+    }
+}
+
+
+/*! \brief Add a signal to a generator engine
+ *
+ * @param [in] engine the generator engine
+ * @param [in] signal description of the signal. Profile tables are copied
+ * @param [out] index index of the new signal is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_gen_signal_add(struct api429_gen_engine* engine, const struct api429_gen_signal* signal, AiUInt32* index)
+{
+    struct api429_gen_signal* copy;
+    AiDouble* point_time = NULL;
+    AiDouble* point_value = NULL;
+    AiUInt32 i;
+
+    if(!engine || !signal)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(engine->signal_count >= engine->signal_capacity)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    if((signal->type == API429_GEN_LINEAR || signal->type == API429_GEN_INTEGRAL) && signal->source >= engine->signal_count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    if(signal->type == API429_GEN_INTEGRAL && api429_gen_chain_integral(engine, signal->source))
+    {
+        /* Integrator state is kept once per output */
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    if(signal->type == API429_GEN_PROFILE)
+    {
+        if(!signal->point_time || !signal->point_value)
+        {
+            return AI429_ERR_NULL_POINTER;
+        }
+
+        if(signal->point_count == 0)
+        {
+            return AI429_ERR_PARAMETER_RANGE;
+        }
+
+        for(i = 1; i < signal->point_count; i++)
+        {
+            if(signal->point_time[i] <= signal->point_time[i - 1])
+            {
+                return AI429_ERR_PARAMETER_RANGE;
+            }
+        }
+
+        point_time  = (AiDouble*) malloc(signal->point_count * sizeof(AiDouble));
+        point_value = (AiDouble*) malloc(signal->point_count * sizeof(AiDouble));
+        if(!point_time || !point_value)
+        {
+            free(point_time);
+            free(point_value);
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+
+        memcpy(point_time, signal->point_time, signal->point_count * sizeof(AiDouble));
+        memcpy(point_value, signal->point_value, signal->point_count * sizeof(AiDouble));
+    }
+
+    copy = &engine->signals[engine->signal_count];
+    *copy = *signal;
+    copy->point_time  = point_time;
+    copy->point_value = point_value;
+
+    if(index)
+    {
+        *index = engine->signal_count;
+    }
+
+    engine->signal_count++;
+
+    return API_OK;
+}
+
+
+/*! \brief Add an output to a generator engine
+ *
+ * @param [in] engine the generator engine
+ * @param [in] setup description of the output
+ * @param [out] index index of the new output is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_gen_output_add(struct api429_gen_engine* engine, const struct api429_gen_output_setup* setup, AiUInt32* index)
+{
+    struct api429_gen_output* output;
+
+    if(!engine || !setup)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(engine->output_count >= engine->output_capacity)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    if(setup->xfer_id == 0 || setup->xfer_id > API429_GEN_MAX_XFER_ID || engine->xfer_output[setup->xfer_id])
+    {
+        return AI429_ERR_XFER_ID;
+    }
+
+    if(setup->buf_size < 2 || setup->buf_size > API429_GEN_MAX_BUF_SIZE || setup->signal >= engine->signal_count
+       || setup->period <= 0.0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    output = &engine->outputs[engine->output_count];
+    memset(output, 0, sizeof(*output));
+    output->setup = *setup;
+
+    engine->output_count++;
+    engine->xfer_output[setup->xfer_id] = (AiUInt16) engine->output_count;
+
+    if(index)
+    {
+        *index = engine->output_count - 1;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Generate samples and write them to a range of a transfer buffer
+ */
+static AI_INLINE AiReturn api429_gen_output_write(struct api429_gen_engine* engine, struct api429_gen_output* output,
+                                                  AiUInt16 buf_start, AiUInt16 count)
+{
+    const struct api429_gen_output_setup* setup = &output->setup;
+    AiDouble y[API429_GEN_MAX_BUF_SIZE];
+    AiUInt32 words[API429_GEN_MAX_BUF_SIZE];
+    AiUInt32 i;
+
+    api429_gen_eval(engine, output, setup->signal, output->sample, y, count);
+
+    for(i = 0; i < count; i++)
+    {
+        words[i] = api429_codec_encode(&setup->format, setup->label, setup->sdi, setup->status, y[i]);
+    }
+
+    output->sample += count;
+
+    return Api429TxXferBufferWrite(engine->board_handle, engine->channel, setup->xfer_id, buf_start, count, words);
+}
+
+
+/*! \brief Advance an output by samples that are not sent
+ *
+ * Integrals are evaluated over the skipped samples, so they continue with the correct value.
+ */
+static AI_INLINE AiReturn api429_gen_output_skip(struct api429_gen_engine* engine, struct api429_gen_output* output, AiUInt64 count)
+{
+    AiDouble y[API429_GEN_MAX_BUF_SIZE];
+    AiUInt32 block;
+
+    if(!api429_gen_chain_integral(engine, output->setup.signal))
+    {
+        output->sample += count;
+        return API_OK;
+    }
+
+    while(count)
+    {
+        block = count < API429_GEN_MAX_BUF_SIZE ? (AiUInt32) count : API429_GEN_MAX_BUF_SIZE;
+
+        api429_gen_eval(engine, output, output->setup.signal, output->sample, y, block);
+
+        output->sample += block;
+        count          -= block;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Fill the complete buffers of all outputs
+ *
+ * Must be called before the channel is started. Restarts all signals at time 0.
+ * @param [in] engine the generator engine
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_gen_prefill(struct api429_gen_engine* engine)
+{
+    struct api429_gen_output* output;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!engine)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < engine->output_count; i++)
+    {
+        output = &engine->outputs[i];
+        output->sample        = 0;
+        output->next_half     = 0;
+        ai_atomic_u32_store(&output->events, 0);
+        output->serviced      = 0;
+        output->overruns      = 0;
+        output->integral      = 0.0;
+        output->integral_last = 0.0;
+
+        ret = api429_gen_output_write(engine, output, 1, output->setup.buf_size);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Process a channel event
+ *
+ * Must be called from the event handler of the channel for each event.
+ * Only records the event, the buffer is refilled by \ref api429_gen_service.
+ * @param [in] engine the generator engine
+ * @param [in] type type of the event
+ * @param [in] info additional event information as passed to the event handler
+ * @return AiTrue if the event belongs to one of the outputs, AiFalse otherwise
+ */
+static AI_INLINE AiBoolean api429_gen_event(struct api429_gen_engine* engine, enum api429_event_type type,
+                                            const struct api429_intr_loglist_entry* info)
+{
+    AiUInt32 xfer_id;
+    AiUInt32 slot;
+
+    if(!engine || !info || type != API429_EVENT_TX_INDEX)
+    {
+        return AiFalse;
+    }
+
+    xfer_id = info->x_Llc.t.ul_Info;
+    if(xfer_id > API429_GEN_MAX_XFER_ID)
+    {
+        return AiFalse;
+    }
+
+    slot = engine->xfer_output[xfer_id];
+    if(!slot)
+    {
+        return AiFalse;
+    }
+
+    ai_atomic_u32_fetch_add(&engine->outputs[slot - 1].events, 1);
+
+    return AiTrue;
+}
+
+
+/*! \brief Refill all buffer halves that have been sent
+ *
+ * Can be called from the event handler directly after \ref api429_gen_event
+ * or cyclically from an application thread. If more than one half of a buffer was sent
+ * since the last refill, the output has an overrun and data is repeated on the bus. The signals
+ * skip the time of the repeated halves, so they stay in step with the bus.
+ * @param [in] engine the generator engine
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_gen_service(struct api429_gen_engine* engine)
+{
+    struct api429_gen_output* output;
+    AiUInt16 half;
+    AiUInt32 pending;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!engine)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < engine->output_count; i++)
+    {
+        output  = &engine->outputs[i];
+        pending = ai_atomic_u32_load(&output->events) - output->serviced;
+
+        if(pending == 0)
+        {
+            continue;
+        }
+
+        half = output->setup.buf_size / 2;
+
+        if(pending > 1)
+        {
+            /* Sent halves were repeated on the bus. Skip them to stay in phase with the buffer and with time */
+            output->overruns += pending - 1;
+
+            ret = api429_gen_output_skip(engine, output, (AiUInt64) ((pending - 1) / 2) * output->setup.buf_size
+                                         + ((pending - 1) & 1 ? (output->next_half ? output->setup.buf_size - half : half) : 0));
+            if(ret != API_OK)
+            {
+                return ret;
+            }
+
+            if((pending - 1) & 1)
+            {
+                output->next_half ^= 1;
+            }
+        }
+
+        if(output->next_half == 0)
+        {
+            ret = api429_gen_output_write(engine, output, 1, half);
+        }
+        else
+        {
+            ret = api429_gen_output_write(engine, output, (AiUInt16) (half + 1), (AiUInt16) (output->setup.buf_size - half));
+        }
+
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        output->next_half ^= 1;
+        output->serviced  += pending;
+    }
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429GENERATOR_H_ */
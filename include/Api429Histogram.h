@@ -0,0 +1,217 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Histogram.h
+ *
+ *  This header file contains inline helper functions
+ *  for collecting time distributions
+ */
+
+#ifndef API429HISTOGRAM_H_
+#define API429HISTOGRAM_H_
+
+
+#include <string.h>
+
+#include "Api429.h"
+
+
+/**
+* \defgroup histogram Time Histograms
+  This module provides a fixed size histogram for latencies and intervals in microseconds. \n
+  Bucket 0 holds values below 1us, bucket n holds values from 2^(n-1) up to 2^n - 1 microseconds.
+  Adding a value takes constant time, so histograms can be updated from event handlers.
+* @{
+*/
+
+
+
+/*! \def API429_HISTOGRAM_BUCKETS
+ * Number of buckets of a histogram. The last bucket holds all values above 2^30 microseconds
+ */
+#define API429_HISTOGRAM_BUCKETS    32
+
+
+
+/*! \struct api429_histogram
+ *
+ * This structure holds a time histogram
+ */
+struct api429_histogram
+{
+    AiUInt64 count;                                 /*!< Number of values */
+    AiInt64 min;                                    /*!< Smallest value in microseconds */
+    AiInt64 max;                                    /*!< Largest value in microseconds */
+    AiInt64 sum;                                    /*!< Sum of all values in microseconds */
+    AiUInt64 negative;                              /*!< Number of negative values. They are counted in bucket 0 */
+    AiUInt64 bucket[API429_HISTOGRAM_BUCKETS];      /*!< Number of values in each bucket */
+};
+
+/*! \typedef TY_API429_HISTOGRAM
+ * Convenience typedef for \ref api429_histogram
+ */
+typedef struct api429_histogram TY_API429_HISTOGRAM;
+
+
+
+
+/*! \brief Clear a histogram
+ *
+ * @param [out] histogram the histogram to clear
+ */
+static AI_INLINE void api429_histogram_init(struct api429_histogram* histogram)
+{
+    memset(histogram, 0, sizeof(*histogram));
+}
+
+
+/*! \brief Get bucket of a value
+ *
+ * @param value value in microseconds
+ * @return index of the bucket the value is counted in
+ */
+static AI_INLINE AiUInt32 api429_histogram_bucket(AiInt64 value)
+{
+    AiUInt64 v;
+    AiUInt32 n = 0;
+
+    if(value <= 0)
+    {
+        return 0;
+    }
+
+    v = (AiUInt64) value;
+    while(v && n < API429_HISTOGRAM_BUCKETS - 1)
+    {
+        v >>= 1;
+        n++;
+    }
+
+    return n;
+}
+
+
+/*! \brief Add a value to a histogram
+ *
+ * @param [in,out] histogram the histogram
+ * @param [in] value value in microseconds
+ */
+static AI_INLINE void api429_histogram_add(struct api429_histogram* histogram, AiInt64 value)
+{
+    if(histogram->count == 0 || value < histogram->min)
+    {
+        histogram->min = value;
+    }
+
+    if(histogram->count == 0 || value > histogram->max)
+    {
+        histogram->max = value;
+    }
+
+    if(value < 0)
+    {
+        histogram->negative++;
+    }
+
+    histogram->count++;
+    histogram->sum += value;
+    histogram->bucket[api429_histogram_bucket(value)]++;
+}
+
+
+/*! \brief Add all values of a histogram to another one
+ *
+ * @param [in,out] histogram the histogram to add to
+ * @param [in] other the histogram to add
+ */
+static AI_INLINE void api429_histogram_merge(struct api429_histogram* histogram, const struct api429_histogram* other)
+{
+    AiUInt32 i;
+
+    if(other->count == 0)
+    {
+        return;
+    }
+
+    if(histogram->count == 0 || other->min < histogram->min)
+    {
+        histogram->min = other->min;
+    }
+
+    if(histogram->count == 0 || other->max > histogram->max)
+    {
+        histogram->max = other->max;
+    }
+
+    histogram->count    += other->count;
+    histogram->sum      += other->sum;
+    histogram->negative += other->negative;
+
+    for(i = 0; i < API429_HISTOGRAM_BUCKETS; i++)
+    {
+        histogram->bucket[i] += other->bucket[i];
+    }
+}
+
+
+/*! \brief Get mean value of a histogram
+ *
+ * @param [in] histogram the histogram
+ * @return mean value in microseconds, 0 if the histogram is empty
+ */
+static AI_INLINE AiDouble api429_histogram_mean(const struct api429_histogram* histogram)
+{
+    return histogram->count ? (AiDouble) histogram->sum / (AiDouble) histogram->count : 0.0;
+}
+
+
+/*! \brief Get an upper bound of a percentile of a histogram
+ *
+ * @param [in] histogram the histogram
+ * @param [in] percent the percentile to get, e.g. 99.0
+ * @return upper limit of the bucket that contains the percentile in microseconds, limited to the maximum value.
+ *         0 if the histogram is empty
+ */
+static AI_INLINE AiInt64 api429_histogram_percentile(const struct api429_histogram* histogram, AiDouble percent)
+{
+    AiUInt64 target;
+    AiUInt64 seen = 0;
+    AiInt64 limit;
+    AiUInt32 i;
+
+    if(histogram->count == 0)
+    {
+        return 0;
+    }
+
+    target = (AiUInt64) ((AiDouble) histogram->count * percent / 100.0);
+    target = target < 1 ? 1 : target;
+
+    for(i = 0; i < API429_HISTOGRAM_BUCKETS; i++)
+    {
+        seen += histogram->bucket[i];
+        if(seen >= target)
+        {
+            break;
+        }
+    }
+
+    limit = i == 0 ? 0 : (((AiInt64) 1) << i) - 1;
+
+    return limit < histogram->max ? limit : histogram->max;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429HISTOGRAM_H_ */
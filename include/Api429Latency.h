@@ -0,0 +1,502 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Latency.h
+ *
+ *  This header file contains inline helper functions
+ *  for measuring transmit and receive latencies with time tags
+ */
+
+#ifndef API429LATENCY_H_
+#define API429LATENCY_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+#include "Api429Timing.h"
+#include "Api429Histogram.h"
+#include "Ai_clock.h"
+
+
+/**
+* \defgroup latency Latency Measurement
+  This module measures per-transfer latencies on a framing based transmit channel
+  that is looped back to a receive channel with monitoring enabled. \n
+  The transfers must be created with type \ref API429_TX_LAB_XFER_TT or \ref API429_TX_LAB_XFER_TT_32.
+  Their time tags have the same layout as monitor entries: the low word is an \ref api429_tm_tag,
+  the high word is an \ref api429_brw holding the hours and the update flag. \n
+  Three distributions are collected for each transfer:
+  - host to wire: from \ref api429_latency_submit, called right before new data is written,
+    to the first transmission of that data
+  - wire to wire: from transmission to reception of the same data word in the monitor
+  - wire to host: from reception to the point of time the monitor entry was read by the host
+  Board time is related to the host clock by \ref api429_latency_clock_sync. As the IRIG time
+  of the board is read with millisecond resolution, the host related distributions have an offset
+  error of up to one millisecond. The synchronization should be repeated periodically to compensate drift.
+* @{
+*/
+
+
+
+/*! \def API429_LATENCY_TX_HISTORY
+ * Number of transmitted data words per transfer that are kept for correlation with monitor entries
+ */
+#define API429_LATENCY_TX_HISTORY   8
+
+/*! \def API429_LATENCY_RM_BLOCK
+ * Number of monitor entries that are read at once
+ */
+#define API429_LATENCY_RM_BLOCK     256
+
+
+
+/*! \struct api429_latency_label
+ *
+ * This structure holds the measurement state of one transfer
+ */
+struct api429_latency_label
+{
+    AiUInt32 xfer_id;                                   /*!< ID of the transfer */
+    AiUInt32 period_us;                                 /*!< Transmission period of the transfer in microseconds. 0 if unknown */
+    AiUInt16 buf_size;                                  /*!< Buffer size of the transfer */
+    AiBoolean pending;                                  /*!< AiTrue if submitted data was not seen on the wire yet */
+    AiUInt32 pending_word;                              /*!< Submitted data word */
+    AiUInt64 pending_host_us;                           /*!< Host time of submission */
+    AiUInt32 tx_word[API429_LATENCY_TX_HISTORY];        /*!< Recently transmitted data words */
+    AiInt64 tx_us[API429_LATENCY_TX_HISTORY];           /*!< Transmission times in microseconds of day */
+    AiUInt32 tx_next;                                   /*!< Next entry of the transmit history to use */
+    struct api429_histogram host_to_wire;               /*!< Latency from submission to first transmission */
+    struct api429_histogram wire_to_wire;               /*!< Latency from transmission to reception */
+    struct api429_histogram wire_to_host;               /*!< Latency from reception to reading by the host */
+};
+
+/*! \typedef TY_API429_LATENCY_LABEL
+ * Convenience typedef for \ref api429_latency_label
+ */
+typedef struct api429_latency_label TY_API429_LATENCY_LABEL;
+
+
+/*! \struct api429_latency
+ *
+ * This structure holds a latency harvester for one transmit channel.
+ * It is created with \ref api429_latency_create
+ */
+struct api429_latency
+{
+    AiUInt8 board_handle;                       /*!< Handle to the board */
+    AiUInt8 tx_channel;                         /*!< ID of the transmit channel */
+    AiInt64 window_us;                          /*!< Maximum time between transmission and reception of a looped back word */
+    AiInt64 sync_board_us;                      /*!< Board time of last clock synchronization in microseconds of day */
+    AiUInt64 sync_host_us;                      /*!< Host time of last clock synchronization */
+    AiUInt64 sync_uncertainty_us;               /*!< Half round trip time of the last clock synchronization */
+    AiUInt64 unmatched;                         /*!< Number of monitor entries that could not be related to a transmission */
+    AiUInt32 label_count;                       /*!< Number of transfers */
+    AiUInt32 label_capacity;                    /*!< Maximum number of transfers */
+    struct api429_latency_label* labels;        /*!< Measurement state of all transfers */
+    struct api429_xfer_data* scratch;           /*!< Buffer for reading transfer buffers */
+    struct api429_rcv_stack_entry* rm_scratch;  /*!< Buffer for reading monitor entries */
+};
+
+/*! \typedef TY_API429_LATENCY
+ * Convenience typedef for \ref api429_latency
+ */
+typedef struct api429_latency TY_API429_LATENCY;
+
+
+
+
+/*! \brief Convert host time to board time of day
+ */
+static AI_INLINE AiInt64 api429_latency_host_to_board(const struct api429_latency* latency, AiUInt64 host_us)
+{
+    return latency->sync_board_us + (AiInt64) (host_us - latency->sync_host_us);
+}
+
+
+/*! \brief Release a latency harvester
+ *
+ * @param latency the harvester to release. May be NULL
+ */
+static AI_INLINE void api429_latency_free(struct api429_latency* latency)
+{
+    if(!latency)
+    {
+        return;
+    }
+
+    free(latency->labels);
+    free(latency->scratch);
+    free(latency->rm_scratch);
+    free(latency);
+}
+
+
+/*! \brief Relate board time to host time
+ *
+ * Reads the board time several times and keeps the sample with the shortest round trip.
+ * @param [in] latency the latency harvester
+ * @param [in] samples number of board time reads
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_latency_clock_sync(struct api429_latency* latency, AiUInt32 samples)
+{
+    struct api429_time board_time;
+    AiUInt64 before, after;
+    AiUInt64 best = (AiUInt64) -1;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!latency)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < (samples ? samples : 1); i++)
+    {
+        before = ai_clock_us();
+        ret = Api429BoardTimeGet(latency->board_handle, &board_time);
+        after = ai_clock_us();
+
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        if(after - before < best)
+        {
+            best = after - before;
+
+            /* Board time is truncated to milliseconds, assume middle of the millisecond */
+            latency->sync_board_us       = api429_timing_time_us(&board_time) + 500;
+            latency->sync_host_us        = before + best / 2;
+            latency->sync_uncertainty_us = best / 2 + 500;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Create a latency harvester
+ *
+ * The board clock is synchronized on creation.
+ * @param [in] board_handle handle to the board
+ * @param [in] tx_channel ID of the transmit channel
+ * @param [in] label_capacity maximum number of transfers to measure
+ * @param [in] window_us maximum time between transmission and reception of a looped back word in microseconds
+ * @param [out] latency_out the created harvester is stored here. Must be released with \ref api429_latency_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_latency_create(AiUInt8 board_handle, AiUInt8 tx_channel, AiUInt32 label_capacity, AiUInt32 window_us,
+                                                struct api429_latency** latency_out)
+{
+    struct api429_latency* latency;
+    AiReturn ret;
+
+    if(!latency_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *latency_out = NULL;
+
+    if(label_capacity == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    latency = (struct api429_latency*) calloc(1, sizeof(struct api429_latency));
+    if(!latency)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    latency->board_handle   = board_handle;
+    latency->tx_channel     = tx_channel;
+    latency->window_us      = window_us;
+    latency->label_capacity = label_capacity;
+    latency->labels     = (struct api429_latency_label*) calloc(label_capacity, sizeof(struct api429_latency_label));
+    latency->scratch    = (struct api429_xfer_data*) calloc(1023, sizeof(struct api429_xfer_data));
+    latency->rm_scratch = (struct api429_rcv_stack_entry*) calloc(API429_LATENCY_RM_BLOCK, sizeof(struct api429_rcv_stack_entry));
+    if(!latency->labels || !latency->scratch || !latency->rm_scratch)
+    {
+        api429_latency_free(latency);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    ret = api429_latency_clock_sync(latency, 8);
+    if(ret != API_OK)
+    {
+        api429_latency_free(latency);
+        return ret;
+    }
+
+    *latency_out = latency;
+
+    return API_OK;
+}
+
+
+/*! \brief Add a transfer to measure
+ *
+ * @param [in] latency the latency harvester
+ * @param [in] xfer_id ID of the transfer. Must be created with time tag
+ * @param [in] period_us transmission period of the transfer in microseconds. Used to find the first transmission of
+ *             submitted data, if it was sent several times before being harvested. 0 if unknown
+ * @param [out] index index of the transfer in the harvester is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_latency_label_add(struct api429_latency* latency, AiUInt32 xfer_id, AiUInt32 period_us, AiUInt32* index)
+{
+    struct api429_latency_label* label;
+    AiUInt32 offset;
+    AiUInt16 size;
+    AiReturn ret;
+
+    if(!latency)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(latency->label_count >= latency->label_capacity)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    ret = Api429TxXferBufferOffsetGet(latency->board_handle, latency->tx_channel, xfer_id, &offset, &size);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    label = &latency->labels[latency->label_count];
+    memset(label, 0, sizeof(*label));
+    label->xfer_id   = xfer_id;
+    label->period_us = period_us;
+    label->buf_size  = size ? size : 1;
+    api429_histogram_init(&label->host_to_wire);
+    api429_histogram_init(&label->wire_to_wire);
+    api429_histogram_init(&label->wire_to_host);
+
+    if(index)
+    {
+        *index = latency->label_count;
+    }
+
+    latency->label_count++;
+
+    return API_OK;
+}
+
+
+/*! \brief Record submission of new data for a transfer
+ *
+ * Must be called right before the data word is written to the transfer buffer.
+ * The data word must differ from the previous content of the buffer.
+ * @param [in] latency the latency harvester
+ * @param [in] index index of the transfer in the harvester
+ * @param [in] data data word that is written
+ */
+static AI_INLINE void api429_latency_submit(struct api429_latency* latency, AiUInt32 index, AiUInt32 data)
+{
+    struct api429_latency_label* label = &latency->labels[index];
+
+    label->pending_word    = data;
+    label->pending_host_us = ai_clock_us();
+    label->pending         = AiTrue;
+}
+
+
+/*! \brief Read transmit time tags of all transfers
+ *
+ * Reads the complete buffer of each transfer and clears the update flags. Entries that have been sent
+ * since the last call are recorded for correlation with monitor entries, and completed submissions
+ * are added to the host to wire distribution.
+ * @param [in] latency the latency harvester
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_latency_harvest(struct api429_latency* latency)
+{
+    struct api429_xfer_data_read_input read_input;
+    struct api429_latency_label* label;
+    union api429_tm_tag tm_tag;
+    union api429_brw brw;
+    AiInt64 tx_us, submit_us, elapsed, repeat_us;
+    AiReturn ret;
+    AiUInt32 i, k;
+
+    if(!latency)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < latency->label_count; i++)
+    {
+        label = &latency->labels[i];
+
+        read_input.ul_XferId   = label->xfer_id;
+        read_input.ul_BufStart = 1;
+        read_input.ul_BufSize  = label->buf_size;
+        read_input.ul_Mode     = API_TXRXBUF_TT_UPDATE_CLEAR;
+
+        ret = Api429TxXferBufferRead(latency->board_handle, latency->tx_channel, &read_input, latency->scratch);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        for(k = 0; k < label->buf_size; k++)
+        {
+            brw.all    = latency->scratch[k].ul_XferTTHigh;
+            tm_tag.all = latency->scratch[k].ul_XferTTLow;
+
+            if(!brw.b.udf)
+            {
+                continue;
+            }
+
+            tx_us = api429_timing_tm_tag_us(tm_tag, brw);
+
+            label->tx_word[label->tx_next] = latency->scratch[k].ul_XferData;
+            label->tx_us[label->tx_next]   = tx_us;
+            label->tx_next = (label->tx_next + 1) % API429_LATENCY_TX_HISTORY;
+
+            if(label->pending && latency->scratch[k].ul_XferData == label->pending_word)
+            {
+                submit_us = api429_latency_host_to_board(latency, label->pending_host_us);
+                elapsed   = api429_timing_diff_us(tx_us, submit_us);
+
+                /* Time tag shows the last transmission, step back to the first one after submission */
+                repeat_us = (AiInt64) label->period_us * label->buf_size;
+                if(repeat_us > 0 && elapsed > 0)
+                {
+                    elapsed %= repeat_us;
+                }
+
+                api429_histogram_add(&label->host_to_wire, elapsed);
+                label->pending = AiFalse;
+            }
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Relate monitor entries to transmitted words
+ *
+ * @param [in] latency the latency harvester
+ * @param [in] entries monitor entries of the receive channel the transmit channel is looped back to
+ * @param [in] count number of entries
+ * @param [in] host_read_us host time the entries were read at, as returned by \ref ai_clock_us
+ */
+static AI_INLINE void api429_latency_rm_process(struct api429_latency* latency, const struct api429_rcv_stack_entry* entries,
+                                                AiUInt32 count, AiUInt64 host_read_us)
+{
+    struct api429_latency_label* label;
+    AiInt64 read_us = api429_latency_host_to_board(latency, host_read_us);
+    AiInt64 rx_us, transit;
+    AiUInt32 word, reversed;
+    AiBoolean found;
+    AiUInt32 i, l, h;
+
+    for(i = 0; i < count; i++)
+    {
+        /* Accept both label bit orders for the received word */
+        word     = entries[i].ldata;
+        reversed = (word & ~API429_WORD_LABEL_MASK) | api429_codec_label_reverse((AiUInt8) (word & API429_WORD_LABEL_MASK));
+        rx_us    = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+        found    = AiFalse;
+
+        for(l = 0; l < latency->label_count && !found; l++)
+        {
+            label = &latency->labels[l];
+
+            for(h = 0; h < API429_LATENCY_TX_HISTORY; h++)
+            {
+                if(label->tx_word[h] != word && label->tx_word[h] != reversed)
+                {
+                    continue;
+                }
+
+                transit = api429_timing_diff_us(rx_us, label->tx_us[h]);
+                if(transit < 0 || transit > latency->window_us)
+                {
+                    continue;
+                }
+
+                api429_histogram_add(&label->wire_to_wire, transit);
+                api429_histogram_add(&label->wire_to_host, api429_timing_diff_us(read_us, rx_us));
+                found = AiTrue;
+                break;
+            }
+        }
+
+        if(!found)
+        {
+            latency->unmatched++;
+        }
+    }
+}
+
+
+/*! \brief Read and process all available monitor entries of a receive channel
+ *
+ * Transmit time tags must have been harvested with \ref api429_latency_harvest before,
+ * as monitor entries can only be related to known transmissions.
+ * @param [in] latency the latency harvester
+ * @param [in] rm_channel ID of the monitored receive channel the transmit channel is looped back to
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_latency_rm_poll(struct api429_latency* latency, AiUInt8 rm_channel)
+{
+    AiUInt16 count;
+    AiReturn ret;
+
+    if(!latency)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    do
+    {
+        ret = Api429RmDataRead(latency->board_handle, rm_channel, API429_LATENCY_RM_BLOCK, &count, latency->rm_scratch);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        api429_latency_rm_process(latency, latency->rm_scratch, count, ai_clock_us());
+    }
+    while(count == API429_LATENCY_RM_BLOCK);
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429LATENCY_H_ */
@@ -0,0 +1,677 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429RatePlan.h
+ *
+ *  This header file contains inline helper functions
+ *  for planning and verifying rate controlled transmit channels
+ */
+
+#ifndef API429RATEPLAN_H_
+#define API429RATEPLAN_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+#include "Api429Timing.h"
+#include "Api429Framing.h"
+
+
+/**
+* \defgroup rate_plan Rate Controlled Mode Planner
+  This module helps setting up channels initialized with \ref API429_TX_MODE_RATE_CONTROLLED. \n
+  The rates passed to \ref Api429TxXferRateAdd may be rounded when the framing is generated, which
+  is only visible afterwards with \ref Api429TxXferRateShow. The planner works in four steps:
+  - \ref api429_rate_plan_predict calculates the framing offline with \ref api429_framing_compile,
+    i.e. minor frame time, major frame length, bus load and the expected jitter of each transfer.
+  - \ref api429_rate_plan_suggest proposes rates close to the requested ones that divide evenly,
+    so the framing stays small and no rounding is necessary.
+  - \ref api429_rate_plan_apply adds the rates to the channel, prepares the framing with \ref Api429TxPrepareFraming
+    and reads back the realized rates.
+  - \ref api429_rate_plan_rm_poll measures the actual transmission periods from a monitor channel in loopback,
+    and \ref api429_rate_plan_evaluate flags all transfers that deviate beyond a tolerance.
+* @{
+*/
+
+
+
+/*! \def API429_RATE_PLAN_RM_BLOCK
+ * Number of monitor entries read at once by \ref api429_rate_plan_rm_poll
+ */
+#define API429_RATE_PLAN_RM_BLOCK       256
+
+/*! \def API429_RATE_PLAN_SDI_ANY
+ * Value for 'sdi' of \ref api429_rate_label that matches data words with any SDI
+ */
+#define API429_RATE_PLAN_SDI_ANY        0xFF
+
+
+/*! \def API429_RATE_FLAG_ROUNDED
+ * The rate shown by \ref Api429TxXferRateShow differs from the applied rate
+ */
+#define API429_RATE_FLAG_ROUNDED        (1 << 0)
+
+/*! \def API429_RATE_FLAG_DEVIATION
+ * The mean measured period deviates from the applied rate beyond tolerance
+ */
+#define API429_RATE_FLAG_DEVIATION      (1 << 1)
+
+/*! \def API429_RATE_FLAG_JITTER
+ * A single measured period deviates from the applied rate beyond tolerance and predicted jitter
+ */
+#define API429_RATE_FLAG_JITTER         (1 << 2)
+
+/*! \def API429_RATE_FLAG_NO_DATA
+ * Not enough data words were received for measuring the period
+ */
+#define API429_RATE_FLAG_NO_DATA        (1 << 3)
+
+
+
+/*! \struct api429_rate_label
+ *
+ * This structure describes one transfer of a rate controlled channel
+ * and holds its planned and measured transmission periods
+ */
+struct api429_rate_label
+{
+    struct api429_xfer xfer;    /*!< Transfer set-up as used for \ref Api429TxXferCreate */
+    AiUInt8 label;              /*!< Label number sent by the transfer. Used for identifying it on the monitor */
+    AiUInt8 sdi;                /*!< SDI sent by the transfer, or \ref API429_RATE_PLAN_SDI_ANY */
+    AiUInt32 rate_ms;           /*!< Requested transmission period in milliseconds */
+    AiUInt32 suggested_ms;      /*!< Period proposed by \ref api429_rate_plan_suggest. 0 if none */
+    AiUInt32 applied_ms;        /*!< Period passed to \ref Api429TxXferRateAdd */
+    AiUInt32 jitter_us;         /*!< Predicted worst case deviation of the transmission period in microseconds. 0 if not predicted */
+    AiUInt32 realized_ms;       /*!< Period shown by \ref Api429TxXferRateShow */
+    AiUInt32 measured_count;    /*!< Number of measured periods */
+    AiInt64 measured_sum_us;    /*!< Sum of all measured periods in microseconds */
+    AiInt64 measured_min_us;    /*!< Shortest measured period in microseconds */
+    AiInt64 measured_max_us;    /*!< Longest measured period in microseconds */
+    AiInt64 last_rx_us;         /*!< Time tag of the last received data word in microseconds of day. -1 if none */
+    AiUInt32 flags;             /*!< Result of the evaluation. See \ref API429_RATE_FLAG_ROUNDED etc. */
+};
+
+/*! \typedef TY_API429_RATE_LABEL
+ * Convenience typedef for \ref api429_rate_label
+ */
+typedef struct api429_rate_label TY_API429_RATE_LABEL;
+
+
+/*! \struct api429_rate_plan
+ *
+ * This structure holds the plan of one rate controlled transmit channel.
+ * It is created with \ref api429_rate_plan_create
+ */
+struct api429_rate_plan
+{
+    AiUInt8 board_handle;                           /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                                /*!< ID of the transmit channel */
+    enum api429_speed speed;                        /*!< Speed of the channel */
+    AiUInt32 label_count;                           /*!< Number of transfers */
+    struct api429_rate_label* labels;               /*!< All transfers of the channel */
+    AiUInt32 minor_frame_time;                      /*!< Predicted minor frame time in milliseconds */
+    AiUInt32 major_frame_count;                     /*!< Predicted number of minor frames in the major frame */
+    AiDouble utilization;                           /*!< Predicted average bus utilization (0.0 .. 1.0) */
+    AiDouble peak_utilization;                      /*!< Predicted utilization of the busiest minor frame. Values above 1.0 mean overload */
+    AiUInt32 max_jitter_us;                         /*!< Predicted worst case jitter of all transfers in microseconds */
+    struct api429_rcv_stack_entry* rm_scratch;      /*!< Buffer for reading monitor entries */
+};
+
+/*! \typedef TY_API429_RATE_PLAN
+ * Convenience typedef for \ref api429_rate_plan
+ */
+typedef struct api429_rate_plan TY_API429_RATE_PLAN;
+
+
+
+
+/*! \brief Release a rate plan
+ *
+ * @param plan plan to release. May be NULL
+ */
+static AI_INLINE void api429_rate_plan_free(struct api429_rate_plan* plan)
+{
+    if(!plan)
+    {
+        return;
+    }
+
+    free(plan->labels);
+    free(plan->rm_scratch);
+    free(plan);
+}
+
+
+/*! \brief Create a rate plan
+ *
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] speed speed of the channel
+ * @param [in] labels transfers with requested rates. Only 'xfer', 'label', 'sdi' and 'rate_ms' are used. Will be copied
+ * @param [in] label_count number of transfers
+ * @param [out] plan_out the created plan is stored here. Must be released with \ref api429_rate_plan_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_rate_plan_create(AiUInt8 board_handle, AiUInt8 channel, enum api429_speed speed,
+                                                  const struct api429_rate_label* labels, AiUInt32 label_count,
+                                                  struct api429_rate_plan** plan_out)
+{
+    struct api429_rate_plan* plan;
+    AiUInt32 i;
+
+    if(!labels || !plan_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *plan_out = NULL;
+
+    if(label_count == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    for(i = 0; i < label_count; i++)
+    {
+        if(labels[i].rate_ms == 0)
+        {
+            return AI429_ERR_INVALID_RATE;
+        }
+    }
+
+    plan = (struct api429_rate_plan*) calloc(1, sizeof(struct api429_rate_plan));
+    if(!plan)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    plan->labels     = (struct api429_rate_label*) calloc(label_count, sizeof(struct api429_rate_label));
+    plan->rm_scratch = (struct api429_rcv_stack_entry*) calloc(API429_RATE_PLAN_RM_BLOCK, sizeof(struct api429_rcv_stack_entry));
+    if(!plan->labels || !plan->rm_scratch)
+    {
+        api429_rate_plan_free(plan);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    plan->board_handle = board_handle;
+    plan->channel      = channel;
+    plan->speed        = speed;
+    plan->label_count  = label_count;
+
+    for(i = 0; i < label_count; i++)
+    {
+        plan->labels[i].xfer       = labels[i].xfer;
+        plan->labels[i].label      = labels[i].label;
+        plan->labels[i].sdi        = labels[i].sdi;
+        plan->labels[i].rate_ms    = labels[i].rate_ms;
+        plan->labels[i].applied_ms = labels[i].rate_ms;
+        plan->labels[i].last_rx_us = -1;
+    }
+
+    *plan_out = plan;
+
+    return API_OK;
+}
+
+
+/*! \brief Predict the framing of a rate controlled channel
+ *
+ * Calculates the framing for the applied rates, which are the requested rates unless \ref api429_rate_plan_suggest was used.
+ * Fills the frame and utilization members of the plan and 'jitter_us' of each transfer. \n
+ * The framing compiler rejects overloaded minor frames, so each transfer is sent at its applied rate on average,
+ * but its start within the minor frames varies by up to 'jitter_us' depending on the transfers sent before it.
+ * @param [in] plan the plan
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_INVALID_RATE if the rates result in a framing that is too large, or the busiest minor frame
+ *   does not fit into the minor frame time. Use \ref api429_rate_plan_suggest or lower rates in this case
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_rate_plan_predict(struct api429_rate_plan* plan)
+{
+    struct api429_framing_setup setup;
+    struct api429_framing_label* labels;
+    struct api429_framing_plan* framing = NULL;
+    AiUInt32 i, j;
+    AiReturn ret;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    labels = (struct api429_framing_label*) calloc(plan->label_count, sizeof(struct api429_framing_label));
+    if(!labels)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        labels[i].xfer    = plan->labels[i].xfer;
+        labels[i].rate_ms = plan->labels[i].applied_ms;
+    }
+
+    /* The framing compiler needs an unused transfer ID for empty minor frames */
+    memset(&setup, 0, sizeof(setup));
+    setup.speed = plan->speed;
+    for(setup.nop_xfer_id = 1, i = 0; i < plan->label_count; i++)
+    {
+        if(plan->labels[i].xfer.xfer_id == setup.nop_xfer_id)
+        {
+            setup.nop_xfer_id++;
+            i = (AiUInt32) -1;
+        }
+    }
+
+    ret = api429_framing_compile(&setup, labels, plan->label_count, &framing);
+    free(labels);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    plan->minor_frame_time  = framing->minor_frame_time;
+    plan->major_frame_count = framing->major_frame_count;
+    plan->utilization       = framing->utilization;
+    plan->peak_utilization  = framing->peak_utilization;
+    plan->max_jitter_us     = framing->max_jitter_us;
+
+    /* The framing compiler orders the transfers by rate, so match its reports by transfer ID */
+    for(i = 0; i < plan->label_count; i++)
+    {
+        plan->labels[i].jitter_us = 0;
+
+        for(j = 0; j < framing->label_count; j++)
+        {
+            if(framing->labels[j].xfer_id == plan->labels[i].xfer.xfer_id)
+            {
+                plan->labels[i].jitter_us = framing->labels[j].jitter_us;
+                break;
+            }
+        }
+    }
+
+    api429_framing_plan_free(framing);
+
+    return API_OK;
+}
+
+
+/*! \brief Get least common multiple of numbers
+ *
+ * @return least common multiple, or 0 if it exceeds 'limit'
+ */
+static AI_INLINE AiUInt64 api429_rate_plan_lcm(const AiUInt32* values, AiUInt32 count, AiUInt64 limit)
+{
+    AiUInt64 lcm = 1;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        lcm = lcm / api429_framing_gcd(lcm, values[i]) * values[i];
+        if(lcm > limit)
+        {
+            return 0;
+        }
+    }
+
+    return lcm;
+}
+
+
+/*! \brief Suggest rates that divide evenly
+ *
+ * Searches the largest base period, where each requested rate can be replaced by a multiple of the base
+ * within the tolerance, so that the major frame does not exceed 'max_minor_frames' minor frames.
+ * Each rate is first rounded to the nearest multiple of the base. If this results in a too large major frame,
+ * rates are rounded to the nearest power of two multiple of the base, which results in a harmonic rate set.
+ * On success 'suggested_ms' of each transfer is set, and the suggestion is used as applied rate.
+ * @param [in] plan the plan
+ * @param [in] tolerance_pct maximum deviation of a suggested rate from the requested one in percent
+ * @param [in] max_minor_frames maximum number of minor frames in the major frame. Ranges from 1 to \ref API429_FRAMING_MAX_MINOR_FRAMES
+ * @param [out] base_ms the base period, which is the minor frame time of the suggestion, is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_INVALID_RATE if no suggestion within tolerance was found
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_rate_plan_suggest(struct api429_rate_plan* plan, AiDouble tolerance_pct, AiUInt32 max_minor_frames,
+                                                   AiUInt32* base_ms)
+{
+    AiUInt32* multiples;
+    AiUInt32 min_rate;
+    AiUInt32 base;
+    AiUInt32 mode;
+    AiUInt32 n, p;
+    AiDouble deviation;
+    AiBoolean fits;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(tolerance_pct < 0.0 || max_minor_frames == 0 || max_minor_frames > API429_FRAMING_MAX_MINOR_FRAMES)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    multiples = (AiUInt32*) calloc(plan->label_count, sizeof(AiUInt32));
+    if(!multiples)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    min_rate = plan->labels[0].rate_ms;
+    for(i = 1; i < plan->label_count; i++)
+    {
+        min_rate = plan->labels[i].rate_ms < min_rate ? plan->labels[i].rate_ms : min_rate;
+    }
+
+    min_rate = min_rate > API429_FRAMING_MAX_FRAME_TIME ? API429_FRAMING_MAX_FRAME_TIME : min_rate;
+
+    for(base = min_rate; base > 0; base--)
+    {
+        /* Mode 0: nearest multiple of base, mode 1: nearest power of two multiple of base */
+        for(mode = 0; mode < 2; mode++)
+        {
+            fits = AiTrue;
+
+            for(i = 0; i < plan->label_count && fits; i++)
+            {
+                n = (plan->labels[i].rate_ms + base / 2) / base;
+                n = n ? n : 1;
+
+                if(mode == 1)
+                {
+                    for(p = 1; p * 2 <= n; p *= 2)
+                    {
+                    }
+
+                    /* Pick the nearer one of p and 2p */
+                    n = 2 * (n - p) > p ? p * 2 : p;
+                }
+
+                deviation = ((AiDouble) n * base - plan->labels[i].rate_ms) * 100.0 / plan->labels[i].rate_ms;
+                deviation = deviation < 0.0 ? -deviation : deviation;
+
+                multiples[i] = n;
+                fits = deviation <= tolerance_pct ? AiTrue : AiFalse;
+            }
+
+            if(fits && api429_rate_plan_lcm(multiples, plan->label_count, max_minor_frames))
+            {
+                for(i = 0; i < plan->label_count; i++)
+                {
+                    plan->labels[i].suggested_ms = multiples[i] * base;
+                    plan->labels[i].applied_ms   = multiples[i] * base;
+                }
+
+                if(base_ms)
+                {
+                    *base_ms = base;
+                }
+
+                free(multiples);
+                return API_OK;
+            }
+        }
+    }
+
+    free(multiples);
+
+    return AI429_ERR_INVALID_RATE;
+}
+
+
+/*! \brief Apply the plan to the channel and read back the realized rates
+ *
+ * Adds all transfers with their applied rate via \ref Api429TxXferRateAdd, lets the board software calculate
+ * the framing with \ref Api429TxPrepareFraming and reads the realized rates with \ref Api429TxXferRateShow. \n
+ * The transfers must have been created with \ref Api429TxXferCreate and the channel must be initialized in
+ * \ref API429_TX_MODE_RATE_CONTROLLED, but not started yet. \n
+ * \ref API429_RATE_FLAG_ROUNDED is updated.
+ * @param [in] plan the plan
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_rate_plan_apply(struct api429_rate_plan* plan)
+{
+    struct api429_rate_label* label;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        ret = Api429TxXferRateAdd(plan->board_handle, plan->channel, plan->labels[i].xfer.xfer_id, plan->labels[i].applied_ms);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    ret = Api429TxPrepareFraming(plan->board_handle, plan->channel);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        label = &plan->labels[i];
+
+        ret = Api429TxXferRateShow(plan->board_handle, plan->channel, label->xfer.xfer_id, &label->realized_ms);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        label->flags &= ~API429_RATE_FLAG_ROUNDED;
+
+        if(label->realized_ms != label->applied_ms)
+        {
+            label->flags |= API429_RATE_FLAG_ROUNDED;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Reset all period measurements
+ *
+ * @param [in] plan the plan
+ */
+static AI_INLINE void api429_rate_plan_measure_reset(struct api429_rate_plan* plan)
+{
+    struct api429_rate_label* label;
+    AiUInt32 i;
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        label = &plan->labels[i];
+
+        label->measured_count  = 0;
+        label->measured_sum_us = 0;
+        label->measured_min_us = 0;
+        label->measured_max_us = 0;
+        label->last_rx_us      = -1;
+    }
+}
+
+
+/*! \brief Process monitor entries of a loopback channel
+ *
+ * Each received data word is assigned to the transfer with matching label and SDI,
+ * and the time since the previous data word of this transfer is recorded as period.
+ * Both label bit orders are accepted.
+ * @param [in] plan the plan
+ * @param [in] entries monitor entries as read by \ref Api429RmDataRead
+ * @param [in] count number of entries
+ */
+static AI_INLINE void api429_rate_plan_rm_process(struct api429_rate_plan* plan, const struct api429_rcv_stack_entry* entries, AiUInt32 count)
+{
+    struct api429_rate_label* label;
+    AiUInt8 number, reversed, sdi;
+    AiInt64 rx_us, period;
+    AiUInt32 i, l;
+
+    for(i = 0; i < count; i++)
+    {
+        number   = (AiUInt8) (entries[i].ldata & API429_WORD_LABEL_MASK);
+        reversed = api429_codec_label_reverse(number);
+        sdi      = (AiUInt8) ((entries[i].ldata & API429_WORD_SDI_MASK) >> API429_WORD_SDI_POS);
+        rx_us    = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+
+        for(l = 0; l < plan->label_count; l++)
+        {
+            label = &plan->labels[l];
+
+            if((label->label != number && label->label != reversed) || (label->sdi != API429_RATE_PLAN_SDI_ANY && label->sdi != sdi))
+            {
+                continue;
+            }
+
+            if(label->last_rx_us >= 0)
+            {
+                period = api429_timing_diff_us(rx_us, label->last_rx_us);
+
+                if(label->measured_count == 0 || period < label->measured_min_us)
+                {
+                    label->measured_min_us = period;
+                }
+
+                if(label->measured_count == 0 || period > label->measured_max_us)
+                {
+                    label->measured_max_us = period;
+                }
+
+                label->measured_sum_us += period;
+                label->measured_count++;
+            }
+
+            label->last_rx_us = rx_us;
+            break;
+        }
+    }
+}
+
+
+/*! \brief Read and process all pending entries of a loopback monitor channel
+ *
+ * @param [in] plan the plan
+ * @param [in] rm_channel ID of the receive channel that monitors the transmit channel in \ref API429_RM_MODE_LOC
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_rate_plan_rm_poll(struct api429_rate_plan* plan, AiUInt8 rm_channel)
+{
+    AiUInt16 count;
+    AiReturn ret;
+
+    if(!plan)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    do
+    {
+        ret = Api429RmDataRead(plan->board_handle, rm_channel, API429_RATE_PLAN_RM_BLOCK, &count, plan->rm_scratch);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        api429_rate_plan_rm_process(plan, plan->rm_scratch, count);
+    }
+    while(count == API429_RATE_PLAN_RM_BLOCK);
+
+    return API_OK;
+}
+
+
+/*! \brief Evaluate the measured periods
+ *
+ * Updates \ref API429_RATE_FLAG_DEVIATION, \ref API429_RATE_FLAG_JITTER and \ref API429_RATE_FLAG_NO_DATA of each transfer.
+ * Single periods may additionally deviate by the jitter calculated by \ref api429_rate_plan_predict.
+ * @param [in] plan the plan
+ * @param [in] tolerance_pct maximum deviation of a measured period from the applied rate in percent
+ * @param [in] min_count minimum number of measured periods for a valid measurement
+ * @return number of transfers with any flag set
+ */
+static AI_INLINE AiUInt32 api429_rate_plan_evaluate(struct api429_rate_plan* plan, AiDouble tolerance_pct, AiUInt32 min_count)
+{
+    struct api429_rate_label* label;
+    AiDouble expected, limit, mean;
+    AiUInt32 flagged = 0;
+    AiUInt32 i;
+
+    if(!plan)
+    {
+        return 0;
+    }
+
+    for(i = 0; i < plan->label_count; i++)
+    {
+        label = &plan->labels[i];
+        label->flags &= ~(API429_RATE_FLAG_DEVIATION | API429_RATE_FLAG_JITTER | API429_RATE_FLAG_NO_DATA);
+
+        expected = (AiDouble) label->applied_ms * 1000.0;
+        limit    = expected * tolerance_pct / 100.0;
+
+        if(label->measured_count == 0 || label->measured_count < min_count)
+        {
+            label->flags |= API429_RATE_FLAG_NO_DATA;
+        }
+        else
+        {
+            mean = (AiDouble) label->measured_sum_us / label->measured_count;
+
+            if(mean < expected - limit || mean > expected + limit)
+            {
+                label->flags |= API429_RATE_FLAG_DEVIATION;
+            }
+
+            if(label->measured_min_us < expected - limit - label->jitter_us || label->measured_max_us > expected + limit + label->jitter_us)
+            {
+                label->flags |= API429_RATE_FLAG_JITTER;
+            }
+        }
+
+        if(label->flags)
+        {
+            flagged++;
+        }
+    }
+
+    return flagged;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429RATEPLAN_H_ */
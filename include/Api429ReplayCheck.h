@@ -0,0 +1,397 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayCheck.h
+ *
+ *  This header file contains inline helper functions
+ *  for checking a recording before it is replayed
+ */
+
+#ifndef API429REPLAYCHECK_H_
+#define API429REPLAYCHECK_H_
+
+
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429ReplayStream.h"
+#include "Api429Timing.h"
+
+
+/**
+* \defgroup replay_check Replay Pre-Flight Check
+  This module scans a replay source before the replay is started, to detect replays that would fail midway. \n
+  For each recorded channel it calculates the bus utilization from the word times at the channel speed,
+  on average and in the busiest window, and counts entries that follow the previous entry of the channel
+  closer than one word time, which the bus is physically not able to carry. \n
+  For the replay buffer it calculates how long each half buffer of \ref api429_replay_status.ul_Size bytes takes
+  to replay. While the board replays one half buffer, the host must refill the other one,
+  so the shortest replay time of a half buffer is the worst-case refill deadline. \n
+  The result is rated against the host capabilities in \ref api429_replay_check_setup:
+  - \ref API429_REPLAY_CHECK_REJECT if the replay cannot succeed
+  - \ref API429_REPLAY_CHECK_WARN if the replay runs with little margin
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_CHECK_CHANNELS
+ * Number of channels that can be distinguished in a recording
+ */
+#define API429_REPLAY_CHECK_CHANNELS            16
+
+/*! \def API429_REPLAY_CHECK_SPEED_RECORDED
+ * Channel speed that selects the speed stored in api429_brw.b.speed of each entry
+ */
+#define API429_REPLAY_CHECK_SPEED_RECORDED      0xFF
+
+/*! \def API429_REPLAY_CHECK_READ_SIZE
+ * Number of bytes read from the replay source at once
+ */
+#define API429_REPLAY_CHECK_READ_SIZE           0x10000
+
+
+/*! \def API429_REPLAY_CHECK_OVERLOAD
+ * Reason: a channel has entries closer than one word time, see \ref api429_replay_check_channel.too_close
+ */
+#define API429_REPLAY_CHECK_OVERLOAD            (1u << 0)
+
+/*! \def API429_REPLAY_CHECK_UTILIZATION
+ * Reason: the utilization of a channel exceeds \ref api429_replay_check_setup.utilization_warn in a window
+ */
+#define API429_REPLAY_CHECK_UTILIZATION         (1u << 1)
+
+/*! \def API429_REPLAY_CHECK_DEADLINE
+ * Reason: a half buffer is replayed faster than the host is able to refill the other half
+ */
+#define API429_REPLAY_CHECK_DEADLINE            (1u << 2)
+
+/*! \def API429_REPLAY_CHECK_DEADLINE_MARGIN
+ * Reason: the refill deadline is met, but with less margin than \ref api429_replay_check_setup.deadline_margin
+ */
+#define API429_REPLAY_CHECK_DEADLINE_MARGIN     (1u << 3)
+
+/*! \def API429_REPLAY_CHECK_BANDWIDTH
+ * Reason: the peak refill bandwidth exceeds \ref api429_replay_check_setup.bandwidth_max
+ */
+#define API429_REPLAY_CHECK_BANDWIDTH           (1u << 4)
+
+
+
+/*! \enum api429_replay_check_verdict
+ *
+ * Enumeration of the ratings of a recording
+ */
+enum api429_replay_check_verdict
+{
+    API429_REPLAY_CHECK_OK = 0,     /*!< The replay is expected to succeed */
+    API429_REPLAY_CHECK_WARN,       /*!< The replay may fail under load */
+    API429_REPLAY_CHECK_REJECT      /*!< The replay cannot succeed */
+};
+
+
+/*! \struct api429_replay_check_setup
+ *
+ * This structure describes the replay and the capabilities of the host
+ */
+struct api429_replay_check_setup
+{
+    AiUInt32 half_size;                             /*!< Size of a half buffer in bytes, see \ref api429_replay_status.ul_Size */
+    AiUInt8 speed[API429_REPLAY_CHECK_CHANNELS];    /*!< Speed of each recorded channel, see \ref api429_speed, or \ref API429_REPLAY_CHECK_SPEED_RECORDED */
+    AiUInt32 window_us;                             /*!< Window the peak utilization is calculated for */
+    AiUInt32 utilization_warn;                      /*!< Peak utilization in percent above which a warning is given */
+    AiUInt32 host_latency_us;                       /*!< Longest time the host needs from a half buffer interrupt to the written half buffer */
+    AiUInt32 deadline_margin;                       /*!< Refill deadline in percent of 'host_latency_us' below which a warning is given */
+    AiUInt64 bandwidth_max;                         /*!< Bytes per second the host is able to deliver. 0 for unlimited */
+};
+
+/*! \typedef TY_API429_REPLAY_CHECK_SETUP
+ * Convenience typedef for \ref api429_replay_check_setup
+ */
+typedef struct api429_replay_check_setup TY_API429_REPLAY_CHECK_SETUP;
+
+
+/*! \struct api429_replay_check_channel
+ *
+ * This structure holds the results of one recorded channel
+ */
+struct api429_replay_check_channel
+{
+    AiUInt64 entries;               /*!< Number of entries */
+    AiUInt64 busy_ns;               /*!< Time the words occupy the bus */
+    AiDouble utilization;           /*!< Busy time relative to the duration of the recording */
+    AiDouble utilization_peak;      /*!< Busy time relative to the window in the busiest window */
+    AiInt64 utilization_peak_us;    /*!< Start of the busiest window since the first entry */
+    AiUInt64 too_close;             /*!< Number of entries closer than one word time minus one microsecond to the previous entry */
+    AiInt64 too_close_first_us;     /*!< Time of the first of these entries since the first entry */
+
+    AiInt64 last_us;                /*!< Internal: time of the previous entry */
+    AiInt64 window;                 /*!< Internal: index of the current window */
+    AiUInt64 window_busy_ns;        /*!< Internal: busy time in the current window */
+};
+
+/*! \typedef TY_API429_REPLAY_CHECK_CHANNEL
+ * Convenience typedef for \ref api429_replay_check_channel
+ */
+typedef struct api429_replay_check_channel TY_API429_REPLAY_CHECK_CHANNEL;
+
+
+/*! \struct api429_replay_check_result
+ *
+ * This structure holds the results of a pre-flight check
+ */
+struct api429_replay_check_result
+{
+    struct api429_replay_check_channel channels[API429_REPLAY_CHECK_CHANNELS]; /*!< Results by recorded channel */
+    AiUInt64 entries;                       /*!< Number of entries */
+    AiUInt64 bytes;                         /*!< Number of bytes */
+    AiInt64 duration_us;                    /*!< Time of the last entry since the first entry */
+    AiUInt64 halves;                        /*!< Number of half buffers */
+    AiInt64 refill_min_us;                  /*!< Worst-case refill deadline, i.e. shortest replay time of a half buffer. -1 if unknown */
+    AiUInt64 refill_min_offset;             /*!< Offset of the half buffer with the shortest replay time */
+    AiDouble bandwidth_avg;                 /*!< Average refill bandwidth in bytes per second */
+    AiDouble bandwidth_peak;                /*!< Refill bandwidth in bytes per second at the worst-case refill deadline */
+    AiUInt32 reasons;                       /*!< Reasons of the verdict, e.g. \ref API429_REPLAY_CHECK_OVERLOAD */
+    enum api429_replay_check_verdict verdict; /*!< Rating of the recording */
+};
+
+/*! \typedef TY_API429_REPLAY_CHECK_RESULT
+ * Convenience typedef for \ref api429_replay_check_result
+ */
+typedef struct api429_replay_check_result TY_API429_REPLAY_CHECK_RESULT;
+
+
+
+
+/*! \brief Initialize a check setup with default values
+ *
+ * Recorded speeds, 10 ms windows, warning above 80 % utilization, 10 ms host latency with a margin of 200 %
+ * and unlimited bandwidth.
+ * @param [out] setup the setup to initialize
+ * @param [in] half_size size of a half buffer in bytes, see \ref api429_replay_status.ul_Size
+ */
+static AI_INLINE void api429_replay_check_setup_init(struct api429_replay_check_setup* setup, AiUInt32 half_size)
+{
+    memset(setup, 0, sizeof(*setup));
+    memset(setup->speed, API429_REPLAY_CHECK_SPEED_RECORDED, sizeof(setup->speed));
+
+    setup->half_size        = half_size;
+    setup->window_us        = 10000;
+    setup->utilization_warn = 80;
+    setup->host_latency_us  = 10000;
+    setup->deadline_margin  = 200;
+}
+
+
+/*! \brief Close the current utilization window of a channel
+ */
+static AI_INLINE void api429_replay_check_window_close(const struct api429_replay_check_setup* setup, struct api429_replay_check_channel* channel)
+{
+    AiDouble utilization = (AiDouble) channel->window_busy_ns / ((AiDouble) setup->window_us * 1000.0);
+
+    if(utilization > channel->utilization_peak)
+    {
+        channel->utilization_peak    = utilization;
+        channel->utilization_peak_us = channel->window * setup->window_us;
+    }
+
+    channel->window_busy_ns = 0;
+}
+
+
+/*! \brief Rate the results of a check
+ */
+static AI_INLINE void api429_replay_check_rate(const struct api429_replay_check_setup* setup, struct api429_replay_check_result* result)
+{
+    AiUInt32 reject = API429_REPLAY_CHECK_OVERLOAD | API429_REPLAY_CHECK_DEADLINE | API429_REPLAY_CHECK_BANDWIDTH;
+    AiUInt32 i;
+
+    for(i = 0; i < API429_REPLAY_CHECK_CHANNELS; i++)
+    {
+        if(result->channels[i].too_close)
+        {
+            result->reasons |= API429_REPLAY_CHECK_OVERLOAD;
+        }
+
+        if(result->channels[i].utilization_peak * 100.0 > setup->utilization_warn)
+        {
+            result->reasons |= API429_REPLAY_CHECK_UTILIZATION;
+        }
+    }
+
+    if(result->refill_min_us >= 0)
+    {
+        if(result->refill_min_us < setup->host_latency_us)
+        {
+            result->reasons |= API429_REPLAY_CHECK_DEADLINE;
+        }
+        else if(result->refill_min_us * 100 < (AiInt64) setup->host_latency_us * setup->deadline_margin)
+        {
+            result->reasons |= API429_REPLAY_CHECK_DEADLINE_MARGIN;
+        }
+    }
+
+    if(setup->bandwidth_max && result->bandwidth_peak > (AiDouble) setup->bandwidth_max)
+    {
+        result->reasons |= API429_REPLAY_CHECK_BANDWIDTH;
+    }
+
+    result->verdict = result->reasons & reject ? API429_REPLAY_CHECK_REJECT
+                    : result->reasons ? API429_REPLAY_CHECK_WARN : API429_REPLAY_CHECK_OK;
+}
+
+
+/*! \brief Check a recording before it is replayed
+ *
+ * Reads the replay source to its end, so it must be repositioned before the replay,
+ * e.g. with \ref api429_replay_file_rewind. Sources like \ref api429_replay_transform are checked
+ * with their modifications applied.
+ * @param [in] source the replay source
+ * @param [in] setup the replay and the capabilities of the host, see \ref api429_replay_check_setup_init
+ * @param [out] result the results are stored here
+ * @return
+ * - API_OK on success. The rating is returned in result->verdict
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_check_run(struct api429_replay_source* source, const struct api429_replay_check_setup* setup,
+                                                  struct api429_replay_check_result* result)
+{
+    const struct api429_rcv_stack_entry* entries;
+    struct api429_replay_check_channel* channel;
+    struct api429_replay_reader reader;
+    AiUInt32 word_ns, speed;
+    AiInt64 time, last = 0, elapsed = 0, window;
+    AiInt64 half_start = 0, half_time;
+    AiUInt64 half = 0;
+    AiUInt32 count, i;
+    AiReturn ret;
+
+    if(!source || !source->read || !setup || !result)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(!setup->half_size || !setup->window_us)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->refill_min_us = -1;
+
+    api429_replay_reader_init(&reader, source, API429_REPLAY_CHECK_READ_SIZE);
+
+    for(;;)
+    {
+        ret = api429_replay_reader_next(&reader, &entries, &count);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        if(!count)
+        {
+            break;
+        }
+
+        for(i = 0; i < count; i++)
+        {
+            time = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+
+            if(result->entries)
+            {
+                elapsed += api429_timing_diff_us(time, last);
+            }
+
+            last = time;
+
+            /* A new half buffer starts with this entry. The previous one is replayed in the meantime */
+            if(result->bytes / setup->half_size != half)
+            {
+                half_time = elapsed - half_start;
+
+                if(half && (result->refill_min_us < 0 || half_time < result->refill_min_us))
+                {
+                    result->refill_min_us     = half_time;
+                    result->refill_min_offset = half * setup->half_size;
+                }
+
+                half       = result->bytes / setup->half_size;
+                half_start = elapsed;
+            }
+
+            channel = &result->channels[entries[i].brw.b.channel];
+            speed   = setup->speed[entries[i].brw.b.channel];
+            speed   = speed == API429_REPLAY_CHECK_SPEED_RECORDED ? entries[i].brw.b.speed : speed;
+            word_ns = api429_timing_word_time_ns((enum api429_speed) speed, API429_MIN_GAP_BITS);
+
+            /* Time tags have a resolution of one microsecond, so allow one tick of rounding */
+            if(channel->entries && (elapsed - channel->last_us + 1) * 1000 < word_ns)
+            {
+                channel->too_close_first_us = channel->too_close ? channel->too_close_first_us : elapsed;
+                channel->too_close++;
+            }
+
+            window = elapsed > 0 ? elapsed / setup->window_us : 0;
+
+            if(channel->entries && window != channel->window)
+            {
+                api429_replay_check_window_close(setup, channel);
+            }
+
+            channel->window          = window;
+            channel->window_busy_ns += word_ns;
+            channel->busy_ns        += word_ns;
+            channel->last_us         = elapsed;
+            channel->entries++;
+
+            result->entries++;
+            result->bytes += API429_REPLAY_ENTRY_SIZE;
+        }
+
+        api429_replay_reader_consume(&reader, count);
+    }
+
+    result->duration_us = elapsed;
+    result->halves      = (result->bytes + setup->half_size - 1) / setup->half_size;
+
+    for(i = 0; i < API429_REPLAY_CHECK_CHANNELS; i++)
+    {
+        channel = &result->channels[i];
+
+        if(channel->entries)
+        {
+            api429_replay_check_window_close(setup, channel);
+            channel->utilization = elapsed > 0 ? (AiDouble) channel->busy_ns / ((AiDouble) elapsed * 1000.0) : 0.0;
+        }
+    }
+
+    if(elapsed > 0)
+    {
+        result->bandwidth_avg = (AiDouble) result->bytes * 1000000.0 / (AiDouble) elapsed;
+    }
+
+    if(result->refill_min_us > 0)
+    {
+        result->bandwidth_peak = (AiDouble) setup->half_size * 1000000.0 / (AiDouble) result->refill_min_us;
+    }
+
+    api429_replay_check_rate(setup, result);
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYCHECK_H_ */
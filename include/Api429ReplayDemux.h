@@ -0,0 +1,732 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayDemux.h
+ *
+ *  This header file contains inline helper functions
+ *  for replaying one merged recording on several channels
+ */
+
+#ifndef API429REPLAYDEMUX_H_
+#define API429REPLAYDEMUX_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429ReplayStream.h"
+#include "Api429Timing.h"
+#include "Ai_container.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup replay_demux Multi-Channel Replay
+  This module replays a recording that contains the traffic of several channels, e.g. recorded by a global monitor,
+  on the original channels. \n
+  The entries of the merged recording are split by api429_brw.b.channel into one queue per channel.
+  Each queue is the \ref api429_replay_source of a \ref api429_replay_stream of the channel it is mapped to with
+  \ref api429_replay_demux_channel_add. \n
+  All streams are started with absolute time tags and the same time offset, which is derived from the first entry
+  of the recording and the board time. So the board keeps the original timing between the channels, independent
+  of when each channel is started. \n
+  A queue that is full stops splitting the recording until its channel caught up. This bounds the skew between the
+  channels on host side to the time span one queue holds.
+  While the channels are started one after the other, data of channels not started yet is buffered without limit,
+  so each added channel should have traffic at the beginning of the recording.
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_DEMUX_CHANNELS
+ * Number of channels that can be distinguished in a recording
+ */
+#define API429_REPLAY_DEMUX_CHANNELS    16
+
+/*! \def API429_REPLAY_DEMUX_INPUT_CHUNK
+ * Number of bytes read from the merged recording at once
+ */
+#define API429_REPLAY_DEMUX_INPUT_CHUNK 0x10000
+
+/*! \def API429_REPLAY_DEMUX_WAIT_US
+ * Maximum time a full queue is waited for before checking for a stop request
+ */
+#define API429_REPLAY_DEMUX_WAIT_US     10000
+
+struct api429_replay_demux;
+
+
+/*! \struct api429_replay_demux_output
+ *
+ * This structure holds the queue of one channel of a merged recording
+ */
+struct api429_replay_demux_output
+{
+    struct api429_replay_source source;     /*!< Replay source of the channel */
+    struct api429_replay_demux* demux;      /*!< The demultiplexer the output belongs to */
+    AiUInt8 board_channel;                  /*!< ID of the replay channel */
+    AiUInt8* queue;                         /*!< Ring buffer of queued bytes */
+    AiUInt32 capacity;                      /*!< Size of 'queue' in bytes */
+    AiUInt32 head;                          /*!< Offset of the first queued byte */
+    AiUInt32 fill;                          /*!< Number of queued bytes */
+    AiUInt64 taken;                         /*!< Number of bytes ever taken from the queue */
+    AiUInt64 entries;                       /*!< Number of entries ever queued */
+    AiUInt8* buffer;                        /*!< Buffer of the chunk delivered to the stream */
+    AiUInt32 buffer_size;                   /*!< Size of 'buffer' in bytes */
+    AiBoolean started;                      /*!< AiTrue if the stream of the output is running */
+    struct api429_replay_stream* stream;    /*!< Replay stream of the channel */
+};
+
+/*! \typedef TY_API429_REPLAY_DEMUX_OUTPUT
+ * Convenience typedef for \ref api429_replay_demux_output
+ */
+typedef struct api429_replay_demux_output TY_API429_REPLAY_DEMUX_OUTPUT;
+
+
+/*! \struct api429_replay_demux_status
+ *
+ * This structure reports the progress of a multi-channel replay
+ */
+struct api429_replay_demux_status
+{
+    AiInt64 skew_us;                        /*!< Difference of the recorded times of the next entries of the channels */
+    AiInt64 skew_max_us;                    /*!< Largest value of 'skew_us' so far */
+    AiUInt64 input_bytes;                   /*!< Number of bytes read from the merged recording */
+    AiUInt64 dropped;                       /*!< Number of entries of channels that are not replayed */
+    AiBoolean input_end;                    /*!< AiTrue if the whole merged recording was read */
+};
+
+/*! \typedef TY_API429_REPLAY_DEMUX_STATUS
+ * Convenience typedef for \ref api429_replay_demux_status
+ */
+typedef struct api429_replay_demux_status TY_API429_REPLAY_DEMUX_STATUS;
+
+
+/*! \struct api429_replay_demux
+ *
+ * This structure holds a demultiplexer of a merged recording.
+ * It is created with \ref api429_replay_demux_create
+ */
+struct api429_replay_demux
+{
+    struct api429_replay_reader input;                                      /*!< Reader of the merged recording */
+    AiUInt32 queue_size;                                                    /*!< Size of the queue of each output in bytes */
+    struct api429_replay_demux_output outputs[API429_REPLAY_DEMUX_CHANNELS]; /*!< Outputs by recorded channel */
+    AiBoolean mapped[API429_REPLAY_DEMUX_CHANNELS];                         /*!< AiTrue if the recorded channel is replayed */
+    struct api429_replay_demux_status status;                               /*!< Progress of the replay */
+    struct ai_mutex* lock;                                                  /*!< Protects queues and input */
+    struct ai_event* drained;                                               /*!< Signalled when bytes were taken from a queue */
+    volatile AiUInt32 stop;                                                 /*!< Set to stop all streams */
+};
+
+/*! \typedef TY_API429_REPLAY_DEMUX
+ * Convenience typedef for \ref api429_replay_demux
+ */
+typedef struct api429_replay_demux TY_API429_REPLAY_DEMUX;
+
+
+
+
+/*! \brief Get the recorded time of a queued entry
+ *
+ * @return time in microseconds since midnight
+ */
+static AI_INLINE AiInt64 api429_replay_demux_entry_time(const struct api429_replay_demux_output* output, AiUInt32 offset)
+{
+    struct api429_rcv_stack_entry entry;
+    AiUInt8* bytes = (AiUInt8*) &entry;
+    AiUInt32 i;
+
+    for(i = 0; i < API429_REPLAY_ENTRY_SIZE; i++)
+    {
+        bytes[i] = output->queue[(output->head + offset + i) % output->capacity];
+    }
+
+    return api429_timing_tm_tag_us(entry.tm_tag, entry.brw);
+}
+
+
+/*! \brief Update the skew between the channels
+ *
+ * Must be called with the lock held.
+ */
+static AI_INLINE void api429_replay_demux_skew_update(struct api429_replay_demux* demux)
+{
+    struct api429_replay_demux_output* output;
+    AiInt64 first = 0, last = 0, time, diff;
+    AiBoolean any = AiFalse;
+    AiUInt32 offset;
+    AiUInt32 i;
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS; i++)
+    {
+        output = &demux->outputs[i];
+
+        /* Skip a partially taken entry */
+        offset = (AiUInt32) ((API429_REPLAY_ENTRY_SIZE - output->taken % API429_REPLAY_ENTRY_SIZE) % API429_REPLAY_ENTRY_SIZE);
+
+        if(!demux->mapped[i] || !output->started || output->fill < offset + API429_REPLAY_ENTRY_SIZE)
+        {
+            continue;
+        }
+
+        time = api429_replay_demux_entry_time(output, offset);
+
+        if(!any)
+        {
+            first = last = time;
+            any   = AiTrue;
+        }
+        else if(api429_timing_diff_us(time, first) < 0)
+        {
+            first = time;
+        }
+        else if(api429_timing_diff_us(time, last) > 0)
+        {
+            last = time;
+        }
+    }
+
+    diff = any ? api429_timing_diff_us(last, first) : 0;
+
+    demux->status.skew_us = diff;
+    if(diff > demux->status.skew_max_us)
+    {
+        demux->status.skew_max_us = diff;
+    }
+}
+
+
+/*! \brief Make room in the queue of an output that is not started yet
+ *
+ * Must be called with the lock held.
+ */
+static AI_INLINE AiReturn api429_replay_demux_grow(struct api429_replay_demux_output* output)
+{
+    AiUInt8* queue;
+    AiUInt32 capacity = output->capacity * 2;
+    AiUInt32 first;
+
+    queue = (AiUInt8*) malloc(capacity);
+    if(!queue)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    first = output->capacity - output->head;
+    first = output->fill < first ? output->fill : first;
+
+    memcpy(queue, output->queue + output->head, first);
+    memcpy(queue + first, output->queue, output->fill - first);
+
+    free(output->queue);
+
+    output->queue    = queue;
+    output->capacity = capacity;
+    output->head     = 0;
+
+    return API_OK;
+}
+
+
+/*! \brief Split the merged recording until an output holds enough bytes
+ *
+ * Must be called with the lock held.
+ * @return API_OK if the output holds 'needed' bytes or the recording ended,
+ *         AI429_ERR_BUFFER_OVERFLOW if the queue of a running channel is full
+ */
+static AI_INLINE AiReturn api429_replay_demux_pump(struct api429_replay_demux* demux, struct api429_replay_demux_output* requester,
+                                                   AiUInt32 needed)
+{
+    struct api429_replay_demux_output* output;
+    const struct api429_rcv_stack_entry* entries;
+    const AiUInt8* bytes;
+    AiUInt32 count, tail, i, k;
+    AiReturn ret;
+
+    while(requester->fill < needed && !demux->status.input_end)
+    {
+        ret = api429_replay_reader_next(&demux->input, &entries, &count);
+
+        demux->status.input_bytes = demux->input.bytes;
+
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        if(!count)
+        {
+            demux->status.input_end = AiTrue;
+            return API_OK;
+        }
+
+        for(k = 0; k < count && requester->fill < needed; k++)
+        {
+            if(!demux->mapped[entries[k].brw.b.channel])
+            {
+                demux->status.dropped++;
+                continue;
+            }
+
+            output = &demux->outputs[entries[k].brw.b.channel];
+
+            if(output->capacity - output->fill < API429_REPLAY_ENTRY_SIZE)
+            {
+                if(output->started)
+                {
+                    api429_replay_reader_consume(&demux->input, k);
+                    return AI429_ERR_BUFFER_OVERFLOW;
+                }
+
+                ret = api429_replay_demux_grow(output);
+                if(ret != API_OK)
+                {
+                    api429_replay_reader_consume(&demux->input, k);
+                    return ret;
+                }
+            }
+
+            bytes = (const AiUInt8*) &entries[k];
+            tail  = (output->head + output->fill) % output->capacity;
+
+            for(i = 0; i < API429_REPLAY_ENTRY_SIZE; i++)
+            {
+                output->queue[(tail + i) % output->capacity] = bytes[i];
+            }
+
+            output->fill += API429_REPLAY_ENTRY_SIZE;
+            output->entries++;
+        }
+
+        api429_replay_reader_consume(&demux->input, k);
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Read function of a demultiplexer output
+ */
+static AiReturn AI_CALL_CONV api429_replay_demux_read(struct api429_replay_source* source, AiUInt32 size, struct api429_replay_chunk* chunk)
+{
+    struct api429_replay_demux_output* output = AI_CONTAINER_OF(source, struct api429_replay_demux_output, source);
+    struct api429_replay_demux* demux = output->demux;
+    AiUInt32 count, first;
+    AiUInt32 value;
+    AiReturn ret = API_OK;
+
+    chunk->size = 0;
+
+    if(size > output->buffer_size)
+    {
+        free(output->buffer);
+        output->buffer      = (AiUInt8*) malloc(size);
+        output->buffer_size = output->buffer ? size : 0;
+
+        if(!output->buffer)
+        {
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+    }
+
+    chunk->data = output->buffer;
+
+    ai_mutex_lock(demux->lock);
+
+    if(size > output->capacity)
+    {
+        ai_mutex_release(demux->lock);
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    for(;;)
+    {
+        value = ai_event_value(demux->drained);
+
+        ret = api429_replay_demux_pump(demux, output, size);
+        if(ret != AI429_ERR_BUFFER_OVERFLOW || ai_atomic_u32_load(&demux->stop))
+        {
+            break;
+        }
+
+        /* Another channel lags behind, wait until it took data from its queue */
+        ai_mutex_release(demux->lock);
+        ai_event_wait(demux->drained, value, API429_REPLAY_DEMUX_WAIT_US);
+        ai_mutex_lock(demux->lock);
+    }
+
+    if(ret == AI429_ERR_BUFFER_OVERFLOW)
+    {
+        ret = API_OK;
+    }
+
+    if(ret == API_OK && !ai_atomic_u32_load(&demux->stop))
+    {
+        count = output->fill < size ? output->fill : size;
+        first = output->capacity - output->head;
+        first = count < first ? count : first;
+
+        memcpy(output->buffer, output->queue + output->head, first);
+        memcpy(output->buffer + first, output->queue, count - first);
+
+        output->head   = (output->head + count) % output->capacity;
+        output->fill  -= count;
+        output->taken += count;
+        chunk->size    = count;
+
+        api429_replay_demux_skew_update(demux);
+    }
+
+    ai_mutex_release(demux->lock);
+
+    ai_event_signal(demux->drained);
+
+    return ret;
+}
+
+
+/*! \brief Release a demultiplexer
+ *
+ * Stops and releases all replay streams. The merged recording is not released.
+ * @param demux demultiplexer to release. May be NULL
+ */
+static AI_INLINE void api429_replay_demux_free(struct api429_replay_demux* demux)
+{
+    AiUInt32 i;
+
+    if(!demux)
+    {
+        return;
+    }
+
+    ai_atomic_u32_store(&demux->stop, 1);
+
+    if(demux->drained)
+    {
+        ai_event_signal(demux->drained);
+    }
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS; i++)
+    {
+        api429_replay_stream_free(demux->outputs[i].stream);
+        free(demux->outputs[i].queue);
+        free(demux->outputs[i].buffer);
+    }
+
+    if(demux->lock)
+    {
+        ai_mutex_free(demux->lock);
+    }
+
+    if(demux->drained)
+    {
+        ai_event_free(demux->drained);
+    }
+
+    free(demux);
+}
+
+
+/*! \brief Create a demultiplexer
+ *
+ * @param [in] input source of the merged recording. Must stay valid until the demultiplexer is released
+ * @param [in] queue_size size of the queue of each channel in bytes. Must be at least one half replay buffer.
+ *                        Bounds the skew between the channels on host side
+ * @param [out] demux_out the created demultiplexer is stored here. Must be released with \ref api429_replay_demux_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_demux_create(struct api429_replay_source* input, AiUInt32 queue_size,
+                                                     struct api429_replay_demux** demux_out)
+{
+    struct api429_replay_demux* demux;
+
+    if(!input || !input->read || !demux_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *demux_out = NULL;
+
+    if(queue_size < API429_REPLAY_ENTRY_SIZE)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    demux = (struct api429_replay_demux*) calloc(1, sizeof(struct api429_replay_demux));
+    if(!demux)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    demux->queue_size = queue_size;
+    demux->lock       = ai_mutex_create();
+    demux->drained    = ai_event_create();
+
+    if(!demux->lock || !demux->drained)
+    {
+        api429_replay_demux_free(demux);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    api429_replay_reader_init(&demux->input, input, API429_REPLAY_DEMUX_INPUT_CHUNK);
+
+    *demux_out = demux;
+
+    return API_OK;
+}
+
+
+/*! \brief Replay a recorded channel on a replay channel
+ *
+ * Entries of recorded channels that are not added are dropped.
+ * @param [in] demux the demultiplexer
+ * @param [in] recorded_channel channel as stored in api429_brw.b.channel of the recording
+ * @param [in] board_channel ID of the channel to replay on. Must be initialized with \ref API429_TX_MODE_PHYS_REPLAY
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_demux_channel_add(struct api429_replay_demux* demux, AiUInt32 recorded_channel, AiUInt8 board_channel)
+{
+    struct api429_replay_demux_output* output;
+
+    if(!demux)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(recorded_channel >= API429_REPLAY_DEMUX_CHANNELS || demux->mapped[recorded_channel])
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    output = &demux->outputs[recorded_channel];
+
+    output->queue = (AiUInt8*) malloc(demux->queue_size);
+    if(!output->queue)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    output->demux           = demux;
+    output->board_channel   = board_channel;
+    output->capacity        = demux->queue_size;
+    output->source.read     = api429_replay_demux_read;
+    output->source.prefetch = NULL;
+    output->source.size     = API429_REPLAY_SIZE_UNKNOWN;
+
+    demux->mapped[recorded_channel] = AiTrue;
+
+    return API_OK;
+}
+
+
+/*! \brief Start the replay on all channels
+ *
+ * Derives the common time offset from the first entry of the recording and the current board time,
+ * then creates and starts the replay stream of each channel.
+ * @param [in] demux the demultiplexer
+ * @param [in] board_handle handle to the board the channels belong to
+ * @param [in] setup replay parameters. The absolute time tag mode and the time offset are set by this function.
+ *                   'day_of_year' must be the day the recording starts on
+ * @param [in] lead_us time in microseconds between now and the replay of the first entry.
+ *                     Must be long enough to start all channels
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_demux_start(struct api429_replay_demux* demux, AiUInt8 board_handle,
+                                                    const struct api429_replay_stream_setup* setup, AiUInt32 lead_us)
+{
+    const struct api429_rcv_stack_entry* entry;
+    struct api429_replay_stream_setup common;
+    struct api429_time now;
+    AiInt64 offset;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!demux || !setup)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    /* Look at the first entry without queueing it */
+    ai_mutex_lock(demux->lock);
+
+    ret = api429_replay_reader_next(&demux->input, &entry, &i);
+
+    demux->status.input_bytes = demux->input.bytes;
+    demux->status.input_end   = ret == API_OK && !i ? AiTrue : AiFalse;
+    offset                    = ret == API_OK && i ? api429_timing_tm_tag_us(entry->tm_tag, entry->brw) : 0;
+
+    ai_mutex_release(demux->lock);
+
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(demux->status.input_end)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    ret = Api429BoardTimeGet(board_handle, &now);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    /* Offset between the board time the replay starts at and the recorded time of the first entry */
+    offset = (AiInt64) now.day * API429_TIMING_DAY_US + api429_timing_time_us(&now) + lead_us
+           - ((AiInt64) setup->day_of_year * API429_TIMING_DAY_US + offset);
+
+    common               = *setup;
+    common.abs_long_ttag = 1;
+    common.min           = (AiInt32) (offset / 60000000);
+    common.msec          = (AiInt32) (offset % 60000000);
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS && ret == API_OK; i++)
+    {
+        if(demux->mapped[i] && !demux->outputs[i].stream)
+        {
+            ret = api429_replay_stream_create(board_handle, demux->outputs[i].board_channel, &demux->outputs[i].source,
+                                              &common, &demux->outputs[i].stream);
+        }
+    }
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS && ret == API_OK; i++)
+    {
+        if(demux->mapped[i])
+        {
+            ret = api429_replay_stream_start(demux->outputs[i].stream);
+
+            ai_mutex_lock(demux->lock);
+            demux->outputs[i].started = ret == API_OK ? AiTrue : AiFalse;
+            ai_mutex_release(demux->lock);
+        }
+    }
+
+    if(ret != API_OK)
+    {
+        ai_atomic_u32_store(&demux->stop, 1);
+        ai_event_signal(demux->drained);
+
+        for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS; i++)
+        {
+            api429_replay_stream_stop(demux->outputs[i].stream);
+        }
+    }
+
+    return ret;
+}
+
+
+/*! \brief Handle channel events
+ *
+ * Must be called from the callback registered for \ref API429_EVENT_REPLAY_HALF_BUFFER and \ref API429_EVENT_REPLAY_STOP
+ * on each replay channel.
+ * @param [in] demux the demultiplexer
+ * @param [in] board_channel ID of the channel that raised the event
+ * @param [in] type type of the event
+ */
+static AI_INLINE void api429_replay_demux_event(struct api429_replay_demux* demux, AiUInt8 board_channel, enum api429_event_type type)
+{
+    AiUInt32 i;
+
+    if(!demux)
+    {
+        return;
+    }
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS; i++)
+    {
+        if(demux->mapped[i] && demux->outputs[i].board_channel == board_channel)
+        {
+            api429_replay_stream_event(demux->outputs[i].stream, type);
+        }
+    }
+}
+
+
+/*! \brief Get the progress of a multi-channel replay
+ *
+ * The progress of each channel can be retrieved with \ref api429_replay_stream_status on demux->outputs[recorded_channel].stream.
+ * @param [in] demux the demultiplexer
+ * @param [out] status the progress is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_demux_status(struct api429_replay_demux* demux, struct api429_replay_demux_status* status)
+{
+    if(!demux || !status)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(demux->lock);
+    *status = demux->status;
+    ai_mutex_release(demux->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Wait until the replay stopped on all channels
+ *
+ * @param [in] demux the demultiplexer
+ * @param [in] timeout_us maximum time to wait in microseconds
+ * @return
+ * - API_OK if the replay stopped on all channels
+ * - AI429_ERR_TIMEOUT if the replay did not stop in time
+ * - the error a stream encountered, if any
+ */
+static AI_INLINE AiReturn api429_replay_demux_wait(struct api429_replay_demux* demux, AiUInt32 timeout_us)
+{
+    AiUInt64 deadline;
+    AiUInt64 now;
+    AiReturn ret = API_OK;
+    AiUInt32 i;
+
+    if(!demux)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    deadline = ai_clock_us() + timeout_us;
+
+    for(i = 0; i < API429_REPLAY_DEMUX_CHANNELS && ret == API_OK; i++)
+    {
+        if(!demux->outputs[i].stream)
+        {
+            continue;
+        }
+
+        now = ai_clock_us();
+        ret = api429_replay_stream_wait(demux->outputs[i].stream, now < deadline ? (AiUInt32) (deadline - now) : 0);
+    }
+
+    return ret;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYDEMUX_H_ */
@@ -0,0 +1,279 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayIndex.h
+ *
+ *  This header file contains inline helper functions
+ *  for starting the replay of a recording file at a given time
+ */
+
+#ifndef API429REPLAYINDEX_H_
+#define API429REPLAYINDEX_H_
+
+
+#include <stdlib.h>
+
+#include "Api429.h"
+#include "Api429ReplayStream.h"
+#include "Api429Timing.h"
+
+
+/**
+* \defgroup replay_index Replay Index
+  This module builds an index of a recording file, that maps the time since the first entry to a file offset. \n
+  The index is built with a single pass over the memory mapped file and holds one point per interval,
+  so \ref api429_replay_index_seek only needs a binary search and a short scan to position the file
+  at any time of the recording. \n
+  Times are counted from the first entry on a continuous time line, so recordings that pass midnight
+  or last longer than a day are indexed correctly, as long as no two consecutive entries are more than 12 hours apart.
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_INDEX_INTERVAL_US
+ * Default time between two points of an index
+ */
+#define API429_REPLAY_INDEX_INTERVAL_US     1000000
+
+
+
+/*! \struct api429_replay_index_point
+ *
+ * This structure describes a point of a recording index
+ */
+struct api429_replay_index_point
+{
+    AiInt64 time_us;        /*!< Time of the entry since the first entry of the recording */
+    AiUInt64 offset;        /*!< File offset of the entry */
+};
+
+/*! \typedef TY_API429_REPLAY_INDEX_POINT
+ * Convenience typedef for \ref api429_replay_index_point
+ */
+typedef struct api429_replay_index_point TY_API429_REPLAY_INDEX_POINT;
+
+
+/*! \struct api429_replay_index
+ *
+ * This structure holds the index of a recording file.
+ * It is created with \ref api429_replay_index_build
+ */
+struct api429_replay_index
+{
+    struct api429_replay_index_point* points;   /*!< Points in ascending order of time */
+    AiUInt32 count;                             /*!< Number of points */
+    AiUInt32 interval_us;                       /*!< Time between two points */
+    AiInt64 start_us;                           /*!< Recorded time of day of the first entry */
+    AiInt64 duration_us;                        /*!< Time of the last entry since the first entry */
+    AiUInt64 entries;                           /*!< Number of entries of the recording */
+};
+
+/*! \typedef TY_API429_REPLAY_INDEX
+ * Convenience typedef for \ref api429_replay_index
+ */
+typedef struct api429_replay_index TY_API429_REPLAY_INDEX;
+
+
+
+
+/*! \brief Release a recording index
+ *
+ * @param index index to release. May be NULL
+ */
+static AI_INLINE void api429_replay_index_free(struct api429_replay_index* index)
+{
+    if(!index)
+    {
+        return;
+    }
+
+    free(index->points);
+    free(index);
+}
+
+
+/*! \brief Build the index of a recording file
+ *
+ * @param [in] file the recording file. The position of the file is not modified
+ * @param [in] interval_us time between two points of the index, e.g. \ref API429_REPLAY_INDEX_INTERVAL_US
+ * @param [out] index_out the created index is stored here. Must be released with \ref api429_replay_index_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_index_build(const struct api429_replay_file* file, AiUInt32 interval_us,
+                                                    struct api429_replay_index** index_out)
+{
+    const struct api429_rcv_stack_entry* entries;
+    struct api429_replay_index_point* points;
+    struct api429_replay_index* index;
+    AiUInt32 capacity = 1024;
+    AiInt64 time, last, elapsed = 0, next = 0;
+    AiUInt64 count, i;
+
+    if(!file || !index_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *index_out = NULL;
+
+    if(!interval_us)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    index = (struct api429_replay_index*) calloc(1, sizeof(struct api429_replay_index));
+    if(!index)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    index->points = (struct api429_replay_index_point*) malloc(capacity * sizeof(struct api429_replay_index_point));
+    if(!index->points)
+    {
+        api429_replay_index_free(index);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    index->interval_us = interval_us;
+
+    entries = (const struct api429_rcv_stack_entry*) (const void*) file->map->data;
+    count   = file->map->size / API429_REPLAY_ENTRY_SIZE;
+    last    = count ? api429_timing_tm_tag_us(entries[0].tm_tag, entries[0].brw) : 0;
+
+    index->start_us = last;
+    index->entries  = count;
+
+    for(i = 0; i < count; i++)
+    {
+        time     = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+        elapsed += api429_timing_diff_us(time, last);
+        last     = time;
+
+        if(elapsed < next)
+        {
+            continue;
+        }
+
+        if(index->count == capacity)
+        {
+            points = (struct api429_replay_index_point*) realloc(index->points, capacity * 2 * sizeof(struct api429_replay_index_point));
+            if(!points)
+            {
+                api429_replay_index_free(index);
+                return AI429_ERR_NO_MORE_MEMORY;
+            }
+
+            index->points = points;
+            capacity     *= 2;
+        }
+
+        index->points[index->count].time_us = elapsed;
+        index->points[index->count].offset  = i * API429_REPLAY_ENTRY_SIZE;
+        index->count++;
+
+        /* Skip intervals without entries */
+        next = elapsed - elapsed % interval_us + interval_us;
+    }
+
+    index->duration_us = elapsed;
+
+    *index_out = index;
+
+    return API_OK;
+}
+
+
+/*! \brief Position a recording file at a given time
+ *
+ * The next chunk read from the file starts with the first entry at or after 'time_us'.
+ * When the file is replayed through a \ref api429_replay_transform, call \ref api429_replay_transform_reset afterwards.
+ * Must not be called while the file is replayed.
+ * @param [in] index index of the recording file
+ * @param [in] file the recording file the index was built from
+ * @param [in] time_us time since the first entry of the recording
+ * @param [out] time_out time of the entry the file is positioned at is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_PARAMETER_RANGE if 'time_us' is beyond the end of the recording
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_index_seek(const struct api429_replay_index* index, struct api429_replay_file* file, AiInt64 time_us,
+                                                   AiInt64* time_out)
+{
+    const struct api429_rcv_stack_entry* entries;
+    AiUInt32 low, high, mid;
+    AiInt64 time, last, elapsed;
+    AiUInt64 count, i;
+
+    if(!index || !file)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(!index->count || time_us > index->duration_us)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    /* Find the last point at or before the requested time */
+    low  = 0;
+    high = index->count - 1;
+
+    while(low < high)
+    {
+        mid = (low + high + 1) / 2;
+
+        if(index->points[mid].time_us <= time_us)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    entries = (const struct api429_rcv_stack_entry*) (const void*) file->map->data;
+    count   = file->map->size / API429_REPLAY_ENTRY_SIZE;
+    i       = index->points[low].offset / API429_REPLAY_ENTRY_SIZE;
+    elapsed = index->points[low].time_us;
+    last    = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+
+    /* Scan from the point to the requested entry */
+    for(; i < count; i++)
+    {
+        time     = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+        elapsed += api429_timing_diff_us(time, last);
+        last     = time;
+
+        if(elapsed >= time_us)
+        {
+            break;
+        }
+    }
+
+    if(time_out)
+    {
+        *time_out = elapsed;
+    }
+
+    return api429_replay_file_seek(file, i * API429_REPLAY_ENTRY_SIZE);
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYINDEX_H_ */
@@ -0,0 +1,293 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayLoop.h
+ *
+ *  This header file contains inline helper functions
+ *  for replaying a recording file repeatedly
+ */
+
+#ifndef API429REPLAYLOOP_H_
+#define API429REPLAYLOOP_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429ReplayStream.h"
+#include "Api429Timing.h"
+#include "Ai_container.h"
+
+
+/**
+* \defgroup replay_loop Looping Replay
+  This module replays a recording file over and over, e.g. for endurance tests that run for days on a short recording. \n
+  The cyclic mode of \ref Api429ReplayInit only repeats the data in the replay buffer of the board.
+  A loop (\ref api429_replay_loop) instead is a \ref api429_replay_source that rewinds the file on the host
+  when it reaches its end, and continues in the same chunk. So every half buffer is filled completely,
+  also across the seam, and \ref api429_replay_stream keeps the board supplied without a gap. \n
+  The time tags of each loop are rebased, so the first entry of a loop follows the last entry of the previous loop
+  after a configurable gap, and time tags keep increasing from loop to loop.
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_LOOP_ENDLESS
+ * Number of loops that repeats the recording until the replay is stopped
+ */
+#define API429_REPLAY_LOOP_ENDLESS      0
+
+
+
+
+/*! \struct api429_replay_loop_status
+ *
+ * This structure reports the progress of a loop
+ */
+struct api429_replay_loop_status
+{
+    AiUInt64 loop;          /*!< Index of the current loop, starting with 0 */
+    AiUInt64 entries;       /*!< Number of entries delivered */
+    AiInt64 duration_us;    /*!< Time from the first to the last entry of the recording. Known after the first loop */
+    AiInt64 time_us;        /*!< Time of the last delivered entry since the first entry of the first loop */
+};
+
+/*! \typedef TY_API429_REPLAY_LOOP_STATUS
+ * Convenience typedef for \ref api429_replay_loop_status
+ */
+typedef struct api429_replay_loop_status TY_API429_REPLAY_LOOP_STATUS;
+
+
+/*! \struct api429_replay_loop
+ *
+ * This structure holds a loop over a recording file.
+ * It is created with \ref api429_replay_loop_create
+ */
+struct api429_replay_loop
+{
+    struct api429_replay_source source;                         /*!< The looping replay source */
+    struct api429_replay_file* file;                            /*!< The recording file */
+    struct api429_replay_reader input;                          /*!< Reader of the recording file */
+    AiUInt64 loops;                                             /*!< Number of loops, or \ref API429_REPLAY_LOOP_ENDLESS */
+    AiInt64 gap_us;                                             /*!< Time from the last entry of a loop to the first entry of the next loop */
+    AiBoolean time_started;                                     /*!< AiTrue if the first entry of the current loop was seen */
+    AiInt64 time_first;                                         /*!< Recorded time of day of the first entry */
+    AiInt64 time_last;                                          /*!< Recorded time of day of the previous entry */
+    AiInt64 time_elapsed;                                       /*!< Recorded time of the previous entry since the first entry of the loop */
+    AiInt64 time_base;                                          /*!< Time of the first entry of the current loop since the first entry of the first loop */
+    struct api429_replay_batch batch;                           /*!< Rebased entries not yet delivered */
+    struct api429_replay_loop_status status;                    /*!< Progress */
+};
+
+/*! \typedef TY_API429_REPLAY_LOOP
+ * Convenience typedef for \ref api429_replay_loop
+ */
+typedef struct api429_replay_loop TY_API429_REPLAY_LOOP;
+
+
+
+
+/*! \brief Rebase the time tags of a batch of entries to the current loop
+ *
+ * @return number of entries stored to 'out'
+ */
+static AI_INLINE AiUInt32 api429_replay_loop_batch(struct api429_replay_loop* loop, const struct api429_rcv_stack_entry* in, AiUInt32 count,
+                                                   struct api429_rcv_stack_entry* out)
+{
+    AiInt64 time;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        time = api429_timing_tm_tag_us(in[i].tm_tag, in[i].brw);
+
+        if(!loop->time_started)
+        {
+            loop->time_first   = loop->status.loop ? loop->time_first : time;
+            loop->time_last    = time;
+            loop->time_elapsed = 0;
+            loop->time_started = AiTrue;
+        }
+
+        loop->time_elapsed += api429_timing_diff_us(time, loop->time_last);
+        loop->time_last     = time;
+
+        time = loop->time_first + loop->time_base + loop->time_elapsed;
+
+        out[i] = in[i];
+        api429_timing_tm_tag_set(&out[i].tm_tag, &out[i].brw, time);
+    }
+
+    loop->status.entries += count;
+    loop->status.time_us  = loop->time_base + loop->time_elapsed;
+
+    return count;
+}
+
+
+/*! \brief Batch function of a loop
+ *
+ * Rewinds the file at its end, so the next loop continues in the same chunk.
+ */
+static AiReturn AI_CALL_CONV api429_replay_loop_fill(void* context, struct api429_rcv_stack_entry* out, AiUInt32* count)
+{
+    struct api429_replay_loop* loop = (struct api429_replay_loop*) context;
+    const struct api429_rcv_stack_entry* entries;
+    AiUInt32 n;
+    AiReturn ret;
+
+    *count = 0;
+
+    for(;;)
+    {
+        ret = api429_replay_reader_next(&loop->input, &entries, &n);
+        if(ret != API_OK || n)
+        {
+            break;
+        }
+
+        if(!loop->time_started || (loop->loops != API429_REPLAY_LOOP_ENDLESS && loop->status.loop + 1 >= loop->loops))
+        {
+            return API_OK;
+        }
+
+        /* Continue with the beginning of the recording */
+        loop->status.duration_us = loop->time_elapsed;
+        loop->time_base         += loop->time_elapsed + loop->gap_us;
+        loop->time_started       = AiFalse;
+        loop->status.loop++;
+
+        api429_replay_file_rewind(loop->file);
+        api429_replay_reader_init(&loop->input, &loop->file->source, loop->input.read_size);
+    }
+
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    n = n < API429_REPLAY_BATCH_SIZE ? n : API429_REPLAY_BATCH_SIZE;
+
+    *count = api429_replay_loop_batch(loop, entries, n, out);
+
+    api429_replay_reader_consume(&loop->input, n);
+
+    return API_OK;
+}
+
+
+/*! \brief Read function of a loop
+ */
+static AiReturn AI_CALL_CONV api429_replay_loop_read(struct api429_replay_source* source, AiUInt32 size, struct api429_replay_chunk* chunk)
+{
+    struct api429_replay_loop* loop = AI_CONTAINER_OF(source, struct api429_replay_loop, source);
+
+    return api429_replay_batch_read(&loop->batch, size, chunk, api429_replay_loop_fill, loop);
+}
+
+
+/*! \brief Release a loop
+ *
+ * The recording file is not released.
+ * @param loop loop to release. May be NULL
+ */
+static AI_INLINE void api429_replay_loop_free(struct api429_replay_loop* loop)
+{
+    if(!loop)
+    {
+        return;
+    }
+
+    api429_replay_batch_free(&loop->batch);
+    free(loop);
+}
+
+
+/*! \brief Create a loop over a recording file
+ *
+ * The file is rewound, so each loop replays the whole recording.
+ * @param [in] file the recording file. Must stay valid until the loop is released
+ * @param [in] loops number of times the recording is replayed, or \ref API429_REPLAY_LOOP_ENDLESS
+ * @param [in] gap_us time from the last entry of a loop to the first entry of the next loop.
+ *                    Should be at least one word time at the channel speed
+ * @param [out] loop_out the created loop is stored here. Must be released with \ref api429_replay_loop_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_loop_create(struct api429_replay_file* file, AiUInt64 loops, AiUInt32 gap_us,
+                                                    struct api429_replay_loop** loop_out)
+{
+    struct api429_replay_loop* loop;
+    AiUInt64 size;
+
+    if(!file || !loop_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *loop_out = NULL;
+
+    loop = (struct api429_replay_loop*) calloc(1, sizeof(struct api429_replay_loop));
+    if(!loop)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    api429_replay_file_rewind(file);
+    api429_replay_reader_init(&loop->input, &file->source, API429_REPLAY_BATCH_SIZE * API429_REPLAY_ENTRY_SIZE);
+
+    size = file->map->size - file->map->size % API429_REPLAY_ENTRY_SIZE;
+
+    loop->file            = file;
+    loop->loops           = loops;
+    loop->gap_us          = gap_us;
+    loop->source.read     = api429_replay_loop_read;
+    loop->source.prefetch = NULL;
+    loop->source.size     = loops == API429_REPLAY_LOOP_ENDLESS || (size && loops > API429_REPLAY_SIZE_UNKNOWN / size - 1)
+                          ? API429_REPLAY_SIZE_UNKNOWN : size * loops;
+
+    *loop_out = loop;
+
+    return API_OK;
+}
+
+
+/*! \brief Get the progress of a loop
+ *
+ * While the replay is running, the progress is updated by the prefetch thread of the replay stream,
+ * so the values may be slightly behind.
+ * @param [in] loop the loop
+ * @param [out] status the progress is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_loop_status(const struct api429_replay_loop* loop, struct api429_replay_loop_status* status)
+{
+    if(!loop || !status)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *status = loop->status;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYLOOP_H_ */
@@ -0,0 +1,1410 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayStream.h
+ *
+ *  This header file contains inline helper functions
+ *  for streaming recordings of any size to a physical replay channel
+ */
+
+#ifndef API429REPLAYSTREAM_H_
+#define API429REPLAYSTREAM_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_container.h"
+#include "Ai_filemap.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup replay_stream Replay Streaming
+  This module feeds a channel initialized with \ref API429_TX_MODE_PHYS_REPLAY from a replay source. \n
+  A replay source (\ref api429_replay_source) delivers the replay data in chunks of one half buffer.
+  \ref api429_replay_file_open provides a source that maps a recording file into memory,
+  so chunks point directly into the file and are passed to \ref Api429ReplayDataWrite without intermediate copies. \n
+  A prefetch thread always keeps the next chunk ready and touches its pages in advance.
+  When \ref API429_EVENT_REPLAY_HALF_BUFFER is passed to \ref api429_replay_stream_event, the ready chunk is written
+  to the free half buffer immediately from the event handler, without waiting for the file system. \n
+  Recordings larger than 4 GB, or sources of unknown size, are replayed with the replay entry counter disabled.
+  The board then goes on replaying half buffers after the last entry, so everything behind the last entry is overwritten
+  with filler entries, which are timed \ref API429_REPLAY_STREAM_FILLER_GAP_US after the last entry. If the last chunk fills its
+  half buffer, the next half buffer is filled completely. The time the last entry is sent is calculated from the time tags,
+  relative to the last half buffer interrupt, and the channel is halted shortly afterwards, before any filler entry is sent.
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_SIZE_UNKNOWN
+ * Size of a replay source that does not know its size in advance
+ */
+#define API429_REPLAY_SIZE_UNKNOWN      (~(AiUInt64) 0)
+
+/*! \def API429_REPLAY_STREAM_POLL_US
+ * Interval in which \ref api429_replay_stream_wait checks the replay status
+ */
+#define API429_REPLAY_STREAM_POLL_US    10000
+
+/*! \def API429_REPLAY_STREAM_FILLER_GAP_US
+ * Time between the last entry and the filler entries following it, if the replay entry counter is disabled.
+ * The channel must be halted within this time after the last entry was sent
+ */
+#define API429_REPLAY_STREAM_FILLER_GAP_US  60000000
+
+/*! \def API429_REPLAY_STREAM_HALT_MARGIN_US
+ * Time the channel is halted after the last entry was sent at the latest, if the replay entry counter is disabled
+ */
+#define API429_REPLAY_STREAM_HALT_MARGIN_US 10000
+
+/*! \def API429_REPLAY_FILE_READ_AHEAD
+ * Number of bytes the operating system is asked to read ahead after a replay file was positioned
+ */
+#define API429_REPLAY_FILE_READ_AHEAD   0x40000
+
+/*! \def API429_REPLAY_ENTRY_SIZE
+ * Size of one entry of a recording in bytes
+ */
+#define API429_REPLAY_ENTRY_SIZE        ((AiUInt32) sizeof(struct api429_rcv_stack_entry))
+
+/*! \def API429_REPLAY_BATCH_SIZE
+ * Number of entries a batch source processes at once
+ */
+#define API429_REPLAY_BATCH_SIZE        1024
+
+
+
+/*! \struct api429_replay_chunk
+ *
+ * This structure describes a chunk of replay data
+ */
+struct api429_replay_chunk
+{
+    const void* data;       /*!< Start of the replay data */
+    AiUInt32 size;          /*!< Size of the replay data in bytes. 0 at the end of the source */
+};
+
+/*! \typedef TY_API429_REPLAY_CHUNK
+ * Convenience typedef for \ref api429_replay_chunk
+ */
+typedef struct api429_replay_chunk TY_API429_REPLAY_CHUNK;
+
+
+struct api429_replay_source;
+
+/*! \typedef API429_REPLAY_SOURCE_READ
+ * Prototype of a function that delivers the next chunk of a replay source. \n
+ * The chunk must not be larger than 'size' and must only be shorter at the end of the source.
+ * It must stay valid until the function is called the next time.
+ */
+typedef AiReturn (AI_CALL_CONV *API429_REPLAY_SOURCE_READ)(struct api429_replay_source* source, AiUInt32 size,
+                                                            struct api429_replay_chunk* chunk);
+
+/*! \typedef API429_REPLAY_SOURCE_PREFETCH
+ * Prototype of a function that makes sure a chunk can be accessed without blocking
+ */
+typedef void (AI_CALL_CONV *API429_REPLAY_SOURCE_PREFETCH)(struct api429_replay_source* source, const struct api429_replay_chunk* chunk);
+
+
+/*! \struct api429_replay_source
+ *
+ * This structure describes a source of replay data. \n
+ * It is embedded into the structure of the actual source, which can be retrieved with \ref AI_CONTAINER_OF.
+ */
+struct api429_replay_source
+{
+    API429_REPLAY_SOURCE_READ read;             /*!< Delivers the next chunk */
+    API429_REPLAY_SOURCE_PREFETCH prefetch;     /*!< Prefetches a chunk. May be NULL */
+    AiUInt64 size;                              /*!< Total number of bytes the source delivers, or \ref API429_REPLAY_SIZE_UNKNOWN */
+};
+
+/*! \typedef TY_API429_REPLAY_SOURCE
+ * Convenience typedef for \ref api429_replay_source
+ */
+typedef struct api429_replay_source TY_API429_REPLAY_SOURCE;
+
+
+/*! \struct api429_replay_file
+ *
+ * This structure holds a replay source that reads a memory mapped recording file.
+ * The file contains replay entries in the format of \ref api429_rcv_stack_entry.
+ */
+struct api429_replay_file
+{
+    struct api429_replay_source source;         /*!< The replay source */
+    struct ai_filemap* map;                     /*!< The mapped file */
+    AiUInt64 offset;                            /*!< Offset of the next chunk */
+};
+
+/*! \typedef TY_API429_REPLAY_FILE
+ * Convenience typedef for \ref api429_replay_file
+ */
+typedef struct api429_replay_file TY_API429_REPLAY_FILE;
+
+
+/*! \struct api429_replay_reader
+ *
+ * This structure holds a cursor that reads whole entries from a replay source.
+ * Entries split across two chunks of the source are assembled in 'entry', all others are accessed in place.
+ */
+struct api429_replay_reader
+{
+    struct api429_replay_source* source;        /*!< Source of the entries */
+    AiUInt32 read_size;                         /*!< Number of bytes requested from the source at once */
+    struct api429_replay_chunk chunk;           /*!< Current chunk of the source */
+    AiUInt32 offset;                            /*!< Bytes of 'chunk' already consumed */
+    struct api429_rcv_stack_entry entry;        /*!< Entry being assembled */
+    AiUInt32 entry_fill;                        /*!< Number of bytes in 'entry' */
+    AiUInt64 bytes;                             /*!< Number of bytes read from the source */
+    AiBoolean end;                              /*!< AiTrue if the source is exhausted */
+};
+
+/*! \typedef TY_API429_REPLAY_READER
+ * Convenience typedef for \ref api429_replay_reader
+ */
+typedef struct api429_replay_reader TY_API429_REPLAY_READER;
+
+
+/*! \typedef API429_REPLAY_BATCH_FILL
+ * Prototype of a function that produces the next batch of entries of a batch source. \n
+ * Stores up to \ref API429_REPLAY_BATCH_SIZE entries to 'out' and their number to 'count', 0 at the end of the source.
+ */
+typedef AiReturn (AI_CALL_CONV *API429_REPLAY_BATCH_FILL)(void* context, struct api429_rcv_stack_entry* out, AiUInt32* count);
+
+
+/*! \struct api429_replay_batch
+ *
+ * This structure holds the buffers of a replay source that produces its entries in batches, e.g. by modifying the entries of another source.
+ * The batches are cut into chunks by \ref api429_replay_batch_read.
+ */
+struct api429_replay_batch
+{
+    struct api429_rcv_stack_entry work[API429_REPLAY_BATCH_SIZE]; /*!< Entries of the current batch */
+    AiUInt32 work_bytes;                                        /*!< Number of valid bytes in 'work' */
+    AiUInt32 work_offset;                                       /*!< Number of bytes of 'work' already delivered */
+    AiUInt8* buffers[2];                                        /*!< Alternating buffers of the delivered chunks */
+    AiUInt32 buffer_size;                                       /*!< Size of each buffer in bytes */
+    AiUInt32 current;                                           /*!< Index of the buffer delivered last */
+};
+
+/*! \typedef TY_API429_REPLAY_BATCH
+ * Convenience typedef for \ref api429_replay_batch
+ */
+typedef struct api429_replay_batch TY_API429_REPLAY_BATCH;
+
+
+/*! \struct api429_replay_stream_setup
+ *
+ * This structure holds the parameters of \ref Api429ReplayInit that are not determined by the replay source
+ */
+struct api429_replay_stream_setup
+{
+    AiUInt8 clr_entry_bit;      /*!< Clear Entry Bit */
+    AiUInt8 rep_errors;         /*!< Replay Errors */
+    AiUInt8 rep_int_mode;       /*!< Replay Interrupt Control. Must enable the half buffer interrupt */
+    AiUInt8 abs_long_ttag;      /*!< Absolute Long Time Tag Replay */
+    AiUInt16 day_of_year;       /*!< Original start day of the recording */
+    AiInt32 min;                /*!< Absolute minute offset */
+    AiInt32 msec;               /*!< Absolute microsecond offset */
+};
+
+/*! \typedef TY_API429_REPLAY_STREAM_SETUP
+ * Convenience typedef for \ref api429_replay_stream_setup
+ */
+typedef struct api429_replay_stream_setup TY_API429_REPLAY_STREAM_SETUP;
+
+
+/*! \struct api429_replay_stream_status
+ *
+ * This structure reports the progress of a replay stream
+ */
+struct api429_replay_stream_status
+{
+    AiUInt64 bytes_written;     /*!< Number of bytes written to the board */
+    AiUInt64 halves_written;    /*!< Number of half buffers written to the board */
+    AiUInt64 halves_sent;       /*!< Number of half buffer interrupts */
+    AiUInt64 late;              /*!< Number of half buffers that were not prefetched in time */
+    AiUInt64 missed;            /*!< Number of half buffer interrupts that were not handled in time */
+    AiUInt64 prefetch_max_us;   /*!< Longest time needed to read and prefetch a chunk */
+    AiBoolean end;              /*!< AiTrue if the whole source was written */
+    AiBoolean finished;         /*!< AiTrue if the replay stopped */
+};
+
+/*! \typedef TY_API429_REPLAY_STREAM_STATUS
+ * Convenience typedef for \ref api429_replay_stream_status
+ */
+typedef struct api429_replay_stream_status TY_API429_REPLAY_STREAM_STATUS;
+
+
+/*! \struct api429_replay_stream
+ *
+ * This structure holds a replay stream of one channel.
+ * It is created with \ref api429_replay_stream_create
+ */
+struct api429_replay_stream
+{
+    AiUInt8 board_handle;                       /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                            /*!< ID of the replay channel */
+    struct api429_replay_source* source;        /*!< Source of the replay data */
+    struct api429_replay_stream_setup setup;    /*!< Replay parameters */
+    AiBoolean counted;                          /*!< AiTrue if the board stops on its own after the source size */
+    AiUInt32 half_size;                         /*!< Size of a half buffer in bytes */
+    AiUInt8* staging;                           /*!< Buffer for filling the half buffer behind the last entry */
+    AiUInt8 entry[API429_REPLAY_ENTRY_SIZE];    /*!< Bytes of the entry that is split across the written chunks */
+    AiUInt32 entry_fill;                        /*!< Number of bytes in 'entry' */
+    struct api429_rcv_stack_entry last;         /*!< Last complete entry written */
+    AiUInt64 entries;                           /*!< Number of complete entries written */
+    AiInt64 half_tag_us[2];                     /*!< Time tag of the last complete entry at the end of the last two half buffers written */
+    AiInt64 ref_tag_us;                         /*!< Time tag of an entry that is known to be sent */
+    AiUInt64 ref_host_us;                       /*!< Host time when the entry of 'ref_tag_us' was sent at the latest */
+    AiBoolean ref_valid;                        /*!< AiTrue if 'ref_tag_us' and 'ref_host_us' are set */
+    AiBoolean padded;                           /*!< AiTrue if a complete filler entry follows the last entry on the board */
+    struct api429_replay_chunk chunk;           /*!< Next chunk to write, if 'ready' is set. Empty for a half buffer of filler entries */
+    AiBoolean ready;                            /*!< AiTrue if 'chunk' is prefetched */
+    AiBoolean pending;                          /*!< AiTrue if the board has a free half buffer that was not written yet */
+    AiUInt32 rpi_last;                          /*!< Value of ul_RpiCnt at the last half buffer interrupt */
+    struct api429_replay_stream_status status;  /*!< Progress of the stream */
+    struct ai_mutex* lock;                      /*!< Serializes the event handler and the prefetch thread */
+    struct ai_event* wake;                      /*!< Wakes the prefetch thread */
+    struct ai_event* done;                      /*!< Signalled when the replay stopped or an error occurred */
+    struct ai_thread* thread;                   /*!< Prefetch thread */
+    volatile AiUInt32 stop;                     /*!< Set to stop the prefetch thread */
+    volatile AiUInt32 error;                    /*!< First error that occurred */
+};
+
+/*! \typedef TY_API429_REPLAY_STREAM
+ * Convenience typedef for \ref api429_replay_stream
+ */
+typedef struct api429_replay_stream TY_API429_REPLAY_STREAM;
+
+
+
+
+/*! \brief Read function of a replay file
+ */
+static AiReturn AI_CALL_CONV api429_replay_file_read(struct api429_replay_source* source, AiUInt32 size, struct api429_replay_chunk* chunk)
+{
+    struct api429_replay_file* file = AI_CONTAINER_OF(source, struct api429_replay_file, source);
+    AiUInt64 left = file->map->size - file->offset;
+
+    chunk->data = file->map->data + file->offset;
+    chunk->size = left < size ? (AiUInt32) left : size;
+
+    file->offset += chunk->size;
+
+    /* Let the operating system read ahead the chunk after this one */
+    ai_filemap_advise(file->map, file->offset, size);
+
+    return API_OK;
+}
+
+
+/*! \brief Prefetch function of a replay file
+ */
+static void AI_CALL_CONV api429_replay_file_prefetch(struct api429_replay_source* source, const struct api429_replay_chunk* chunk)
+{
+    struct api429_replay_file* file = AI_CONTAINER_OF(source, struct api429_replay_file, source);
+
+    if(chunk->size)
+    {
+        ai_filemap_touch(file->map, (AiUInt64) ((const AiUInt8*) chunk->data - file->map->data), chunk->size);
+    }
+}
+
+
+/*! \brief Close a replay file
+ *
+ * @param file the replay file. May be NULL
+ */
+static AI_INLINE void api429_replay_file_close(struct api429_replay_file* file)
+{
+    if(!file)
+    {
+        return;
+    }
+
+    ai_filemap_close(file->map);
+    free(file);
+}
+
+
+/*! \brief Open a recording file as replay source
+ *
+ * @param [in] path path of the recording file
+ * @param [out] file_out the opened file is stored here. Must be released with \ref api429_replay_file_close
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_file_open(const char* path, struct api429_replay_file** file_out)
+{
+    struct api429_replay_file* file;
+
+    if(!path || !file_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *file_out = NULL;
+
+    file = (struct api429_replay_file*) calloc(1, sizeof(struct api429_replay_file));
+    if(!file)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    file->map = ai_filemap_open(path);
+    if(!file->map)
+    {
+        free(file);
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    file->source.read     = api429_replay_file_read;
+    file->source.prefetch = api429_replay_file_prefetch;
+    file->source.size     = file->map->size;
+
+    *file_out = file;
+
+    return API_OK;
+}
+
+
+/*! \brief Position a replay file
+ *
+ * The size of the source is reduced to the bytes following the position.
+ * @param [in] file the replay file
+ * @param [in] offset offset of the next chunk in bytes. Should be a multiple of \ref API429_REPLAY_ENTRY_SIZE
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_file_seek(struct api429_replay_file* file, AiUInt64 offset)
+{
+    if(!file)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(offset > file->map->size)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    file->offset      = offset;
+    file->source.size = file->map->size - offset;
+
+    ai_filemap_advise(file->map, offset, API429_REPLAY_FILE_READ_AHEAD);
+
+    return API_OK;
+}
+
+
+/*! \brief Rewind a replay file to its beginning
+ *
+ * @param [in] file the replay file
+ */
+static AI_INLINE void api429_replay_file_rewind(struct api429_replay_file* file)
+{
+    api429_replay_file_seek(file, 0);
+}
+
+
+/*! \brief Initialize a reader of replay entries
+ *
+ * @param [out] reader the reader to initialize
+ * @param [in] source source to read entries from
+ * @param [in] read_size number of bytes to request from the source at once. Rounded down to whole entries
+ */
+static AI_INLINE void api429_replay_reader_init(struct api429_replay_reader* reader, struct api429_replay_source* source, AiUInt32 read_size)
+{
+    memset(reader, 0, sizeof(*reader));
+
+    reader->source    = source;
+    reader->read_size = read_size - read_size % API429_REPLAY_ENTRY_SIZE;
+    reader->read_size = reader->read_size ? reader->read_size : API429_REPLAY_ENTRY_SIZE;
+}
+
+
+/*! \brief Get the next entries of a replay source
+ *
+ * Returns a run of consecutive entries without copying them.
+ * The entries stay valid until \ref api429_replay_reader_consume is called.
+ * A partial entry at the end of the source is discarded.
+ * @param [in] reader the reader
+ * @param [out] entries start of the run is stored here
+ * @param [out] count number of entries in the run is stored here. 0 at the end of the source
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_reader_next(struct api429_replay_reader* reader, const struct api429_rcv_stack_entry** entries,
+                                                    AiUInt32* count)
+{
+    AiUInt32 avail;
+    AiReturn ret;
+
+    *count = 0;
+
+    for(;;)
+    {
+        if(reader->entry_fill == API429_REPLAY_ENTRY_SIZE)
+        {
+            *entries = &reader->entry;
+            *count   = 1;
+            return API_OK;
+        }
+
+        avail = reader->chunk.size - reader->offset;
+
+        if(!reader->entry_fill && avail >= API429_REPLAY_ENTRY_SIZE)
+        {
+            *entries = (const struct api429_rcv_stack_entry*) (const void*) ((const AiUInt8*) reader->chunk.data + reader->offset);
+            *count   = avail / API429_REPLAY_ENTRY_SIZE;
+            return API_OK;
+        }
+
+        if(avail)
+        {
+            /* Entry split across chunks */
+            avail = API429_REPLAY_ENTRY_SIZE - reader->entry_fill < avail ? API429_REPLAY_ENTRY_SIZE - reader->entry_fill : avail;
+
+            memcpy((AiUInt8*) &reader->entry + reader->entry_fill, (const AiUInt8*) reader->chunk.data + reader->offset, avail);
+            reader->entry_fill += avail;
+            reader->offset     += avail;
+            continue;
+        }
+
+        if(reader->end)
+        {
+            return API_OK;
+        }
+
+        ret = reader->source->read(reader->source, reader->read_size, &reader->chunk);
+        if(ret != API_OK)
+        {
+            reader->chunk.size = 0;
+            return ret;
+        }
+
+        reader->offset = 0;
+        reader->bytes += reader->chunk.size;
+        reader->end    = reader->chunk.size ? AiFalse : AiTrue;
+    }
+}
+
+
+/*! \brief Consume entries returned by \ref api429_replay_reader_next
+ *
+ * @param [in] reader the reader
+ * @param [in] count number of entries to consume. Must not exceed the count of the last run
+ */
+static AI_INLINE void api429_replay_reader_consume(struct api429_replay_reader* reader, AiUInt32 count)
+{
+    if(reader->entry_fill == API429_REPLAY_ENTRY_SIZE)
+    {
+        reader->entry_fill = count ? 0 : reader->entry_fill;
+        return;
+    }
+
+    reader->offset += count * API429_REPLAY_ENTRY_SIZE;
+}
+
+
+/*! \brief Deliver the next chunk of a batch source
+ *
+ * Fills a chunk of 'size' bytes from the batches produced by 'fill'. Entries may be split across chunks.
+ * To be called from the read function of the source.
+ * @param [in] batch the buffers of the source. Zero initialized before the first call
+ * @param [in] size maximum size of the chunk in bytes
+ * @param [out] chunk the chunk is stored here. It stays valid until the next call
+ * @param [in] fill function that produces the next batch
+ * @param [in] context passed to 'fill'
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_batch_read(struct api429_replay_batch* batch, AiUInt32 size, struct api429_replay_chunk* chunk,
+                                                   API429_REPLAY_BATCH_FILL fill, void* context)
+{
+    AiUInt8* buffer;
+    AiUInt32 filled = 0;
+    AiUInt32 count;
+    AiReturn ret;
+
+    chunk->size = 0;
+
+    if(size > batch->buffer_size)
+    {
+        free(batch->buffers[0]);
+        free(batch->buffers[1]);
+
+        batch->buffers[0]  = (AiUInt8*) malloc(size);
+        batch->buffers[1]  = (AiUInt8*) malloc(size);
+        batch->buffer_size = batch->buffers[0] && batch->buffers[1] ? size : 0;
+
+        if(!batch->buffer_size)
+        {
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+    }
+
+    /* The previous chunk stays valid while this one is filled */
+    batch->current ^= 1;
+    buffer = batch->buffers[batch->current];
+
+    while(filled < size)
+    {
+        if(batch->work_offset < batch->work_bytes)
+        {
+            count = batch->work_bytes - batch->work_offset;
+            count = size - filled < count ? size - filled : count;
+
+            memcpy(buffer + filled, (const AiUInt8*) batch->work + batch->work_offset, count);
+            filled             += count;
+            batch->work_offset += count;
+            continue;
+        }
+
+        ret = fill(context, batch->work, &count);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        if(!count)
+        {
+            break;
+        }
+
+        batch->work_bytes  = count * API429_REPLAY_ENTRY_SIZE;
+        batch->work_offset = 0;
+    }
+
+    chunk->data = buffer;
+    chunk->size = filled;
+
+    return API_OK;
+}
+
+
+/*! \brief Release the buffers of a batch source
+ *
+ * @param [in] batch the buffers of the source
+ */
+static AI_INLINE void api429_replay_batch_free(struct api429_replay_batch* batch)
+{
+    free(batch->buffers[0]);
+    free(batch->buffers[1]);
+
+    batch->buffers[0]  = NULL;
+    batch->buffers[1]  = NULL;
+    batch->buffer_size = 0;
+}
+
+
+/*! \brief Initialize replay parameters with default values
+ *
+ * Relative time tags, no error replay and half buffer interrupts enabled.
+ * @param [out] setup the parameters to initialize
+ */
+static AI_INLINE void api429_replay_stream_setup_init(struct api429_replay_stream_setup* setup)
+{
+    memset(setup, 0, sizeof(*setup));
+    setup->rep_int_mode = 1;
+}
+
+
+/*! \brief Stop the prefetch thread and the replay
+ *
+ * @param [in] stream the replay stream
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_stream_stop(struct api429_replay_stream* stream)
+{
+    if(!stream)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(!stream->thread)
+    {
+        return API_OK;
+    }
+
+    ai_atomic_u32_store(&stream->stop, 1);
+    ai_event_signal(stream->wake);
+    ai_thread_join(stream->thread);
+
+    stream->thread = NULL;
+
+    return Api429ChannelHalt(stream->board_handle, stream->channel);
+}
+
+
+/*! \brief Release a replay stream
+ *
+ * Stops the replay. The replay source is not released.
+ * @param stream stream to release. May be NULL
+ */
+static AI_INLINE void api429_replay_stream_free(struct api429_replay_stream* stream)
+{
+    if(!stream)
+    {
+        return;
+    }
+
+    api429_replay_stream_stop(stream);
+
+    if(stream->lock)
+    {
+        ai_mutex_free(stream->lock);
+    }
+
+    if(stream->wake)
+    {
+        ai_event_free(stream->wake);
+    }
+
+    if(stream->done)
+    {
+        ai_event_free(stream->done);
+    }
+
+    free(stream->staging);
+    free(stream);
+}
+
+
+/*! \brief Create a replay stream
+ *
+ * The channel must be initialized with \ref API429_TX_MODE_PHYS_REPLAY.
+ * Register a callback for \ref API429_EVENT_REPLAY_HALF_BUFFER and \ref API429_EVENT_REPLAY_STOP
+ * that calls \ref api429_replay_stream_event.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the replay channel
+ * @param [in] source source of the replay data. Must stay valid until the stream is released
+ * @param [in] setup replay parameters. NULL for defaults, see \ref api429_replay_stream_setup_init
+ * @param [out] stream_out the created stream is stored here. Must be released with \ref api429_replay_stream_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_stream_create(AiUInt8 board_handle, AiUInt8 channel, struct api429_replay_source* source,
+                                                      const struct api429_replay_stream_setup* setup,
+                                                      struct api429_replay_stream** stream_out)
+{
+    struct api429_replay_stream* stream;
+
+    if(!source || !source->read || !stream_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *stream_out = NULL;
+
+    stream = (struct api429_replay_stream*) calloc(1, sizeof(struct api429_replay_stream));
+    if(!stream)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    stream->board_handle = board_handle;
+    stream->channel      = channel;
+    stream->source       = source;
+    stream->lock         = ai_mutex_create();
+    stream->wake         = ai_event_create();
+    stream->done         = ai_event_create();
+
+    if(setup)
+    {
+        stream->setup = *setup;
+    }
+    else
+    {
+        api429_replay_stream_setup_init(&stream->setup);
+    }
+
+    if(!stream->lock || !stream->wake || !stream->done)
+    {
+        api429_replay_stream_free(stream);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *stream_out = stream;
+
+    return API_OK;
+}
+
+
+/*! \brief Record an error and wake up waiting threads
+ */
+static AI_INLINE void api429_replay_stream_fail(struct api429_replay_stream* stream, AiReturn ret)
+{
+    ai_atomic_u32_cas(&stream->error, 0, (AiUInt32) ret);
+    ai_event_signal(stream->done);
+}
+
+
+/*! \brief Read and prefetch the next chunk
+ *
+ * Must be called without the lock held.
+ */
+static AI_INLINE AiReturn api429_replay_stream_prefetch(struct api429_replay_stream* stream, struct api429_replay_chunk* chunk)
+{
+    AiUInt64 start = ai_clock_us();
+    AiUInt64 time;
+    AiReturn ret;
+
+    ret = stream->source->read(stream->source, stream->half_size, chunk);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(stream->source->prefetch && chunk->size)
+    {
+        stream->source->prefetch(stream->source, chunk);
+    }
+
+    time = ai_clock_us() - start;
+    if(time > stream->status.prefetch_max_us)
+    {
+        stream->status.prefetch_max_us = time;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Remember the last complete entry of written replay data
+ *
+ * Entries may be split across chunks, so the bytes of an incomplete entry are kept until the next chunk.
+ * Must be called with the lock held.
+ */
+static AI_INLINE void api429_replay_stream_track(struct api429_replay_stream* stream, const AiUInt8* data, AiUInt32 size)
+{
+    AiUInt8* last = (AiUInt8*) &stream->last;
+    AiUInt32 total = stream->entry_fill + size;
+    AiUInt32 rest  = total % API429_REPLAY_ENTRY_SIZE;
+    AiUInt32 head;
+
+    if(total >= API429_REPLAY_ENTRY_SIZE)
+    {
+        /* The last complete entry may start with the bytes kept from the previous chunk */
+        head = size - rest < API429_REPLAY_ENTRY_SIZE ? API429_REPLAY_ENTRY_SIZE - (size - rest) : 0;
+
+        memcpy(last, stream->entry, head);
+        memcpy(last + head, data + size - rest - (API429_REPLAY_ENTRY_SIZE - head), API429_REPLAY_ENTRY_SIZE - head);
+
+        stream->entries   += total / API429_REPLAY_ENTRY_SIZE;
+        stream->entry_fill = 0;
+    }
+
+    memcpy(stream->entry + stream->entry_fill, data + size - (rest - stream->entry_fill), rest - stream->entry_fill);
+    stream->entry_fill = rest;
+}
+
+
+/*! \brief Write the ready chunk to the free half buffer
+ *
+ * Without entry counter, the rest of a short chunk is filled with filler entries.
+ * Must be called with the lock held.
+ */
+static AI_INLINE AiReturn api429_replay_stream_write(struct api429_replay_stream* stream)
+{
+    struct api429_replay_status status;
+    struct api429_rcv_stack_entry filler;
+    const void* data = stream->chunk.data;
+    AiUInt64 offset = stream->status.bytes_written;
+    AiUInt32 written = 0;
+    AiUInt32 i;
+    AiReturn ret;
+
+    ret = Api429ReplayStatusGet(stream->board_handle, stream->channel, &status);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(stream->chunk.size)
+    {
+        api429_replay_stream_track(stream, (const AiUInt8*) stream->chunk.data, stream->chunk.size);
+    }
+
+    /* Only the last chunk is shorter than a half buffer. With entry counter, the board stops after its last entry */
+    if(stream->chunk.size < status.ul_Size && stream->counted)
+    {
+        status.ul_Size = stream->chunk.size;
+    }
+    else if(stream->chunk.size < status.ul_Size)
+    {
+        /* Otherwise the board would go on with the stale entries behind it. Replace them with copies of the last entry,
+         * which are sent so late that the channel is halted before. A truncated last entry is completed with filler bytes */
+        filler = stream->last;
+        api429_timing_tm_tag_set(&filler.tm_tag, &filler.brw,
+                                 api429_timing_tm_tag_us(stream->last.tm_tag, stream->last.brw) + API429_REPLAY_STREAM_FILLER_GAP_US);
+
+        memcpy(stream->staging, stream->chunk.data, stream->chunk.size);
+
+        for(i = stream->chunk.size; i < status.ul_Size; i++)
+        {
+            stream->staging[i] = ((const AiUInt8*) &filler)[(offset + i) % API429_REPLAY_ENTRY_SIZE];
+        }
+
+        /* The board waits at the first filler entry starting behind the last entry. If it is cut off by the end of the half buffer,
+         * it is completed by a half buffer of filler entries */
+        data = stream->staging;
+        stream->padded = ((offset + stream->chunk.size + API429_REPLAY_ENTRY_SIZE - 1) / API429_REPLAY_ENTRY_SIZE + 1) * API429_REPLAY_ENTRY_SIZE
+                         <= offset + status.ul_Size ? AiTrue : AiFalse;
+    }
+
+    ret = Api429ReplayDataWrite(stream->board_handle, stream->channel, &status, (void*) data, &written);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    stream->half_tag_us[stream->status.halves_written % 2] = api429_timing_tm_tag_us(stream->last.tm_tag, stream->last.brw);
+
+    stream->status.bytes_written += stream->chunk.size;
+    stream->status.halves_written++;
+    stream->ready   = AiFalse;
+    stream->pending = AiFalse;
+
+    return API_OK;
+}
+
+
+/*! \brief Handle the end of the source
+ *
+ * Without entry counter, a half buffer of filler entries is prepared, if the last chunk filled its half buffer
+ * or left no room for a complete filler entry.
+ * Must be called with the lock held.
+ */
+static AI_INLINE void api429_replay_stream_end_reached(struct api429_replay_stream* stream)
+{
+    stream->status.end = AiTrue;
+
+    if(!stream->counted && !stream->padded && stream->entries)
+    {
+        stream->chunk.data = NULL;
+        stream->chunk.size = 0;
+        stream->ready      = AiTrue;
+    }
+}
+
+
+/*! \brief Get the host time when the last entry is sent at the latest
+ *
+ * Includes \ref API429_REPLAY_STREAM_HALT_MARGIN_US and allows the clocks of board and host to differ by 0.1 %.
+ * Must be called with the lock held.
+ * @return host time in microseconds, see \ref ai_clock_us
+ */
+static AI_INLINE AiUInt64 api429_replay_stream_halt_time(const struct api429_replay_stream* stream)
+{
+    AiInt64 diff = api429_timing_diff_us(api429_timing_tm_tag_us(stream->last.tm_tag, stream->last.brw), stream->ref_tag_us);
+
+    diff = diff > 0 ? diff : 0;
+
+    return stream->ref_host_us + (AiUInt64) diff + (AiUInt64) diff / 1000 + API429_REPLAY_STREAM_HALT_MARGIN_US;
+}
+
+
+/*! \brief Halt the channel if it sent the last entry
+ *
+ * Without entry counter the board would go on with the filler entries, or with a stale half buffer
+ * if all half buffers written were sent.
+ * Must be called with the lock held.
+ */
+static AI_INLINE AiReturn api429_replay_stream_end_check(struct api429_replay_stream* stream)
+{
+    if(stream->counted || !stream->status.end || stream->status.finished)
+    {
+        return API_OK;
+    }
+
+    if(stream->status.halves_sent < stream->status.halves_written
+       && (!stream->padded || !stream->ref_valid || ai_clock_us() < api429_replay_stream_halt_time(stream)))
+    {
+        return API_OK;
+    }
+
+    stream->status.finished = AiTrue;
+
+    return Api429ChannelHalt(stream->board_handle, stream->channel);
+}
+
+
+/*! \brief Get the time the prefetch thread may sleep
+ *
+ * Must be called with the lock held.
+ * @return time in microseconds until the channel must be halted, at most ten times \ref API429_REPLAY_STREAM_POLL_US
+ */
+static AI_INLINE AiUInt32 api429_replay_stream_sleep_us(const struct api429_replay_stream* stream)
+{
+    AiUInt64 now = ai_clock_us();
+    AiUInt64 halt;
+
+    if(stream->counted || !stream->status.end || stream->status.finished || !stream->padded || !stream->ref_valid)
+    {
+        return API429_REPLAY_STREAM_POLL_US * 10;
+    }
+
+    halt = api429_replay_stream_halt_time(stream);
+
+    return halt <= now ? 0 : (halt - now < API429_REPLAY_STREAM_POLL_US * 10 ? (AiUInt32) (halt - now) : API429_REPLAY_STREAM_POLL_US * 10);
+}
+
+
+/*! \brief Routine of the prefetch thread
+ *
+ * Also halts the channel after the last entry, if the replay entry counter is disabled.
+ */
+static void api429_replay_stream_thread(void* arg)
+{
+    struct api429_replay_stream* stream = (struct api429_replay_stream*) arg;
+    struct api429_replay_chunk chunk;
+    AiUInt32 value;
+    AiUInt32 sleep_us;
+    AiBoolean needed;
+    AiBoolean finished;
+    AiBoolean halted;
+    AiReturn ret;
+
+    while(!ai_atomic_u32_load(&stream->stop))
+    {
+        value = ai_event_value(stream->wake);
+
+        ai_mutex_lock(stream->lock);
+
+        needed   = !stream->ready && !stream->status.end && !stream->error ? AiTrue : AiFalse;
+        finished = stream->status.finished;
+        ret      = needed || stream->error ? API_OK : api429_replay_stream_end_check(stream);
+        halted   = !finished && stream->status.finished ? AiTrue : AiFalse;
+        sleep_us = api429_replay_stream_sleep_us(stream);
+
+        ai_mutex_release(stream->lock);
+
+        if(ret != API_OK)
+        {
+            api429_replay_stream_fail(stream, ret);
+        }
+        else if(halted)
+        {
+            ai_event_signal(stream->done);
+        }
+
+        if(needed)
+        {
+            ret = api429_replay_stream_prefetch(stream, &chunk);
+
+            ai_mutex_lock(stream->lock);
+
+            if(ret == API_OK && chunk.size)
+            {
+                stream->chunk = chunk;
+                stream->ready = AiTrue;
+
+                /* The board is already waiting for this chunk */
+                if(stream->pending)
+                {
+                    stream->status.late++;
+                    ret = api429_replay_stream_write(stream);
+                }
+            }
+            else if(ret == API_OK)
+            {
+                api429_replay_stream_end_reached(stream);
+
+                /* The board may already wait for the filler entries */
+                if(stream->ready && stream->pending)
+                {
+                    ret = api429_replay_stream_write(stream);
+                }
+            }
+
+            ai_mutex_release(stream->lock);
+
+            if(ret != API_OK)
+            {
+                api429_replay_stream_fail(stream, ret);
+            }
+
+            continue;
+        }
+
+        ai_event_wait(stream->wake, value, sleep_us);
+    }
+}
+
+
+/*! \brief Start the replay
+ *
+ * Initializes the replay with \ref Api429ReplayInit, writes the first half buffers, starts the prefetch thread
+ * and finally starts the channel.
+ * @param [in] stream the replay stream
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_stream_start(struct api429_replay_stream* stream)
+{
+    struct api429_replay_status status;
+    struct api429_time time;
+    const struct api429_rcv_stack_entry* entry;
+    AiBoolean first = AiFalse;
+    AiUInt32 first_addr;
+    AiUInt32 file_size;
+    AiUInt32 i;
+    AiReturn ret;
+
+    if(!stream)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(stream->thread)
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    /* The entry counter of the board can only handle sources with known size below 4 GB */
+    stream->counted = stream->source->size <= 0xFFFFFFFFu ? AiTrue : AiFalse;
+    file_size       = stream->counted ? (AiUInt32) stream->source->size : 0;
+
+    ret = Api429ReplayInit(stream->board_handle, stream->channel, stream->setup.clr_entry_bit, stream->counted ? 0 : 1, 0,
+                           stream->setup.rep_errors, stream->setup.rep_int_mode, stream->setup.abs_long_ttag,
+                           stream->setup.day_of_year, stream->setup.min, stream->setup.msec, file_size);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    ret = Api429ReplayStatusGet(stream->board_handle, stream->channel, &status);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(!status.ul_Size)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    free(stream->staging);
+    stream->staging = (AiUInt8*) malloc(status.ul_Size);
+    if(!stream->staging)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    memset(&stream->status, 0, sizeof(stream->status));
+    stream->half_size  = status.ul_Size;
+    stream->rpi_last   = status.ul_RpiCnt;
+    stream->ready      = AiFalse;
+    stream->pending    = AiFalse;
+    stream->error      = 0;
+    stream->entry_fill = 0;
+    stream->entries    = 0;
+    stream->ref_valid  = AiFalse;
+    stream->padded     = AiFalse;
+    first_addr         = status.ul_StartAddr;
+
+    memset(&stream->last, 0, sizeof(stream->last));
+
+    /* Fill both half buffers, as far as the board offers the second one before the start */
+    for(i = 0; i < 2; i++)
+    {
+        if(!stream->status.end)
+        {
+            ret = api429_replay_stream_prefetch(stream, &stream->chunk);
+            if(ret != API_OK)
+            {
+                break;
+            }
+
+            if(stream->chunk.size)
+            {
+                stream->ready = AiTrue;
+            }
+            else
+            {
+                api429_replay_stream_end_reached(stream);
+            }
+
+            /* Relative time tags start with the first entry */
+            if(i == 0 && stream->chunk.size >= API429_REPLAY_ENTRY_SIZE)
+            {
+                entry              = (const struct api429_rcv_stack_entry*) stream->chunk.data;
+                stream->ref_tag_us = api429_timing_tm_tag_us(entry->tm_tag, entry->brw);
+                first              = AiTrue;
+            }
+        }
+
+        if(!stream->ready)
+        {
+            break;
+        }
+
+        if(i == 1)
+        {
+            ret = Api429ReplayStatusGet(stream->board_handle, stream->channel, &status);
+            if(ret != API_OK || status.ul_StartAddr == first_addr)
+            {
+                /* Keep the chunk for the first half buffer interrupt */
+                break;
+            }
+        }
+
+        ret = api429_replay_stream_write(stream);
+        if(ret != API_OK)
+        {
+            break;
+        }
+    }
+
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+
+    ai_atomic_u32_store(&stream->stop, 0);
+
+    stream->thread = ai_thread_create(api429_replay_stream_thread, stream);
+    if(!stream->thread)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    ret = Api429ChannelStart(stream->board_handle, stream->channel);
+    if(ret != API_OK)
+    {
+        api429_replay_stream_stop(stream);
+        return ret;
+    }
+
+    /* Until the first half buffer interrupt, the time the last entry is sent is calculated from the start.
+     * The first entry is sent right away with relative time tags, and at the board time plus offset with absolute ones */
+    if(stream->setup.abs_long_ttag)
+    {
+        first = Api429BoardTimeGet(stream->board_handle, &time) == API_OK ? AiTrue : AiFalse;
+    }
+
+    ai_mutex_lock(stream->lock);
+
+    if(first && !stream->ref_valid)
+    {
+        if(stream->setup.abs_long_ttag)
+        {
+            stream->ref_tag_us = api429_timing_time_us(&time) - ((AiInt64) stream->setup.min * 60000000 + stream->setup.msec);
+        }
+
+        stream->ref_host_us = ai_clock_us();
+        stream->ref_valid   = AiTrue;
+    }
+
+    ai_mutex_release(stream->lock);
+
+    ai_event_signal(stream->wake);
+
+    return API_OK;
+}
+
+
+/*! \brief Handle channel events
+ *
+ * Must be called from the callback registered for \ref API429_EVENT_REPLAY_HALF_BUFFER and \ref API429_EVENT_REPLAY_STOP on the channel.
+ * Writes the prefetched chunk to the half buffer that became free.
+ * @param [in] stream the replay stream
+ * @param [in] type type of the event
+ */
+static AI_INLINE void api429_replay_stream_event(struct api429_replay_stream* stream, enum api429_event_type type)
+{
+    struct api429_replay_status status;
+    AiUInt64 now = ai_clock_us();
+    AiBoolean finished;
+    AiReturn ret = API_OK;
+
+    if(!stream)
+    {
+        return;
+    }
+
+    if(type == API429_EVENT_REPLAY_STOP)
+    {
+        ai_mutex_lock(stream->lock);
+        stream->status.finished = AiTrue;
+        ai_mutex_release(stream->lock);
+
+        ai_event_signal(stream->done);
+        return;
+    }
+
+    if(type != API429_EVENT_REPLAY_HALF_BUFFER)
+    {
+        return;
+    }
+
+    ret = Api429ReplayStatusGet(stream->board_handle, stream->channel, &status);
+    if(ret != API_OK)
+    {
+        api429_replay_stream_fail(stream, ret);
+        return;
+    }
+
+    ai_mutex_lock(stream->lock);
+
+    if(status.ul_RpiCnt - stream->rpi_last > 1)
+    {
+        stream->status.missed += status.ul_RpiCnt - stream->rpi_last - 1;
+    }
+
+    stream->status.halves_sent += status.ul_RpiCnt != stream->rpi_last ? status.ul_RpiCnt - stream->rpi_last : 1;
+    stream->rpi_last = status.ul_RpiCnt;
+    stream->pending  = AiTrue;
+
+    /* The last entry of the half buffer sent last went out before now, unless the board replayed stale half buffers */
+    if(stream->status.halves_sent <= stream->status.halves_written && stream->status.halves_sent + 1 >= stream->status.halves_written)
+    {
+        stream->ref_tag_us  = stream->half_tag_us[(stream->status.halves_sent - 1) % 2];
+        stream->ref_host_us = now;
+        stream->ref_valid   = AiTrue;
+    }
+
+    if(stream->ready)
+    {
+        ret = api429_replay_stream_write(stream);
+    }
+    else
+    {
+        ret = api429_replay_stream_end_check(stream);
+    }
+
+    finished = stream->status.finished;
+
+    ai_mutex_release(stream->lock);
+
+    if(ret != API_OK)
+    {
+        api429_replay_stream_fail(stream, ret);
+        return;
+    }
+
+    if(finished)
+    {
+        ai_event_signal(stream->done);
+    }
+
+    ai_event_signal(stream->wake);
+}
+
+
+/*! \brief Get the progress of a replay stream
+ *
+ * @param [in] stream the replay stream
+ * @param [out] status the progress is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_stream_status(struct api429_replay_stream* stream, struct api429_replay_stream_status* status)
+{
+    if(!stream || !status)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(stream->lock);
+    *status = stream->status;
+    ai_mutex_release(stream->lock);
+
+    return API_OK;
+}
+
+
+/*! \brief Wait until the replay stopped
+ *
+ * Also checks the replay status of the board cyclically, in case the stop event is not registered.
+ * @param [in] stream the replay stream
+ * @param [in] timeout_us maximum time to wait in microseconds
+ * @return
+ * - API_OK if the replay stopped
+ * - AI429_ERR_TIMEOUT if the replay did not stop in time
+ * - the error the stream encountered, if any
+ */
+static AI_INLINE AiReturn api429_replay_stream_wait(struct api429_replay_stream* stream, AiUInt32 timeout_us)
+{
+    struct api429_replay_status status;
+    AiUInt64 deadline;
+    AiUInt64 now;
+    AiUInt32 value;
+    AiBoolean finished;
+
+    if(!stream)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    deadline = ai_clock_us() + timeout_us;
+
+    for(;;)
+    {
+        value = ai_event_value(stream->done);
+
+        if(ai_atomic_u32_load(&stream->error))
+        {
+            return (AiReturn) ai_atomic_u32_load(&stream->error);
+        }
+
+        ai_mutex_lock(stream->lock);
+
+        if(!stream->status.finished && stream->status.end
+           && Api429ReplayStatusGet(stream->board_handle, stream->channel, &status) == API_OK && status.uc_Status == API429_HALT)
+        {
+            stream->status.finished = AiTrue;
+        }
+
+        finished = stream->status.finished;
+
+        ai_mutex_release(stream->lock);
+
+        if(finished)
+        {
+            return API_OK;
+        }
+
+        now = ai_clock_us();
+        if(now >= deadline)
+        {
+            return AI429_ERR_TIMEOUT;
+        }
+
+        ai_event_wait(stream->done, value, deadline - now < API429_REPLAY_STREAM_POLL_US ? (AiUInt32) (deadline - now) : API429_REPLAY_STREAM_POLL_US);
+    }
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYSTREAM_H_ */
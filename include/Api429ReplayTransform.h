@@ -0,0 +1,685 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429ReplayTransform.h
+ *
+ *  This header file contains inline helper functions
+ *  for filtering and modifying a recording while it is replayed
+ */
+
+#ifndef API429REPLAYTRANSFORM_H_
+#define API429REPLAYTRANSFORM_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+#include "Api429ReplayStream.h"
+#include "Api429Timing.h"
+#include "Ai_container.h"
+
+
+/**
+* \defgroup replay_transform Replay Transformation
+  This module modifies a recording on its way from a replay source to the board, so filtered or patched
+  recordings do not have to be written to new files first. \n
+  A transformation (\ref api429_replay_transform) is itself a \ref api429_replay_source that wraps another source,
+  e.g. a \ref api429_replay_file. Passed to \ref api429_replay_stream_create or \ref api429_replay_demux_create,
+  it is executed by the prefetch thread of the replay stream one half buffer ahead of the board,
+  so the half buffer interrupt only writes data that is already transformed. \n
+  The entries are processed in batches of \ref API429_REPLAY_BATCH_SIZE entries. Each step runs as a
+  separate loop over the whole batch. Filters, patch rules and remapping have no branches depending on the data,
+  so the compiler is able to vectorize them:
+  - Entries are dropped by label and SDI with a lookup table per recorded channel
+  - Patch rules replace bits of data words that match a pattern, optionally followed by a parity update
+  - Recorded channels are mapped to other channels, e.g. before \ref api429_replay_demux splits the recording
+  - Time tags are scaled relative to the first entry to replay the recording faster or slower,
+    and idle periods longer than a threshold are shortened, while the timing within bursts is kept.
+    Entries that would follow the previous entry of their channel closer than one word time at the channel speed
+    are delayed, so the rewritten timing never exceeds the bus capacity.
+
+  To start the replay at a given time of a recording file, position the file with \ref api429_replay_index_seek
+  and call \ref api429_replay_transform_reset before the replay is started.
+* @{
+*/
+
+
+
+/*! \def API429_REPLAY_TRANSFORM_CHANNELS
+ * Number of channels that can be distinguished in a recording
+ */
+#define API429_REPLAY_TRANSFORM_CHANNELS        16
+
+/*! \def API429_REPLAY_TRANSFORM_ALL_CHANNELS
+ * Channel mask that selects all recorded channels
+ */
+#define API429_REPLAY_TRANSFORM_ALL_CHANNELS    0xFFFFu
+
+/*! \def API429_REPLAY_TRANSFORM_MAX_PATCHES
+ * Maximum number of patch rules of a transformation
+ */
+#define API429_REPLAY_TRANSFORM_MAX_PATCHES     32
+
+/*! \def API429_REPLAY_TRANSFORM_SDI_ALL
+ * SDI mask that selects all SDI values
+ */
+#define API429_REPLAY_TRANSFORM_SDI_ALL         0x0F
+
+
+
+/*! \struct api429_replay_transform_patch
+ *
+ * This structure describes a rule that modifies data words. \n
+ * A data word of a selected channel that satisfies (word & match_mask) == match_value
+ * is replaced by (word & ~patch_mask) | (patch_value & patch_mask).
+ */
+struct api429_replay_transform_patch
+{
+    AiUInt32 channel_mask;  /*!< Recorded channels the rule applies to. Bit n selects channel n */
+    AiUInt32 match_mask;    /*!< Bits of the data word that are compared */
+    AiUInt32 match_value;   /*!< Value the compared bits must have */
+    AiUInt32 patch_mask;    /*!< Bits of the data word that are replaced */
+    AiUInt32 patch_value;   /*!< Value of the replaced bits */
+    AiBoolean parity;       /*!< AiTrue to set bit 32 of patched words for odd parity */
+};
+
+/*! \typedef TY_API429_REPLAY_TRANSFORM_PATCH
+ * Convenience typedef for \ref api429_replay_transform_patch
+ */
+typedef struct api429_replay_transform_patch TY_API429_REPLAY_TRANSFORM_PATCH;
+
+
+/*! \struct api429_replay_transform_status
+ *
+ * This structure reports the statistics of a transformation
+ */
+struct api429_replay_transform_status
+{
+    AiUInt64 entries_in;    /*!< Number of entries read from the input source */
+    AiUInt64 entries_out;   /*!< Number of entries delivered */
+    AiUInt64 filtered;      /*!< Number of entries dropped by the label and SDI filters */
+    AiUInt64 patched;       /*!< Number of patch rules applied. A word may be patched by several rules */
+    AiUInt64 compressed;    /*!< Number of idle periods that were shortened */
+    AiUInt64 delayed;       /*!< Number of entries delayed to keep the bus capacity */
+    AiInt64 delay_max_us;   /*!< Longest delay of an entry in microseconds */
+};
+
+/*! \typedef TY_API429_REPLAY_TRANSFORM_STATUS
+ * Convenience typedef for \ref api429_replay_transform_status
+ */
+typedef struct api429_replay_transform_status TY_API429_REPLAY_TRANSFORM_STATUS;
+
+
+/*! \struct api429_replay_transform
+ *
+ * This structure holds a transformation of a replay source.
+ * It is created with \ref api429_replay_transform_create
+ */
+struct api429_replay_transform
+{
+    struct api429_replay_source source;                                         /*!< The transformed replay source */
+    struct api429_replay_reader input;                                          /*!< Reader of the input source */
+    AiUInt8 pass[API429_REPLAY_TRANSFORM_CHANNELS][256];                        /*!< SDI values that pass, by channel and label. Bit n selects SDI n */
+    AiBoolean filtering;                                                        /*!< AiTrue if any entry may be dropped */
+    AiUInt8 remap[API429_REPLAY_TRANSFORM_CHANNELS];                            /*!< Replayed channel by recorded channel */
+    AiBoolean remapping;                                                        /*!< AiTrue if any channel is mapped to another one */
+    struct api429_replay_transform_patch patches[API429_REPLAY_TRANSFORM_MAX_PATCHES]; /*!< Patch rules in order of application */
+    AiUInt32 patch_count;                                                       /*!< Number of patch rules */
+    AiUInt32 scale_num;                                                         /*!< Numerator of the time scale */
+    AiUInt32 scale_den;                                                         /*!< Denominator of the time scale */
+    AiBoolean time_started;                                                     /*!< AiTrue if the first entry was seen */
+    AiInt64 time_first;                                                         /*!< Recorded time of the first entry */
+    AiInt64 time_last;                                                          /*!< Recorded time of the previous entry */
+    AiInt64 time_scaled;                                                        /*!< Rewritten time since the first entry, multiplied with 'scale_den' */
+    AiInt64 time_channel[API429_REPLAY_TRANSFORM_CHANNELS];                     /*!< Time of the previous entry of each channel */
+    AiInt64 gap_threshold_us;                                                   /*!< Idle periods longer than this are shortened. 0 to disable */
+    AiInt64 gap_us;                                                             /*!< Length of shortened idle periods */
+    struct api429_replay_batch batch;                                           /*!< Transformed entries not yet delivered */
+    struct api429_replay_transform_status status;                               /*!< Statistics */
+};
+
+/*! \typedef TY_API429_REPLAY_TRANSFORM
+ * Convenience typedef for \ref api429_replay_transform
+ */
+typedef struct api429_replay_transform TY_API429_REPLAY_TRANSFORM;
+
+
+
+
+/*! \brief Drop entries that do not pass the label and SDI filters
+ *
+ * @return number of entries stored to 'out'
+ */
+static AI_INLINE AiUInt32 api429_replay_transform_filter_batch(const struct api429_replay_transform* transform,
+                                                               const struct api429_rcv_stack_entry* in, AiUInt32 count,
+                                                               struct api429_rcv_stack_entry* out)
+{
+    AiUInt32 word;
+    AiUInt32 n = 0;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        word   = in[i].ldata;
+        out[n] = in[i];
+
+        n += (transform->pass[in[i].brw.b.channel][word & API429_WORD_LABEL_MASK] >> ((word & API429_WORD_SDI_MASK) >> API429_WORD_SDI_POS)) & 1;
+    }
+
+    return n;
+}
+
+
+/*! \brief Apply one patch rule to a batch of entries
+ *
+ * @return number of patched entries
+ */
+static AI_INLINE AiUInt32 api429_replay_transform_patch_batch(const struct api429_replay_transform_patch* patch,
+                                                              struct api429_rcv_stack_entry* entries, AiUInt32 count)
+{
+    AiUInt32 word, patched, hit;
+    AiUInt32 hits = 0;
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        word    = entries[i].ldata;
+        patched = (word & ~patch->patch_mask) | (patch->patch_value & patch->patch_mask);
+        patched = patch->parity ? api429_codec_parity_set(patched) : patched;
+        hit     = ((word & patch->match_mask) == patch->match_value ? 1 : 0) & (patch->channel_mask >> entries[i].brw.b.channel);
+
+        entries[i].ldata = hit & 1 ? patched : word;
+        hits += hit & 1;
+    }
+
+    return hits;
+}
+
+
+/*! \brief Rewrite the time tags of a batch of entries
+ *
+ * The times are calculated on a continuous time line starting at the first entry,
+ * and only wrapped to the time of day when written to the time tag.
+ */
+static AI_INLINE void api429_replay_transform_time_batch(struct api429_replay_transform* transform, struct api429_rcv_stack_entry* entries,
+                                                         AiUInt32 count)
+{
+    AiInt64 word_us[2];
+    AiInt64 time, delta, earliest;
+    AiUInt32 channel;
+    AiUInt32 i;
+
+    word_us[0] = (api429_timing_word_time_ns(API429_LO_SPEED, API429_MIN_GAP_BITS) + 999) / 1000;
+    word_us[1] = (api429_timing_word_time_ns(API429_HI_SPEED, API429_MIN_GAP_BITS) + 999) / 1000;
+
+    for(i = 0; i < count; i++)
+    {
+        time = api429_timing_tm_tag_us(entries[i].tm_tag, entries[i].brw);
+
+        if(!transform->time_started)
+        {
+            transform->time_first   = time;
+            transform->time_last    = time;
+            transform->time_started = AiTrue;
+        }
+
+        /* Accumulate the differences, so recordings longer than half a day are handled correctly */
+        delta = api429_timing_diff_us(time, transform->time_last);
+        transform->time_last = time;
+
+        if(transform->gap_threshold_us && delta > transform->gap_threshold_us)
+        {
+            delta = transform->gap_us;
+            transform->status.compressed++;
+        }
+
+        /* Scaling the sum instead of each difference avoids accumulating rounding errors */
+        transform->time_scaled += delta * transform->scale_num;
+        time = transform->time_first + transform->time_scaled / transform->scale_den;
+
+        /* The bus cannot carry two words of a channel closer than one word time */
+        channel  = entries[i].brw.b.channel;
+        earliest = transform->time_channel[channel] + word_us[entries[i].brw.b.speed];
+
+        if(time < earliest)
+        {
+            transform->status.delayed++;
+            transform->status.delay_max_us = earliest - time > transform->status.delay_max_us ? earliest - time : transform->status.delay_max_us;
+            time = earliest;
+        }
+
+        transform->time_channel[channel] = time;
+
+        time = time < 0 ? time % API429_TIMING_DAY_US + API429_TIMING_DAY_US : time;
+
+        api429_timing_tm_tag_set(&entries[i].tm_tag, &entries[i].brw, time);
+    }
+}
+
+
+/*! \brief Transform a batch of entries
+ *
+ * @return number of entries stored to 'out'
+ */
+static AI_INLINE AiUInt32 api429_replay_transform_batch(struct api429_replay_transform* transform, const struct api429_rcv_stack_entry* in,
+                                                        AiUInt32 count, struct api429_rcv_stack_entry* out)
+{
+    AiUInt32 n, i;
+
+    if(transform->filtering)
+    {
+        n = api429_replay_transform_filter_batch(transform, in, count, out);
+    }
+    else
+    {
+        memcpy(out, in, count * API429_REPLAY_ENTRY_SIZE);
+        n = count;
+    }
+
+    /* Patch rules refer to the recorded channel, so they are applied before remapping */
+    for(i = 0; i < transform->patch_count; i++)
+    {
+        transform->status.patched += api429_replay_transform_patch_batch(&transform->patches[i], out, n);
+    }
+
+    if(transform->remapping)
+    {
+        for(i = 0; i < n; i++)
+        {
+            out[i].brw.b.channel = (AiUInt32) (transform->remap[out[i].brw.b.channel] & 0xF);
+        }
+    }
+
+    if(transform->scale_num != transform->scale_den || transform->gap_threshold_us)
+    {
+        api429_replay_transform_time_batch(transform, out, n);
+    }
+
+    transform->status.entries_in  += count;
+    transform->status.entries_out += n;
+    transform->status.filtered    += count - n;
+
+    return n;
+}
+
+
+/*! \brief Batch function of a transformation
+ *
+ * Skips input batches that are dropped completely by the filters.
+ */
+static AiReturn AI_CALL_CONV api429_replay_transform_fill(void* context, struct api429_rcv_stack_entry* out, AiUInt32* count)
+{
+    struct api429_replay_transform* transform = (struct api429_replay_transform*) context;
+    const struct api429_rcv_stack_entry* entries;
+    AiUInt32 n;
+    AiReturn ret;
+
+    *count = 0;
+
+    while(!*count)
+    {
+        ret = api429_replay_reader_next(&transform->input, &entries, &n);
+        if(ret != API_OK || !n)
+        {
+            return ret;
+        }
+
+        n = n < API429_REPLAY_BATCH_SIZE ? n : API429_REPLAY_BATCH_SIZE;
+
+        *count = api429_replay_transform_batch(transform, entries, n, out);
+
+        api429_replay_reader_consume(&transform->input, n);
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Read function of a transformation
+ */
+static AiReturn AI_CALL_CONV api429_replay_transform_read(struct api429_replay_source* source, AiUInt32 size, struct api429_replay_chunk* chunk)
+{
+    struct api429_replay_transform* transform = AI_CONTAINER_OF(source, struct api429_replay_transform, source);
+
+    return api429_replay_batch_read(&transform->batch, size, chunk, api429_replay_transform_fill, transform);
+}
+
+
+/*! \brief Release a transformation
+ *
+ * The input source is not released.
+ * @param transform transformation to release. May be NULL
+ */
+static AI_INLINE void api429_replay_transform_free(struct api429_replay_transform* transform)
+{
+    if(!transform)
+    {
+        return;
+    }
+
+    api429_replay_batch_free(&transform->batch);
+    free(transform);
+}
+
+
+/*! \brief Create a transformation of a replay source
+ *
+ * Initially all entries pass unchanged.
+ * The transformation must be configured before the first chunk is read.
+ * @param [in] input source to transform. Must stay valid until the transformation is released
+ * @param [out] transform_out the created transformation is stored here. Must be released with \ref api429_replay_transform_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_create(struct api429_replay_source* input, struct api429_replay_transform** transform_out)
+{
+    struct api429_replay_transform* transform;
+    AiUInt32 i;
+
+    if(!input || !input->read || !transform_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *transform_out = NULL;
+
+    transform = (struct api429_replay_transform*) calloc(1, sizeof(struct api429_replay_transform));
+    if(!transform)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    api429_replay_reader_init(&transform->input, input, API429_REPLAY_BATCH_SIZE * API429_REPLAY_ENTRY_SIZE);
+
+    memset(transform->pass, API429_REPLAY_TRANSFORM_SDI_ALL, sizeof(transform->pass));
+
+    for(i = 0; i < API429_REPLAY_TRANSFORM_CHANNELS; i++)
+    {
+        transform->remap[i] = (AiUInt8) i;
+    }
+
+    for(i = 0; i < API429_REPLAY_TRANSFORM_CHANNELS; i++)
+    {
+        transform->time_channel[i] = -API429_TIMING_DAY_US;
+    }
+
+    transform->scale_num       = 1;
+    transform->scale_den       = 1;
+    transform->source.read     = api429_replay_transform_read;
+    transform->source.prefetch = NULL;
+    transform->source.size     = input->size == API429_REPLAY_SIZE_UNKNOWN ? input->size : input->size - input->size % API429_REPLAY_ENTRY_SIZE;
+
+    *transform_out = transform;
+
+    return API_OK;
+}
+
+
+/*! \brief Pass or drop all entries
+ *
+ * Resets all label and SDI filters. Use e.g. to drop all entries and then pass selected labels
+ * with \ref api429_replay_transform_filter.
+ * @param [in] transform the transformation
+ * @param [in] pass AiTrue to pass all entries, AiFalse to drop all entries
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_filter_all(struct api429_replay_transform* transform, AiBoolean pass)
+{
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    memset(transform->pass, pass ? API429_REPLAY_TRANSFORM_SDI_ALL : 0, sizeof(transform->pass));
+
+    transform->filtering   = pass ? AiFalse : AiTrue;
+    transform->source.size = pass ? transform->source.size : API429_REPLAY_SIZE_UNKNOWN;
+
+    return API_OK;
+}
+
+
+/*! \brief Pass or drop entries of a label
+ *
+ * @param [in] transform the transformation
+ * @param [in] channel_mask recorded channels the filter applies to. Bit n selects channel n
+ * @param [in] label label as stored in bits 1-8 of the data word, see \ref api429_codec_label_get
+ * @param [in] sdi_mask SDI values the filter applies to. Bit n selects SDI n, see \ref API429_REPLAY_TRANSFORM_SDI_ALL
+ * @param [in] pass AiTrue to pass the entries, AiFalse to drop them
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_filter(struct api429_replay_transform* transform, AiUInt32 channel_mask, AiUInt8 label,
+                                                         AiUInt8 sdi_mask, AiBoolean pass)
+{
+    AiUInt32 i;
+
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    sdi_mask &= API429_REPLAY_TRANSFORM_SDI_ALL;
+
+    for(i = 0; i < API429_REPLAY_TRANSFORM_CHANNELS; i++)
+    {
+        if(channel_mask & (1u << i))
+        {
+            transform->pass[i][label] = (AiUInt8) (pass ? transform->pass[i][label] | sdi_mask : transform->pass[i][label] & ~sdi_mask);
+        }
+    }
+
+    if(!pass && sdi_mask && (channel_mask & API429_REPLAY_TRANSFORM_ALL_CHANNELS))
+    {
+        transform->filtering   = AiTrue;
+        transform->source.size = API429_REPLAY_SIZE_UNKNOWN;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Add a patch rule
+ *
+ * Rules are applied in the order they were added, each one to the result of the previous ones.
+ * @param [in] transform the transformation
+ * @param [in] patch the patch rule
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_patch(struct api429_replay_transform* transform, const struct api429_replay_transform_patch* patch)
+{
+    if(!transform || !patch)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(transform->patch_count >= API429_REPLAY_TRANSFORM_MAX_PATCHES)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    transform->patches[transform->patch_count] = *patch;
+    transform->patch_count++;
+
+    return API_OK;
+}
+
+
+/*! \brief Replay a recorded channel as another channel
+ *
+ * Modifies api429_brw.b.channel of the entries, which selects the queue of \ref api429_replay_demux.
+ * Filters and patch rules still refer to the recorded channel.
+ * @param [in] transform the transformation
+ * @param [in] recorded_channel channel as stored in the recording
+ * @param [in] channel channel the entries are delivered as
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_remap(struct api429_replay_transform* transform, AiUInt32 recorded_channel, AiUInt32 channel)
+{
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(recorded_channel >= API429_REPLAY_TRANSFORM_CHANNELS || channel >= API429_REPLAY_TRANSFORM_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    transform->remap[recorded_channel] = (AiUInt8) channel;
+    transform->remapping = AiTrue;
+
+    return API_OK;
+}
+
+
+/*! \brief Scale the time between the entries
+ *
+ * The time tag of each entry is set to first + (recorded - first) * num / den, where first is
+ * the recorded time of the first entry. E.g. num = 1 and den = 2 replays the recording at double speed. \n
+ * Entries that become denser than the bus capacity allows are delayed, see \ref api429_replay_transform_status.
+ * @param [in] transform the transformation
+ * @param [in] num numerator of the scale factor
+ * @param [in] den denominator of the scale factor
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_time_scale(struct api429_replay_transform* transform, AiUInt32 num, AiUInt32 den)
+{
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(!num || !den)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    transform->scale_num = num;
+    transform->scale_den = den;
+
+    return API_OK;
+}
+
+
+/*! \brief Shorten idle periods
+ *
+ * Each period without entries that is longer than 'threshold_us' in the recording is replaced by a period
+ * of 'gap_us', before the time scale is applied. Shorter periods, i.e. the timing within bursts, are not modified.
+ * @param [in] transform the transformation
+ * @param [in] threshold_us idle periods longer than this are shortened. 0 to disable
+ * @param [in] gap_us length of shortened idle periods. Must not be larger than 'threshold_us'
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_idle_compress(struct api429_replay_transform* transform, AiUInt32 threshold_us, AiUInt32 gap_us)
+{
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(gap_us > threshold_us)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    transform->gap_threshold_us = threshold_us;
+    transform->gap_us           = gap_us;
+
+    return API_OK;
+}
+
+
+/*! \brief Restart a transformation after the input source was repositioned
+ *
+ * Discards buffered entries and starts the rewritten time line at the next entry of the input source.
+ * The configuration and the statistics are kept. Must not be called while the replay is running.
+ * @param [in] transform the transformation
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_reset(struct api429_replay_transform* transform)
+{
+    struct api429_replay_source* input;
+    AiUInt32 i;
+
+    if(!transform)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    input = transform->input.source;
+
+    api429_replay_reader_init(&transform->input, input, transform->input.read_size);
+
+    for(i = 0; i < API429_REPLAY_TRANSFORM_CHANNELS; i++)
+    {
+        transform->time_channel[i] = -API429_TIMING_DAY_US;
+    }
+
+    transform->time_started = AiFalse;
+    transform->time_scaled  = 0;
+    transform->batch.work_bytes  = 0;
+    transform->batch.work_offset = 0;
+
+    if(!transform->filtering)
+    {
+        transform->source.size = input->size == API429_REPLAY_SIZE_UNKNOWN ? input->size : input->size - input->size % API429_REPLAY_ENTRY_SIZE;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Get the statistics of a transformation
+ *
+ * While the replay is running, the statistics are updated by the prefetch thread of the replay stream,
+ * so the values may be slightly behind.
+ * @param [in] transform the transformation
+ * @param [out] status the statistics are stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_replay_transform_status(const struct api429_replay_transform* transform,
+                                                         struct api429_replay_transform_status* status)
+{
+    if(!transform || !status)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *status = transform->status;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429REPLAYTRANSFORM_H_ */
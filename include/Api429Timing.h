@@ -0,0 +1,208 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429Timing.h
+ *
+ *  This header file contains inline helper functions
+ *  for calculating Arinc 429 bus timing
+ */
+
+#ifndef API429TIMING_H_
+#define API429TIMING_H_
+
+
+#include "Api429.h"
+
+
+/**
+* \defgroup timing Bus Timing
+  This module contains header-only helpers for calculating the time
+  Arinc 429 data words occupy on the bus, and for converting board time tags.
+  All calculations use the nominal bit rates of the Arinc 429 specification.
+  Bit rate changes by \ref Api429BoardLsGradeSet or \ref Api429BoardSpeedModifierSet are not regarded.
+* @{
+*/
+
+
+
+/*! \def API429_WORD_BITS
+ * Number of bits of an Arinc 429 data word
+ */
+#define API429_WORD_BITS            32
+
+/*! \def API429_MIN_GAP_BITS
+ * Minimum inter-word gap in bit times according to the Arinc 429 specification
+ */
+#define API429_MIN_GAP_BITS         4
+
+/*! \def API429_MAX_GAP_BITS
+ * Maximum inter-word gap in bit times that can be set for a transfer or FIFO entry
+ */
+#define API429_MAX_GAP_BITS         255
+
+/*! \def API429_HI_SPEED_BIT_TIME_NS
+ * Duration of one bit at 100 kBit/s in nanoseconds
+ */
+#define API429_HI_SPEED_BIT_TIME_NS 10000
+
+/*! \def API429_LO_SPEED_BIT_TIME_NS
+ * Duration of one bit at 12.5 kBit/s in nanoseconds
+ */
+#define API429_LO_SPEED_BIT_TIME_NS 80000
+
+
+
+
+/*! \brief Get the duration of one bit
+ *
+ * @param speed channel speed. See \ref api429_speed
+ * @return duration of one bit in nanoseconds
+ */
+static AI_INLINE AiUInt32 api429_timing_bit_time_ns(enum api429_speed speed)
+{
+    return speed == API429_HI_SPEED ? API429_HI_SPEED_BIT_TIME_NS : API429_LO_SPEED_BIT_TIME_NS;
+}
+
+
+/*! \brief Clip a gap to the range the board is able to generate
+ *
+ * @param gap gap in bit times
+ * @return gap in the range of \ref API429_MIN_GAP_BITS .. \ref API429_MAX_GAP_BITS
+ */
+static AI_INLINE AiUInt32 api429_timing_gap_clip(AiUInt32 gap)
+{
+    if(gap < API429_MIN_GAP_BITS)
+    {
+        return API429_MIN_GAP_BITS;
+    }
+
+    return gap > API429_MAX_GAP_BITS ? API429_MAX_GAP_BITS : gap;
+}
+
+
+/*! \brief Get the number of bit times a data word occupies the bus
+ *
+ * @param gap gap following the data word in bit times. Values below 4 are treated as 4
+ * @return number of bit times of data word and gap
+ */
+static AI_INLINE AiUInt32 api429_timing_word_bits(AiUInt32 gap)
+{
+    return API429_WORD_BITS + (gap < API429_MIN_GAP_BITS ? API429_MIN_GAP_BITS : gap);
+}
+
+
+/*! \brief Get the duration a data word occupies the bus
+ *
+ * @param speed channel speed. See \ref api429_speed
+ * @param gap gap following the data word in bit times. Values below 4 are treated as 4
+ * @return duration of data word and gap in nanoseconds
+ */
+static AI_INLINE AiUInt32 api429_timing_word_time_ns(enum api429_speed speed, AiUInt32 gap)
+{
+    return api429_timing_word_bits(gap) * api429_timing_bit_time_ns(speed);
+}
+
+
+/*! \def API429_TIMING_DAY_US
+ * Number of microseconds of a day
+ */
+#define API429_TIMING_DAY_US        86400000000ll
+
+
+/*! \brief Convert a monitor time tag to microseconds of day
+ *
+ * @param tm_tag time tag word of a monitor entry. See \ref api429_tm_tag
+ * @param brw buffer report word of a monitor entry that holds the hours. See \ref api429_brw
+ * @return time in microseconds since midnight
+ */
+static AI_INLINE AiInt64 api429_timing_tm_tag_us(union api429_tm_tag tm_tag, union api429_brw brw)
+{
+    return ((((AiInt64) brw.b.hours * 60 + tm_tag.b.minutes) * 60 + tm_tag.b.seconds) * 1000000) + tm_tag.b.microseconds;
+}
+
+
+/*! \brief Convert microseconds of day to a monitor time tag
+ *
+ * Times beyond midnight are wrapped to the same time of the following day.
+ * @param [in,out] tm_tag time tag word of a monitor entry. See \ref api429_tm_tag
+ * @param [in,out] brw buffer report word of a monitor entry. Only the hours are modified. See \ref api429_brw
+ * @param [in] us time in microseconds since midnight. Must not be negative
+ */
+static AI_INLINE void api429_timing_tm_tag_set(union api429_tm_tag* tm_tag, union api429_brw* brw, AiInt64 us)
+{
+    us %= API429_TIMING_DAY_US;
+
+    /* Masked to the bitfield widths, so the stores are explicit truncations */
+    brw->b.hours           = (AiUInt32) (us / 3600000000ll) & 0xFF;
+    tm_tag->b.minutes      = (AiUInt32) (us / 60000000 % 60) & 0x3F;
+    tm_tag->b.seconds      = (AiUInt32) (us / 1000000 % 60) & 0x3F;
+    tm_tag->b.microseconds = (AiUInt32) (us % 1000000) & 0xFFFFF;
+}
+
+
+/*! \brief Convert an IRIG time to microseconds of day
+ *
+ * @param time IRIG time e.g. as returned by \ref Api429BoardTimeGet. The day is ignored
+ * @return time in microseconds since midnight
+ */
+static AI_INLINE AiInt64 api429_timing_time_us(const struct api429_time* time)
+{
+    return ((((AiInt64) time->hour * 60 + time->minute) * 60 + time->second) * 1000 + time->millisecond) * 1000;
+}
+
+
+/*! \brief Convert microseconds of day to an IRIG time
+ *
+ * Times beyond midnight are moved to the following day.
+ * @param [out] time IRIG time e.g. for \ref Api429TxStartOnTTag. Milliseconds are truncated
+ * @param [in] day day of year the time refers to
+ * @param [in] us time in microseconds since midnight of 'day'. Must not be negative
+ */
+static AI_INLINE void api429_timing_time_set(struct api429_time* time, AiUInt32 day, AiInt64 us)
+{
+    time->day         = day + (AiUInt32) (us / API429_TIMING_DAY_US);
+    us               %= API429_TIMING_DAY_US;
+    time->hour        = (AiUInt32) (us / 3600000000ll);
+    time->minute      = (AiUInt32) (us / 60000000 % 60);
+    time->second      = (AiUInt32) (us / 1000000 % 60);
+    time->millisecond = (AiUInt32) (us / 1000 % 1000);
+}
+
+
+/*! \brief Get difference of two times of day
+ *
+ * Handles wrap-around at midnight.
+ * @param a time in microseconds since midnight
+ * @param b time in microseconds since midnight
+ * @return a - b in microseconds, in the range of -12h .. 12h
+ */
+static AI_INLINE AiInt64 api429_timing_diff_us(AiInt64 a, AiInt64 b)
+{
+    AiInt64 diff = (a - b) % API429_TIMING_DAY_US;
+
+    if(diff > API429_TIMING_DAY_US / 2)
+    {
+        diff -= API429_TIMING_DAY_US;
+    }
+    else if(diff <= -API429_TIMING_DAY_US / 2)
+    {
+        diff += API429_TIMING_DAY_US;
+    }
+
+    return diff;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TIMING_H_ */
@@ -0,0 +1,531 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxAcyc.h
+ *
+ *  This header file contains inline helper functions
+ *  for scheduling acyclic transfers from multiple threads
+ */
+
+#ifndef API429TXACYC_H_
+#define API429TXACYC_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+#include "Api429Histogram.h"
+#include "Ai_clock.h"
+#include "Ai_container.h"
+#include "Ai_queue.h"
+
+
+/**
+* \defgroup tx_acyc Acyclic Transfer Scheduler
+  This module queues requests for acyclic transfers on framing based transmit channels. \n
+  Any number of producer threads can enqueue requests with \ref api429_acyc_enqueue without
+  locking and without calling into the board API. A single service thread calls \ref api429_acyc_service,
+  which collects queued requests into batches, writes their data, and sends each batch as one
+  acyclic frame with \ref Api429TxAcycFrameSend. \n
+  Acyclic frames are created on demand with \ref Api429TxAcycFrameCreate and cached, so recurring
+  batches do not need to create frames again. \n
+  Transmission is paced with a token bucket, so acyclic traffic only uses the configured share of
+  the bus time, e.g. the idle time left by the cyclic framing. A new frame is not sent before the
+  previous one is expected to be finished.
+* @{
+*/
+
+
+
+/*! \def API429_ACYC_MAX_BATCH
+ * Maximum number of transfers in one acyclic frame
+ */
+#define API429_ACYC_MAX_BATCH       32
+
+/*! \def API429_ACYC_FRAME_CACHE
+ * Number of acyclic frames that are kept on the board
+ */
+#define API429_ACYC_FRAME_CACHE     16
+
+/*! \def API429_ACYC_MAX_XFER_ID
+ * Maximum transfer ID
+ */
+#define API429_ACYC_MAX_XFER_ID     1023
+
+
+
+/*! \enum api429_acyc_state
+ *
+ * Enumeration of all states of an acyclic request
+ */
+enum api429_acyc_state
+{
+    API429_ACYC_IDLE = 0,   /*!< Request is not queued */
+    API429_ACYC_QUEUED,     /*!< Request is queued and waits for transmission */
+    API429_ACYC_SENT,       /*!< Request was sent */
+    API429_ACYC_FAILED      /*!< Request could not be sent. See 'result' */
+};
+
+/*! \typedef TY_E_API429_ACYC_STATE
+ * Convenience typedef for \ref api429_acyc_state
+ */
+typedef enum api429_acyc_state TY_E_API429_ACYC_STATE;
+
+
+/*! \struct api429_acyc_request
+ *
+ * This structure describes a request for an acyclic transfer.
+ * It is owned by the scheduler from \ref api429_acyc_enqueue until its state is no longer \ref API429_ACYC_QUEUED
+ */
+struct api429_acyc_request
+{
+    struct ai_mpsc_node node;       /*!< Queue node. Internal use only */
+    AiUInt32 xfer_id;               /*!< ID of the transfer to send */
+    AiUInt32 data;                  /*!< Data word to send if 'write_data' is AiTrue */
+    AiBoolean write_data;           /*!< If AiTrue, 'data' is written to the transfer buffer before sending */
+    void* context;                  /*!< User data. Not used by the scheduler */
+    AiUInt64 enqueue_us;            /*!< Host time of enqueuing */
+    AiUInt64 complete_us;           /*!< Host time the transmission is expected to be finished */
+    AiReturn result;                /*!< Result of sending the request */
+    volatile AiUInt32 state;        /*!< State of the request. See \ref api429_acyc_state */
+};
+
+/*! \typedef TY_API429_ACYC_REQUEST
+ * Convenience typedef for \ref api429_acyc_request
+ */
+typedef struct api429_acyc_request TY_API429_ACYC_REQUEST;
+
+
+/*! \typedef API429_ACYC_COMPLETE
+ * Prototype of a function that is called by the service thread for each finished request
+ */
+typedef void (AI_CALL_CONV *API429_ACYC_COMPLETE)(struct api429_acyc_request* request);
+
+
+/*! \struct api429_acyc_frame
+ *
+ * This structure describes an acyclic frame that is cached on the board
+ */
+struct api429_acyc_frame
+{
+    AiUInt32 frame_id;                          /*!< ID of the frame as returned by \ref Api429TxAcycFrameCreate */
+    AiUInt32 xfer_count;                        /*!< Number of transfers. 0 if cache entry is unused */
+    AiUInt32 xfers[API429_ACYC_MAX_BATCH];      /*!< Transfer IDs of the frame */
+    AiUInt64 last_used;                         /*!< Value of the use counter at last use */
+};
+
+/*! \typedef TY_API429_ACYC_FRAME
+ * Convenience typedef for \ref api429_acyc_frame
+ */
+typedef struct api429_acyc_frame TY_API429_ACYC_FRAME;
+
+
+/*! \struct api429_acyc_scheduler
+ *
+ * This structure holds an acyclic transfer scheduler for one transmit channel.
+ * It is created with \ref api429_acyc_create
+ */
+struct api429_acyc_scheduler
+{
+    AiUInt8 board_handle;                                   /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                                        /*!< ID of the transmit channel */
+    enum api429_speed speed;                                /*!< Speed of the channel */
+    AiDouble bus_share;                                     /*!< Share of the bus time acyclic frames may use (0.0 .. 1.0) */
+    AiUInt32 max_batch;                                     /*!< Maximum number of transfers in one frame */
+    API429_ACYC_COMPLETE complete;                          /*!< Function called for each finished request. May be NULL */
+    struct ai_mpsc_queue queue;                             /*!< Queue of requests */
+    AiUInt8 xfer_gap[API429_ACYC_MAX_XFER_ID + 1];          /*!< Gap of each registered transfer. 0 if not registered */
+    struct api429_acyc_request* pending[API429_ACYC_MAX_BATCH]; /*!< Requests taken from the queue that wait for transmission */
+    AiUInt32 pending_count;                                 /*!< Number of entries in 'pending' */
+    AiInt64 tokens_ns;                                      /*!< Bus time available for acyclic frames in nanoseconds */
+    AiInt64 burst_ns;                                       /*!< Maximum bus time that can be saved up */
+    AiUInt64 refill_us;                                     /*!< Host time of last token refill */
+    AiUInt64 busy_until_us;                                 /*!< Host time the last frame is expected to be finished */
+    AiUInt64 use_counter;                                   /*!< Counter for least recently used frame replacement */
+    struct api429_acyc_frame frames[API429_ACYC_FRAME_CACHE]; /*!< Cached acyclic frames */
+    AiUInt64 requests_sent;                                 /*!< Number of sent requests */
+    AiUInt64 requests_failed;                               /*!< Number of failed requests */
+    AiUInt64 frames_sent;                                   /*!< Number of sent frames */
+    AiUInt64 frames_created;                                /*!< Number of created frames */
+    struct api429_histogram latency;                        /*!< Time from enqueuing to expected end of transmission */
+};
+
+/*! \typedef TY_API429_ACYC_SCHEDULER
+ * Convenience typedef for \ref api429_acyc_scheduler
+ */
+typedef struct api429_acyc_scheduler TY_API429_ACYC_SCHEDULER;
+
+
+
+
+/*! \brief Create an acyclic transfer scheduler
+ *
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] speed speed of the channel
+ * @param [in] bus_share share of the bus time acyclic frames may use (0.0 .. 1.0), e.g. 1.0 - peak utilization of the framing
+ * @param [in] max_batch maximum number of transfers in one frame. Ranges from 1 to \ref API429_ACYC_MAX_BATCH
+ * @param [in] complete function called by the service thread for each finished request. May be NULL
+ * @param [out] scheduler_out the created scheduler is stored here. Must be released with \ref api429_acyc_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_acyc_create(AiUInt8 board_handle, AiUInt8 channel, enum api429_speed speed, AiDouble bus_share,
+                                             AiUInt32 max_batch, API429_ACYC_COMPLETE complete,
+                                             struct api429_acyc_scheduler** scheduler_out)
+{
+    struct api429_acyc_scheduler* scheduler;
+
+    if(!scheduler_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *scheduler_out = NULL;
+
+    if(max_batch == 0 || max_batch > API429_ACYC_MAX_BATCH || bus_share <= 0.0 || bus_share > 1.0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    scheduler = (struct api429_acyc_scheduler*) calloc(1, sizeof(struct api429_acyc_scheduler));
+    if(!scheduler)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    scheduler->board_handle = board_handle;
+    scheduler->channel      = channel;
+    scheduler->speed        = speed;
+    scheduler->bus_share    = bus_share;
+    scheduler->max_batch    = max_batch;
+    scheduler->complete     = complete;
+    scheduler->burst_ns     = (AiInt64) max_batch * api429_timing_word_time_ns(speed, API429_MAX_GAP_BITS);
+    scheduler->tokens_ns    = scheduler->burst_ns;
+    scheduler->refill_us    = ai_clock_us();
+
+    ai_mpsc_init(&scheduler->queue);
+    api429_histogram_init(&scheduler->latency);
+
+    *scheduler_out = scheduler;
+
+    return API_OK;
+}
+
+
+/*! \brief Release an acyclic transfer scheduler
+ *
+ * Deletes all cached acyclic frames. No requests must be queued.
+ * @param scheduler the scheduler to release. May be NULL
+ */
+static AI_INLINE void api429_acyc_free(struct api429_acyc_scheduler* scheduler)
+{
+    AiUInt32 i;
+
+    if(!scheduler)
+    {
+        return;
+    }
+
+    for(i = 0; i < API429_ACYC_FRAME_CACHE; i++)
+    {
+        if(scheduler->frames[i].xfer_count)
+        {
+            Api429TxAcycFrameDelete(scheduler->board_handle, scheduler->channel, scheduler->frames[i].frame_id);
+        }
+    }
+
+    free(scheduler);
+}
+
+
+/*! \brief Register a transfer for acyclic transmission
+ *
+ * The transfer must have been created with \ref Api429TxXferCreate before.
+ * Must be called before the transfer is used in a request.
+ * @param [in] scheduler the scheduler
+ * @param [in] xfer_id ID of the transfer
+ * @param [in] gap gap of the transfer in bit times
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_acyc_xfer_register(struct api429_acyc_scheduler* scheduler, AiUInt32 xfer_id, AiUInt32 gap)
+{
+    if(!scheduler)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(xfer_id == 0 || xfer_id > API429_ACYC_MAX_XFER_ID)
+    {
+        return AI429_ERR_XFER_ID;
+    }
+
+    scheduler->xfer_gap[xfer_id] = (AiUInt8) api429_timing_gap_clip(gap);
+
+    return API_OK;
+}
+
+
+/*! \brief Queue a request for transmission
+ *
+ * May be called from any thread. Does not block and does not access the board.
+ * @param [in] scheduler the scheduler
+ * @param [in] request the request. Must stay valid until it is finished
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_XFER_ID if the transfer is not registered
+ */
+static AI_INLINE AiReturn api429_acyc_enqueue(struct api429_acyc_scheduler* scheduler, struct api429_acyc_request* request)
+{
+    if(!scheduler || !request)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(request->xfer_id == 0 || request->xfer_id > API429_ACYC_MAX_XFER_ID || !scheduler->xfer_gap[request->xfer_id])
+    {
+        return AI429_ERR_XFER_ID;
+    }
+
+    request->result      = API_OK;
+    request->complete_us = 0;
+    request->enqueue_us  = ai_clock_us();
+    ai_atomic_u32_store(&request->state, API429_ACYC_QUEUED);
+
+    ai_mpsc_push(&scheduler->queue, &request->node);
+
+    return API_OK;
+}
+
+
+/*! \brief Get an acyclic frame for a sequence of transfers
+ *
+ * Returns a cached frame or creates a new one, replacing the least recently used frame if the cache is full.
+ */
+static AI_INLINE AiReturn api429_acyc_frame_get(struct api429_acyc_scheduler* scheduler, AiUInt32* xfers, AiUInt32 count,
+                                                AiUInt32* frame_id)
+{
+    struct api429_acyc_frame* frame;
+    struct api429_acyc_frame* victim = &scheduler->frames[0];
+    AiReturn ret;
+    AiUInt32 i;
+
+    scheduler->use_counter++;
+
+    for(i = 0; i < API429_ACYC_FRAME_CACHE; i++)
+    {
+        frame = &scheduler->frames[i];
+
+        if(frame->xfer_count == count && !memcmp(frame->xfers, xfers, count * sizeof(AiUInt32)))
+        {
+            frame->last_used = scheduler->use_counter;
+            *frame_id = frame->frame_id;
+            return API_OK;
+        }
+
+        if(victim->xfer_count && (!frame->xfer_count || frame->last_used < victim->last_used))
+        {
+            victim = frame;
+        }
+    }
+
+    if(victim->xfer_count)
+    {
+        Api429TxAcycFrameDelete(scheduler->board_handle, scheduler->channel, victim->frame_id);
+        victim->xfer_count = 0;
+    }
+
+    ret = Api429TxAcycFrameCreate(scheduler->board_handle, scheduler->channel, count, xfers, &victim->frame_id);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    memcpy(victim->xfers, xfers, count * sizeof(AiUInt32));
+    victim->xfer_count = count;
+    victim->last_used  = scheduler->use_counter;
+    scheduler->frames_created++;
+
+    *frame_id = victim->frame_id;
+
+    return API_OK;
+}
+
+
+/*! \brief Finish a request and notify the owner
+ */
+static AI_INLINE void api429_acyc_request_finish(struct api429_acyc_scheduler* scheduler, struct api429_acyc_request* request,
+                                                 AiReturn result, AiUInt64 complete_us)
+{
+    request->result      = result;
+    request->complete_us = complete_us;
+
+    if(result == API_OK)
+    {
+        scheduler->requests_sent++;
+        api429_histogram_add(&scheduler->latency, (AiInt64) (complete_us - request->enqueue_us));
+    }
+    else
+    {
+        scheduler->requests_failed++;
+    }
+
+    ai_atomic_u32_store(&request->state, result == API_OK ? API429_ACYC_SENT : API429_ACYC_FAILED);
+
+    if(scheduler->complete)
+    {
+        scheduler->complete(request);
+    }
+}
+
+
+/*! \brief Send queued requests
+ *
+ * Must be called cyclically by one service thread. Sends as many batches as the pacing allows.
+ * @param [in] scheduler the scheduler
+ * @param [out] wait_us time in microseconds until the next batch can be sent is stored here, 0 if no request is pending. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_acyc_service(struct api429_acyc_scheduler* scheduler, AiUInt32* wait_us)
+{
+    struct ai_mpsc_node* node;
+    struct api429_acyc_request* request;
+    AiUInt32 xfers[API429_ACYC_MAX_BATCH];
+    AiUInt32 frame_id;
+    AiUInt32 count;
+    AiInt64 cost_ns;
+    AiInt64 word_ns;
+    AiUInt64 now;
+    AiReturn ret = API_OK;
+    AiUInt32 i, k;
+
+    if(!scheduler)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(wait_us)
+    {
+        *wait_us = 0;
+    }
+
+    for(;;)
+    {
+        /* Fill batch candidates from queue */
+        while(scheduler->pending_count < scheduler->max_batch)
+        {
+            node = ai_mpsc_pop(&scheduler->queue);
+            if(!node)
+            {
+                break;
+            }
+            scheduler->pending[scheduler->pending_count++] = AI_CONTAINER_OF(node, struct api429_acyc_request, node);
+        }
+
+        if(scheduler->pending_count == 0)
+        {
+            return API_OK;
+        }
+
+        now = ai_clock_us();
+
+        scheduler->tokens_ns += (AiInt64) ((AiDouble) (now - scheduler->refill_us) * 1000.0 * scheduler->bus_share);
+        scheduler->tokens_ns  = scheduler->tokens_ns > scheduler->burst_ns ? scheduler->burst_ns : scheduler->tokens_ns;
+        scheduler->refill_us  = now;
+
+        /* Batch consecutive requests with distinct transfers as long as the bus time allows */
+        count   = 0;
+        cost_ns = 0;
+        for(i = 0; i < scheduler->pending_count; i++)
+        {
+            request = scheduler->pending[i];
+            word_ns = api429_timing_word_time_ns(scheduler->speed, scheduler->xfer_gap[request->xfer_id]);
+
+            for(k = 0; k < count && xfers[k] != request->xfer_id; k++)
+            {
+            }
+
+            if(k < count || (count > 0 && cost_ns + word_ns > scheduler->tokens_ns))
+            {
+                break;
+            }
+
+            xfers[count++] = request->xfer_id;
+            cost_ns += word_ns;
+        }
+
+        if(now < scheduler->busy_until_us || cost_ns > scheduler->tokens_ns)
+        {
+            if(wait_us)
+            {
+                AiUInt64 busy = now < scheduler->busy_until_us ? scheduler->busy_until_us - now : 0;
+                AiUInt64 refill = cost_ns > scheduler->tokens_ns
+                                ? (AiUInt64) ((AiDouble) (cost_ns - scheduler->tokens_ns) / (1000.0 * scheduler->bus_share)) + 1 : 0;
+                *wait_us = (AiUInt32) (busy > refill ? busy : refill);
+            }
+            return API_OK;
+        }
+
+        for(i = 0; i < count && ret == API_OK; i++)
+        {
+            request = scheduler->pending[i];
+            if(request->write_data)
+            {
+                ret = Api429TxXferBufferWrite(scheduler->board_handle, scheduler->channel, request->xfer_id, 1, 1, &request->data);
+            }
+        }
+
+        if(ret == API_OK)
+        {
+            ret = api429_acyc_frame_get(scheduler, xfers, count, &frame_id);
+        }
+
+        if(ret == API_OK)
+        {
+            ret = Api429TxAcycFrameSend(scheduler->board_handle, scheduler->channel, frame_id);
+        }
+
+        now = ai_clock_us();
+        if(ret == API_OK)
+        {
+            scheduler->tokens_ns    -= cost_ns;
+            scheduler->busy_until_us = now + (AiUInt64) (cost_ns / 1000);
+            scheduler->frames_sent++;
+        }
+
+        for(i = 0; i < count; i++)
+        {
+            api429_acyc_request_finish(scheduler, scheduler->pending[i], ret, now + (AiUInt64) (cost_ns / 1000));
+        }
+
+        scheduler->pending_count -= count;
+        memmove(&scheduler->pending[0], &scheduler->pending[count], scheduler->pending_count * sizeof(scheduler->pending[0]));
+
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXACYC_H_ */
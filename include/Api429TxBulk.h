@@ -0,0 +1,616 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxBulk.h
+ *
+ *  This header file contains inline helper functions
+ *  for updating many transfer buffers with few board memory accesses
+ */
+
+#ifndef API429TXBULK_H_
+#define API429TXBULK_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+
+
+/**
+* \defgroup tx_bulk Bulk Transfer Buffer Update
+  This module allows to update the buffers of many transfers at once. \n
+  The board memory location of all transfer buffers is resolved once when the writer is created.
+  The writer keeps a host side image of all buffers. New data is compared against
+  this image and only changed words are marked dirty. \n
+  \ref api429_tx_bulk_flush writes all dirty words with \ref Api429BoardMemBlockWrite, where
+  buffers that are adjacent in board memory are merged into one block, so one block write
+  replaces many calls of \ref Api429TxXferBufferWrite. \n
+  Only transfers without time tag can be used, as their buffers contain one data word per entry.
+  The buffers must not be modified by other means while the writer is used, e.g. by
+  \ref Api429TxXferBufferWrite or by channels in \ref API429_TX_MODE_FRAMING_DYNTAG.
+* @{
+*/
+
+
+
+/*! \struct api429_tx_bulk_xfer
+ *
+ * This structure describes the buffer of one transfer handled by a bulk writer
+ */
+struct api429_tx_bulk_xfer
+{
+    AiUInt32 xfer_id;               /*!< ID of the transfer */
+    enum ty_e_mem_type mem_type;    /*!< Memory type of the transfer buffer */
+    AiUInt32 offset;                /*!< Byte offset of the transfer buffer in board memory */
+    AiUInt32 size;                  /*!< Number of buffer entries */
+    AiUInt32 image_index;           /*!< Index of the first buffer entry in the host image */
+};
+
+/*! \typedef TY_API429_TX_BULK_XFER
+ * Convenience typedef for \ref api429_tx_bulk_xfer
+ */
+typedef struct api429_tx_bulk_xfer TY_API429_TX_BULK_XFER;
+
+
+/*! \struct api429_tx_bulk_segment
+ *
+ * This structure describes a range of adjacent transfer buffers in board memory
+ */
+struct api429_tx_bulk_segment
+{
+    enum ty_e_mem_type mem_type;    /*!< Memory type of the segment */
+    AiUInt32 offset;                /*!< Byte offset of the segment in board memory */
+    AiUInt32 image_index;           /*!< Index of the first word of the segment in the host image */
+    AiUInt32 size;                  /*!< Number of words in the segment */
+};
+
+/*! \typedef TY_API429_TX_BULK_SEGMENT
+ * Convenience typedef for \ref api429_tx_bulk_segment
+ */
+typedef struct api429_tx_bulk_segment TY_API429_TX_BULK_SEGMENT;
+
+
+/*! \struct api429_tx_bulk_stats
+ *
+ * This structure holds statistics of a flush operation
+ */
+struct api429_tx_bulk_stats
+{
+    AiUInt32 block_writes;          /*!< Number of block writes issued */
+    AiUInt32 words_written;         /*!< Number of words written to board memory including clean words inside merged blocks */
+    AiUInt32 words_dirty;           /*!< Number of changed words */
+};
+
+/*! \typedef TY_API429_TX_BULK_STATS
+ * Convenience typedef for \ref api429_tx_bulk_stats
+ */
+typedef struct api429_tx_bulk_stats TY_API429_TX_BULK_STATS;
+
+
+/*! \struct api429_tx_bulk_writer
+ *
+ * This structure holds a bulk writer for transfer buffers.
+ * It is created with \ref api429_tx_bulk_create
+ */
+struct api429_tx_bulk_writer
+{
+    AiUInt8 board_handle;                       /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                            /*!< ID of the transmit channel */
+    AiBoolean reverse_label;                    /*!< AiTrue if labels are stored bit-reversed in board memory */
+    AiUInt32 merge_gap;                         /*!< Maximum number of clean words between dirty words that are written in one block */
+    AiUInt32 xfer_count;                        /*!< Number of transfers */
+    struct api429_tx_bulk_xfer* xfers;          /*!< Transfers in the order they were passed on creation */
+    AiUInt32 segment_count;                     /*!< Number of segments */
+    struct api429_tx_bulk_segment* segments;    /*!< Adjacent buffer ranges sorted by board memory location */
+    AiUInt32 image_size;                        /*!< Number of words in the host image */
+    AiUInt32* image;                            /*!< Host image of all buffers in board memory format */
+    AiUInt32* dirty;                            /*!< One bit for each word of the host image that has to be written */
+};
+
+/*! \typedef TY_API429_TX_BULK_WRITER
+ * Convenience typedef for \ref api429_tx_bulk_writer
+ */
+typedef struct api429_tx_bulk_writer TY_API429_TX_BULK_WRITER;
+
+
+
+
+/*! \brief Convert a data word between host format and board memory format
+ */
+static AI_INLINE AiUInt32 api429_tx_bulk_word_convert(const struct api429_tx_bulk_writer* writer, AiUInt32 word)
+{
+    if(!writer->reverse_label)
+    {
+        return word;
+    }
+
+    return (word & ~API429_WORD_LABEL_MASK) | api429_codec_label_reverse((AiUInt8) (word & API429_WORD_LABEL_MASK));
+}
+
+
+/*! \brief Release a bulk writer
+ *
+ * @param writer the writer to release. May be NULL
+ */
+static AI_INLINE void api429_tx_bulk_free(struct api429_tx_bulk_writer* writer)
+{
+    if(!writer)
+    {
+        return;
+    }
+
+    free(writer->xfers);
+    free(writer->segments);
+    free(writer->image);
+    free(writer->dirty);
+    free(writer);
+}
+
+
+/*! \brief Find out if labels are stored bit-reversed in board memory
+ *
+ * Compares the data word returned by \ref Api429TxXferBufferRead with the raw board memory.
+ * If no transfer has a label that allows to decide, a test word is written to the first
+ * buffer entry of the first transfer and the original value is restored afterwards.
+ * As the test word must not be sent, this fails with AI429_ERR_CHANNEL_ACTIVE, if the channel is not halted.
+ */
+static AI_INLINE AiReturn api429_tx_bulk_calibrate(struct api429_tx_bulk_writer* writer)
+{
+    struct api429_xfer_data_read_input read_input;
+    struct api429_xfer_data data;
+    struct api429_tx_bulk_xfer* xfer;
+    AiUInt32 raw;
+    AiUInt32 test;
+    AiUInt32 count;
+    AiUInt8 status;
+    AiUInt8 label;
+    AiReturn ret;
+    AiReturn restore;
+    AiUInt32 i;
+
+    memset(&read_input, 0, sizeof(read_input));
+    read_input.ul_BufStart = 1;
+    read_input.ul_BufSize  = 1;
+
+    for(i = 0; i < writer->xfer_count; i++)
+    {
+        xfer = &writer->xfers[i];
+        read_input.ul_XferId = xfer->xfer_id;
+
+        ret = Api429TxXferBufferRead(writer->board_handle, writer->channel, &read_input, &data);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        ret = Api429BoardMemRead(writer->board_handle, xfer->mem_type, xfer->offset, 4, &raw);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        label = (AiUInt8) (data.ul_XferData & API429_WORD_LABEL_MASK);
+        if(label != api429_codec_label_reverse(label))
+        {
+            writer->reverse_label = (raw & API429_WORD_LABEL_MASK) != label;
+            return API_OK;
+        }
+    }
+
+    /* All labels are symmetric, use a test word. A running channel could send it */
+    ret = Api429TxStatusGet(writer->board_handle, writer->channel, &status, &count);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(status != API429_HALT)
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    xfer = &writer->xfers[0];
+    read_input.ul_XferId = xfer->xfer_id;
+
+    ret = Api429TxXferBufferRead(writer->board_handle, writer->channel, &read_input, &data);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    test = (data.ul_XferData & ~API429_WORD_LABEL_MASK) | 0x01;
+    ret = Api429TxXferBufferWrite(writer->board_handle, writer->channel, xfer->xfer_id, 1, 1, &test);
+    if(ret == API_OK)
+    {
+        ret = Api429BoardMemRead(writer->board_handle, xfer->mem_type, xfer->offset, 4, &raw);
+        writer->reverse_label = (raw & API429_WORD_LABEL_MASK) != 0x01;
+    }
+
+    restore = Api429TxXferBufferWrite(writer->board_handle, writer->channel, xfer->xfer_id, 1, 1, &data.ul_XferData);
+
+    return ret != API_OK ? ret : restore;
+}
+
+
+/*! \brief Re-read the host image from board memory
+ *
+ * All pending changes are discarded.
+ * @param [in] writer the bulk writer
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_bulk_reload(struct api429_tx_bulk_writer* writer)
+{
+    const struct api429_tx_bulk_segment* segment;
+    AiUInt32 bytes_read;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!writer)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < writer->segment_count; i++)
+    {
+        segment = &writer->segments[i];
+
+        ret = Api429BoardMemBlockRead(writer->board_handle, segment->mem_type, segment->offset, 4,
+                                      &writer->image[segment->image_index], segment->size, &bytes_read);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    memset(writer->dirty, 0, ((writer->image_size + 31) / 32) * sizeof(AiUInt32));
+
+    return API_OK;
+}
+
+
+/*! \brief Create a bulk writer for a set of transfers
+ *
+ * The transfers must have been created with \ref Api429TxXferCreate before.
+ * If the labels of all transfers read the same when bit-reversed (e.g. label 0), the storage order of labels
+ * can only be found out with a test word, so the channel must be halted.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] xfer_ids IDs of the transfers to handle. The position in this array is used as transfer index for the writer
+ * @param [in] xfer_count number of transfers in 'xfer_ids'
+ * @param [in] merge_gap maximum number of unchanged words between changed words that are written in one block instead of splitting it
+ * @param [out] writer_out the created writer is stored here. Must be released with \ref api429_tx_bulk_free
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_CHANNEL_ACTIVE if a test word is needed and the channel is running
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_bulk_create(AiUInt8 board_handle, AiUInt8 channel, const AiUInt32* xfer_ids, AiUInt32 xfer_count,
+                                                AiUInt32 merge_gap, struct api429_tx_bulk_writer** writer_out)
+{
+    struct api429_tx_bulk_writer* writer;
+    struct api429_tx_bulk_xfer** sorted = NULL;
+    struct api429_tx_bulk_xfer* xfer;
+    struct api429_tx_bulk_segment* segment;
+    AiUInt32 buffer_offset;
+    AiUInt16 buffer_size;
+    AiUInt32 i, j;
+    AiReturn ret;
+
+    if(!xfer_ids || !writer_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *writer_out = NULL;
+
+    if(xfer_count == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    writer = (struct api429_tx_bulk_writer*) calloc(1, sizeof(struct api429_tx_bulk_writer));
+    if(!writer)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    writer->board_handle = board_handle;
+    writer->channel      = channel;
+    writer->merge_gap    = merge_gap;
+    writer->xfer_count   = xfer_count;
+    writer->xfers    = (struct api429_tx_bulk_xfer*) calloc(xfer_count, sizeof(struct api429_tx_bulk_xfer));
+    writer->segments = (struct api429_tx_bulk_segment*) calloc(xfer_count, sizeof(struct api429_tx_bulk_segment));
+    sorted = (struct api429_tx_bulk_xfer**) calloc(xfer_count, sizeof(struct api429_tx_bulk_xfer*));
+    if(!writer->xfers || !writer->segments || !sorted)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    /* Resolve buffer locations once */
+    for(i = 0; i < xfer_count; i++)
+    {
+        xfer = &writer->xfers[i];
+        xfer->xfer_id = xfer_ids[i];
+
+        /* Only the size is used. The location comes from Api429BoardMemLocationGet, which also reports the memory type */
+        ret = Api429TxXferBufferOffsetGet(board_handle, channel, xfer->xfer_id, &buffer_offset, &buffer_size);
+        if(ret != API_OK)
+        {
+            goto out;
+        }
+
+        ret = Api429BoardMemLocationGet(board_handle, channel, API429_MEM_OBJ_XFER_BUF, xfer->xfer_id, &xfer->mem_type, &xfer->offset);
+        if(ret != API_OK)
+        {
+            goto out;
+        }
+
+        xfer->size = buffer_size;
+
+        /* Insertion sort by memory location */
+        for(j = i; j > 0; j--)
+        {
+            if(sorted[j - 1]->mem_type < xfer->mem_type
+               || (sorted[j - 1]->mem_type == xfer->mem_type && sorted[j - 1]->offset < xfer->offset))
+            {
+                break;
+            }
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = xfer;
+    }
+
+    /* Merge adjacent buffers into segments */
+    segment = NULL;
+    for(i = 0; i < xfer_count; i++)
+    {
+        xfer = sorted[i];
+
+        if(i > 0 && sorted[i - 1]->xfer_id == xfer->xfer_id)
+        {
+            ret = AI429_ERR_XFER_ID;
+            goto out;
+        }
+
+        if(!segment || segment->mem_type != xfer->mem_type || segment->offset + segment->size * 4 != xfer->offset)
+        {
+            segment = &writer->segments[writer->segment_count++];
+            segment->mem_type    = xfer->mem_type;
+            segment->offset      = xfer->offset;
+            segment->image_index = writer->image_size;
+            segment->size        = 0;
+        }
+
+        xfer->image_index = writer->image_size;
+        segment->size    += xfer->size;
+        writer->image_size += xfer->size;
+    }
+
+    writer->image = (AiUInt32*) calloc(writer->image_size, sizeof(AiUInt32));
+    writer->dirty = (AiUInt32*) calloc((writer->image_size + 31) / 32, sizeof(AiUInt32));
+    if(!writer->image || !writer->dirty)
+    {
+        ret = AI429_ERR_NO_MORE_MEMORY;
+        goto out;
+    }
+
+    ret = api429_tx_bulk_calibrate(writer);
+    if(ret != API_OK)
+    {
+        goto out;
+    }
+
+    ret = api429_tx_bulk_reload(writer);
+
+out:
+    free(sorted);
+
+    if(ret != API_OK)
+    {
+        api429_tx_bulk_free(writer);
+        return ret;
+    }
+
+    *writer_out = writer;
+
+    return API_OK;
+}
+
+
+/*! \brief Set data words of a transfer buffer
+ *
+ * The data is only stored in the host image. Words that differ from the current
+ * board content are written by the next call of \ref api429_tx_bulk_flush.
+ * @param [in] writer the bulk writer
+ * @param [in] index index of the transfer in the array passed to \ref api429_tx_bulk_create
+ * @param [in] buf_start buffer index to start writing to. Ranges from 1 to the buffer size
+ * @param [in] count number of data words to write
+ * @param [in] data data words to write. The lowest byte of each data word is the label ID
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_bulk_set(struct api429_tx_bulk_writer* writer, AiUInt32 index, AiUInt32 buf_start,
+                                             AiUInt32 count, const AiUInt32* data)
+{
+    const struct api429_tx_bulk_xfer* xfer;
+    AiUInt32* image;
+    AiUInt32 word;
+    AiUInt32 pos;
+    AiUInt32 i;
+
+    if(!writer || !data)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(index >= writer->xfer_count)
+    {
+        return AI429_ERR_XFER_ID;
+    }
+
+    xfer = &writer->xfers[index];
+    if(buf_start == 0 || buf_start - 1 + count > xfer->size)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    pos   = xfer->image_index + buf_start - 1;
+    image = &writer->image[pos];
+
+    for(i = 0; i < count; i++)
+    {
+        word = api429_tx_bulk_word_convert(writer, data[i]);
+        if(image[i] != word)
+        {
+            image[i] = word;
+            writer->dirty[(pos + i) >> 5] |= 1u << ((pos + i) & 31);
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Set the first data word of a transfer buffer
+ *
+ * Convenience function for transfers with a buffer size of 1.
+ * @param [in] writer the bulk writer
+ * @param [in] index index of the transfer in the array passed to \ref api429_tx_bulk_create
+ * @param [in] data data word to write
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_bulk_set_word(struct api429_tx_bulk_writer* writer, AiUInt32 index, AiUInt32 data)
+{
+    return api429_tx_bulk_set(writer, index, 1, 1, &data);
+}
+
+
+/*! \brief Find the next dirty word in the host image
+ *
+ * @return index of next dirty word at or after 'pos' and before 'end', or 'end' if there is none
+ */
+static AI_INLINE AiUInt32 api429_tx_bulk_next_dirty(const struct api429_tx_bulk_writer* writer, AiUInt32 pos, AiUInt32 end)
+{
+    AiUInt32 bits;
+
+    while(pos < end)
+    {
+        bits = writer->dirty[pos >> 5] >> (pos & 31);
+        if(bits)
+        {
+            while(!(bits & 1))
+            {
+                bits >>= 1;
+                pos++;
+            }
+            return pos < end ? pos : end;
+        }
+
+        /* Skip the remaining clean words of this bitmap word */
+        pos = (pos | 31) + 1;
+    }
+
+    return end;
+}
+
+
+/*! \brief Write all changed words to board memory
+ *
+ * Changed words are collected per segment. Runs of changed words that are separated by not more than
+ * 'merge_gap' unchanged words are written with one \ref Api429BoardMemBlockWrite call.
+ * @param [in] writer the bulk writer
+ * @param [out] stats statistics of the flush operation. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_bulk_flush(struct api429_tx_bulk_writer* writer, struct api429_tx_bulk_stats* stats)
+{
+    const struct api429_tx_bulk_segment* segment;
+    struct api429_tx_bulk_stats local_stats;
+    AiUInt32 seg_end;
+    AiUInt32 first, last, next;
+    AiUInt32 bytes_written;
+    AiUInt32 i, k;
+    AiReturn ret;
+
+    if(!writer)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    memset(&local_stats, 0, sizeof(local_stats));
+
+    for(i = 0; i < writer->segment_count; i++)
+    {
+        segment = &writer->segments[i];
+        seg_end = segment->image_index + segment->size;
+
+        first = api429_tx_bulk_next_dirty(writer, segment->image_index, seg_end);
+        while(first < seg_end)
+        {
+            last = first;
+            local_stats.words_dirty++;
+
+            /* Extend block while next dirty word is close enough */
+            for(;;)
+            {
+                next = api429_tx_bulk_next_dirty(writer, last + 1, seg_end);
+                if(next >= seg_end || next - last - 1 > writer->merge_gap)
+                {
+                    break;
+                }
+                last = next;
+                local_stats.words_dirty++;
+            }
+
+            ret = Api429BoardMemBlockWrite(writer->board_handle, segment->mem_type,
+                                           segment->offset + (first - segment->image_index) * 4, 4,
+                                           &writer->image[first], last - first + 1, &bytes_written);
+            if(ret != API_OK)
+            {
+                return ret;
+            }
+
+            for(k = first; k <= last; k++)
+            {
+                writer->dirty[k >> 5] &= ~(1u << (k & 31));
+            }
+
+            local_stats.block_writes++;
+            local_stats.words_written += last - first + 1;
+
+            first = next;
+        }
+    }
+
+    if(stats)
+    {
+        *stats = local_stats;
+    }
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXBULK_H_ */
@@ -0,0 +1,988 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxFanout.h
+ *
+ *  This header file contains inline helper functions
+ *  for sending the same FIFO entries on multiple channels
+ */
+
+#ifndef API429TXFANOUT_H_
+#define API429TXFANOUT_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+#include "Api429TxFifoAsync.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup tx_fanout FIFO Fan-Out
+  This module sends one stream of FIFO entries on several channels initialized with \ref API429_TX_MODE_FIFO. \n
+  Entries are put into a block, either allocated with \ref api429_tx_fanout_block_alloc and filled in place,
+  or wrapping an application buffer with \ref api429_tx_fanout_block_wrap.
+  \ref api429_tx_fanout_submit queues a reference to the block on each selected channel, so the entries exist only once on host side,
+  independent of the number of channels. The block is released when all channels have sent it. \n
+  \ref api429_tx_fanout_service tops up the board FIFO of each channel independently,
+  using non-blocking \ref Api429TxFifoWrite calls directly on the shared block.
+  A slow channel does not hold back the other channels, as long as its block queue has space left. \n
+  \ref api429_tx_fanout_channel_status reports how far each channel lags behind.
+* @{
+*/
+
+
+
+/*! \def API429_TX_FANOUT_MAX_CHANNELS
+ * Maximum number of channels of one fan-out
+ */
+#define API429_TX_FANOUT_MAX_CHANNELS   32
+
+
+
+/*! \typedef API429_TX_FANOUT_RELEASE
+ * Prototype of a function that is called when a wrapped application buffer is no longer used
+ */
+typedef void (AI_CALL_CONV *API429_TX_FANOUT_RELEASE)(void* context, struct api429_tx_fifo_entry* entries);
+
+
+/*! \struct api429_tx_fanout_block
+ *
+ * This structure holds FIFO entries shared by several channels
+ */
+struct api429_tx_fanout_block
+{
+    volatile AiUInt32 references;           /*!< Number of references to the block */
+    AiUInt32 count;                         /*!< Number of entries */
+    struct api429_tx_fifo_entry* entries;   /*!< The entries */
+    API429_TX_FANOUT_RELEASE release;       /*!< Called when a wrapped buffer is no longer used. NULL for allocated blocks */
+    void* context;                          /*!< User data passed to 'release' */
+};
+
+/*! \typedef TY_API429_TX_FANOUT_BLOCK
+ * Convenience typedef for \ref api429_tx_fanout_block
+ */
+typedef struct api429_tx_fanout_block TY_API429_TX_FANOUT_BLOCK;
+
+
+/*! \struct api429_tx_fanout_slot
+ *
+ * This structure describes a block queued on one channel
+ */
+struct api429_tx_fanout_slot
+{
+    struct api429_tx_fanout_block* block;   /*!< The block */
+    AiUInt64 ticket;                        /*!< Ticket of the block */
+    AiUInt64 end;                           /*!< Channel entry position after the block */
+};
+
+/*! \typedef TY_API429_TX_FANOUT_SLOT
+ * Convenience typedef for \ref api429_tx_fanout_slot
+ */
+typedef struct api429_tx_fanout_slot TY_API429_TX_FANOUT_SLOT;
+
+
+/*! \struct api429_tx_fanout_channel
+ *
+ * This structure holds the state of one channel of a fan-out
+ */
+struct api429_tx_fanout_channel
+{
+    AiUInt8 channel;                        /*!< ID of the transmit channel */
+    AiUInt32 fifo_size;                     /*!< Size of the board FIFO in entries */
+    AiUInt32 entry_time_ns;                 /*!< Bus time of one entry with default gap */
+    struct api429_tx_fanout_slot* slots;    /*!< Ring of queued blocks */
+    volatile AiUInt64 put;                  /*!< Number of blocks ever queued */
+    volatile AiUInt64 write;                /*!< Number of blocks ever written completely to the board FIFO */
+    volatile AiUInt64 done;                 /*!< Number of blocks ever sent completely */
+    AiUInt32 offset;                        /*!< Entries of the block at 'write' that are already written */
+    volatile AiUInt64 queued;               /*!< Number of entries ever queued */
+    volatile AiUInt64 written;              /*!< Number of entries ever written to the board FIFO */
+    volatile AiUInt64 sent;                 /*!< Number of entries ever sent from the board FIFO */
+    volatile AiUInt64 ticket_done;          /*!< Ticket of the last block sent completely */
+    AiUInt64 fifo_writes;                   /*!< Number of \ref Api429TxFifoWrite calls */
+    AiUInt64 lag_max;                       /*!< Largest number of entries queued on host and board at a time */
+    volatile AiUInt32 error;                /*!< Result of the last service call of the channel */
+};
+
+/*! \typedef TY_API429_TX_FANOUT_CHANNEL
+ * Convenience typedef for \ref api429_tx_fanout_channel
+ */
+typedef struct api429_tx_fanout_channel TY_API429_TX_FANOUT_CHANNEL;
+
+
+/*! \struct api429_tx_fanout_status
+ *
+ * This structure reports the progress of one channel of a fan-out
+ */
+struct api429_tx_fanout_status
+{
+    AiUInt64 queued;                        /*!< Number of entries ever queued */
+    AiUInt64 written;                       /*!< Number of entries ever written to the board FIFO */
+    AiUInt64 sent;                          /*!< Number of entries ever sent from the board FIFO */
+    AiUInt64 lag_entries;                   /*!< Number of entries queued on host and board */
+    AiUInt64 lag_us;                        /*!< Bus time of 'lag_entries' in microseconds */
+    AiUInt64 lag_max;                       /*!< Largest value of 'lag_entries' so far */
+    AiUInt64 tickets_behind;                /*!< Number of tickets queued on the channel that the most advanced channel has already sent */
+    AiUInt64 fifo_writes;                   /*!< Number of \ref Api429TxFifoWrite calls */
+    AiReturn error;                         /*!< Result of the last service call of the channel */
+};
+
+/*! \typedef TY_API429_TX_FANOUT_STATUS
+ * Convenience typedef for \ref api429_tx_fanout_status
+ */
+typedef struct api429_tx_fanout_status TY_API429_TX_FANOUT_STATUS;
+
+
+/*! \struct api429_tx_fanout
+ *
+ * This structure holds a fan-out of FIFO entries to several channels.
+ * It is created with \ref api429_tx_fanout_create
+ */
+struct api429_tx_fanout
+{
+    AiUInt8 board_handle;                                               /*!< Handle to the board the channels belong to */
+    enum api429_speed speed;                                            /*!< Speed of the channels */
+    AiUInt32 queue_mask;                                                /*!< Size of the block queue of each channel minus 1 */
+    struct api429_tx_fanout_channel channels[API429_TX_FANOUT_MAX_CHANNELS]; /*!< The channels */
+    AiUInt32 channel_count;                                             /*!< Number of channels */
+    AiUInt64 ticket;                                                    /*!< Ticket of the last submitted block */
+    struct ai_mutex* lock;                                              /*!< Serializes producers */
+    struct ai_event* wake;                                              /*!< Signalled on new blocks and FIFO interrupts */
+    struct ai_event* done;                                              /*!< Signalled when blocks were sent */
+    struct ai_thread* thread;                                           /*!< Service thread, if started */
+    volatile AiUInt32 stop;                                             /*!< Set to stop the service thread */
+};
+
+/*! \typedef TY_API429_TX_FANOUT
+ * Convenience typedef for \ref api429_tx_fanout
+ */
+typedef struct api429_tx_fanout TY_API429_TX_FANOUT;
+
+
+
+
+/*! \brief Allocate a block
+ *
+ * The entries of the block are filled in place by the application, e.g. with \ref Api429TxFifoDataWordCreate.
+ * @param [in] count number of entries
+ * @param [out] block_out the created block is stored here. Must be passed to \ref api429_tx_fanout_submit or \ref api429_tx_fanout_block_release
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_block_alloc(AiUInt32 count, struct api429_tx_fanout_block** block_out)
+{
+    struct api429_tx_fanout_block* block;
+
+    if(!block_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *block_out = NULL;
+
+    if(!count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    /* Entries follow the block header in the same allocation */
+    block = (struct api429_tx_fanout_block*) malloc(sizeof(struct api429_tx_fanout_block) + count * sizeof(struct api429_tx_fifo_entry));
+    if(!block)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    block->references = 1;
+    block->count      = count;
+    block->entries    = (struct api429_tx_fifo_entry*) (block + 1);
+    block->release    = NULL;
+    block->context    = NULL;
+
+    *block_out = block;
+
+    return API_OK;
+}
+
+
+/*! \brief Wrap an application buffer into a block
+ *
+ * The buffer must not be modified until 'release' is called.
+ * @param [in] entries the FIFO entries
+ * @param [in] count number of entries
+ * @param [in] release function called when the buffer is no longer used. May be NULL
+ * @param [in] context user data passed to 'release'
+ * @param [out] block_out the created block is stored here. Must be passed to \ref api429_tx_fanout_submit or \ref api429_tx_fanout_block_release
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_block_wrap(struct api429_tx_fifo_entry* entries, AiUInt32 count,
+                                                      API429_TX_FANOUT_RELEASE release, void* context,
+                                                      struct api429_tx_fanout_block** block_out)
+{
+    struct api429_tx_fanout_block* block;
+
+    if(!block_out || !entries)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *block_out = NULL;
+
+    if(!count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    block = (struct api429_tx_fanout_block*) malloc(sizeof(struct api429_tx_fanout_block));
+    if(!block)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    block->references = 1;
+    block->count      = count;
+    block->entries    = entries;
+    block->release    = release;
+    block->context    = context;
+
+    *block_out = block;
+
+    return API_OK;
+}
+
+
+/*! \brief Add a reference to a block
+ */
+static AI_INLINE void api429_tx_fanout_block_acquire(struct api429_tx_fanout_block* block)
+{
+    ai_atomic_u32_fetch_add(&block->references, 1);
+}
+
+
+/*! \brief Drop a reference to a block
+ *
+ * The block is freed when the last reference is dropped.
+ * @param block the block. May be NULL
+ */
+static AI_INLINE void api429_tx_fanout_block_release(struct api429_tx_fanout_block* block)
+{
+    if(!block || ai_atomic_u32_fetch_add(&block->references, (AiUInt32) -1) != 1)
+    {
+        return;
+    }
+
+    if(block->release)
+    {
+        block->release(block->context, block->entries);
+    }
+
+    free(block);
+}
+
+
+/*! \brief Stop the service thread
+ *
+ * Blocks that are still queued on host side are kept.
+ * @param [in] fanout the fan-out
+ */
+static AI_INLINE void api429_tx_fanout_stop(struct api429_tx_fanout* fanout)
+{
+    if(!fanout || !fanout->thread)
+    {
+        return;
+    }
+
+    ai_atomic_u32_store(&fanout->stop, 1);
+    ai_event_signal(fanout->wake);
+    ai_thread_join(fanout->thread);
+
+    fanout->thread = NULL;
+}
+
+
+/*! \brief Release a fan-out
+ *
+ * Stops the service thread and drops the references to all queued blocks.
+ * @param fanout fan-out to release. May be NULL
+ */
+static AI_INLINE void api429_tx_fanout_free(struct api429_tx_fanout* fanout)
+{
+    struct api429_tx_fanout_channel* channel;
+    AiUInt64 done;
+    AiUInt32 i;
+
+    if(!fanout)
+    {
+        return;
+    }
+
+    api429_tx_fanout_stop(fanout);
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        channel = &fanout->channels[i];
+
+        for(done = channel->done; done != channel->put; done++)
+        {
+            api429_tx_fanout_block_release(channel->slots[done & fanout->queue_mask].block);
+        }
+
+        free(channel->slots);
+    }
+
+    if(fanout->lock)
+    {
+        ai_mutex_free(fanout->lock);
+    }
+
+    if(fanout->wake)
+    {
+        ai_event_free(fanout->wake);
+    }
+
+    if(fanout->done)
+    {
+        ai_event_free(fanout->done);
+    }
+
+    free(fanout);
+}
+
+
+/*! \brief Create a fan-out
+ *
+ * @param [in] board_handle handle to the board the channels belong to
+ * @param [in] speed speed of the channels
+ * @param [in] queue_size maximum number of blocks queued on each channel. Must be a power of two
+ * @param [out] fanout_out the created fan-out is stored here. Must be released with \ref api429_tx_fanout_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_create(AiUInt8 board_handle, enum api429_speed speed, AiUInt32 queue_size,
+                                                  struct api429_tx_fanout** fanout_out)
+{
+    struct api429_tx_fanout* fanout;
+
+    if(!fanout_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *fanout_out = NULL;
+
+    if(queue_size < 2 || (queue_size & (queue_size - 1)))
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    fanout = (struct api429_tx_fanout*) calloc(1, sizeof(struct api429_tx_fanout));
+    if(!fanout)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    fanout->board_handle = board_handle;
+    fanout->speed        = speed;
+    fanout->queue_mask   = queue_size - 1;
+    fanout->lock         = ai_mutex_create();
+    fanout->wake         = ai_event_create();
+    fanout->done         = ai_event_create();
+
+    if(!fanout->lock || !fanout->wake || !fanout->done)
+    {
+        api429_tx_fanout_free(fanout);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *fanout_out = fanout;
+
+    return API_OK;
+}
+
+
+/*! \brief Add a channel to a fan-out
+ *
+ * Enables the FIFO empty interrupt of the channel with \ref Api429TxFifoSetup, if not enabled yet.
+ * The channel must be initialized with \ref API429_TX_MODE_FIFO.
+ * Channels must be added before the service thread is started.
+ * @param [in] fanout the fan-out
+ * @param [in] channel ID of the transmit channel
+ * @param [out] index index of the channel in the fan-out is stored here. Used as bit in the channel mask of \ref api429_tx_fanout_submit. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_channel_add(struct api429_tx_fanout* fanout, AiUInt8 channel, AiUInt32* index)
+{
+    struct api429_tx_fanout_channel* entry;
+    struct api429_tx_fifo_setup setup;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!fanout)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(fanout->thread)
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    if(fanout->channel_count >= API429_TX_FANOUT_MAX_CHANNELS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        if(fanout->channels[i].channel == channel)
+        {
+            return AI429_ERR_PARAMETER_RANGE;
+        }
+    }
+
+    ret = api429_tx_fifo_async_irq_enable(fanout->board_handle, channel, &setup);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    entry = &fanout->channels[fanout->channel_count];
+    memset(entry, 0, sizeof(*entry));
+
+    entry->slots = (struct api429_tx_fanout_slot*) calloc(fanout->queue_mask + 1, sizeof(struct api429_tx_fanout_slot));
+    if(!entry->slots)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    entry->channel       = channel;
+    entry->fifo_size     = setup.ulFifoSize;
+    entry->entry_time_ns = api429_timing_word_time_ns(fanout->speed, setup.ulDefaultGapSize);
+
+    if(index)
+    {
+        *index = fanout->channel_count;
+    }
+
+    fanout->channel_count++;
+
+    return API_OK;
+}
+
+
+/*! \brief Queue a block on several channels
+ *
+ * May be called from any thread. Never accesses the board.
+ * Takes over the reference of the caller to the block, also on failure.
+ * @param [in] fanout the fan-out
+ * @param [in] block the block
+ * @param [in] channel_mask bit mask of channel indices as returned by \ref api429_tx_fanout_channel_add
+ * @param [out] ticket ticket of the block is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_BUFFER_OVERFLOW if the block queue of a selected channel is full. The block is not queued on any channel in this case
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fanout_submit(struct api429_tx_fanout* fanout, struct api429_tx_fanout_block* block,
+                                                  AiUInt32 channel_mask, AiUInt64* ticket)
+{
+    struct api429_tx_fanout_channel* channel;
+    struct api429_tx_fanout_slot* slot;
+    AiUInt32 i;
+
+    if(!fanout || !block)
+    {
+        api429_tx_fanout_block_release(block);
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(!channel_mask || (fanout->channel_count < 32 && (channel_mask >> fanout->channel_count)))
+    {
+        api429_tx_fanout_block_release(block);
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    ai_mutex_lock(fanout->lock);
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        channel = &fanout->channels[i];
+
+        if((channel_mask & (1u << i)) && channel->put - ai_atomic_u64_load(&channel->done) > fanout->queue_mask)
+        {
+            ai_mutex_release(fanout->lock);
+            api429_tx_fanout_block_release(block);
+            return AI429_ERR_BUFFER_OVERFLOW;
+        }
+    }
+
+    fanout->ticket++;
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        if(!(channel_mask & (1u << i)))
+        {
+            continue;
+        }
+
+        channel = &fanout->channels[i];
+        api429_tx_fanout_block_acquire(block);
+
+        slot = &channel->slots[channel->put & fanout->queue_mask];
+        slot->block  = block;
+        slot->ticket = fanout->ticket;
+        slot->end    = channel->queued + block->count;
+
+        ai_atomic_u64_store(&channel->queued, slot->end);
+        ai_atomic_u64_store(&channel->put, channel->put + 1);
+    }
+
+    if(ticket)
+    {
+        *ticket = fanout->ticket;
+    }
+
+    ai_mutex_release(fanout->lock);
+
+    /* Each channel holds its own reference now */
+    api429_tx_fanout_block_release(block);
+
+    ai_event_signal(fanout->wake);
+
+    return API_OK;
+}
+
+
+/*! \brief Queue a copy of FIFO entries on several channels
+ *
+ * Convenience function that copies the entries once into an allocated block and submits it.
+ * @param [in] fanout the fan-out
+ * @param [in] entries the FIFO entries
+ * @param [in] count number of entries
+ * @param [in] channel_mask bit mask of channel indices as returned by \ref api429_tx_fanout_channel_add
+ * @param [out] ticket ticket of the entries is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_BUFFER_OVERFLOW if the block queue of a selected channel is full
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fanout_write(struct api429_tx_fanout* fanout, const struct api429_tx_fifo_entry* entries,
+                                                 AiUInt32 count, AiUInt32 channel_mask, AiUInt64* ticket)
+{
+    struct api429_tx_fanout_block* block;
+    AiReturn ret;
+
+    if(!fanout || !entries)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ret = api429_tx_fanout_block_alloc(count, &block);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    memcpy(block->entries, entries, count * sizeof(struct api429_tx_fifo_entry));
+
+    return api429_tx_fanout_submit(fanout, block, channel_mask, ticket);
+}
+
+
+/*! \brief Check if a ticket is still queued on a channel
+ *
+ * @return AiTrue if the block of the ticket was submitted to the channel, but not sent completely yet
+ */
+static AI_INLINE AiBoolean api429_tx_fanout_channel_pending(struct api429_tx_fanout* fanout, struct api429_tx_fanout_channel* channel,
+                                                            AiUInt64 ticket)
+{
+    AiUInt64 done = ai_atomic_u64_load(&channel->done);
+    AiUInt64 put  = ai_atomic_u64_load(&channel->put);
+
+    /* Tickets increase along the queue, so the search ends at the first newer ticket */
+    for(; done != put; done++)
+    {
+        if(channel->slots[done & fanout->queue_mask].ticket >= ticket)
+        {
+            return channel->slots[done & fanout->queue_mask].ticket == ticket;
+        }
+    }
+
+    return AiFalse;
+}
+
+
+/*! \brief Check if a ticket was sent on all its channels
+ *
+ * @param [in] fanout the fan-out
+ * @param [in] ticket ticket as returned by \ref api429_tx_fanout_submit
+ * @return AiTrue if the block of the ticket was sent on all selected channels
+ */
+static AI_INLINE AiBoolean api429_tx_fanout_done(struct api429_tx_fanout* fanout, AiUInt64 ticket)
+{
+    AiUInt32 i;
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        if(api429_tx_fanout_channel_pending(fanout, &fanout->channels[i], ticket))
+        {
+            return AiFalse;
+        }
+    }
+
+    return AiTrue;
+}
+
+
+/*! \brief Wait until a ticket was sent on all its channels
+ *
+ * @param [in] fanout the fan-out
+ * @param [in] ticket ticket as returned by \ref api429_tx_fanout_submit
+ * @param [in] timeout_us maximum time to wait in microseconds
+ * @return
+ * - API_OK if the ticket is complete
+ * - AI429_ERR_TIMEOUT if the ticket did not complete in time
+ * - the error of the last service call of a selected channel that has not sent the ticket yet, if any
+ */
+static AI_INLINE AiReturn api429_tx_fanout_wait(struct api429_tx_fanout* fanout, AiUInt64 ticket, AiUInt32 timeout_us)
+{
+    struct api429_tx_fanout_channel* channel;
+    AiUInt64 deadline;
+    AiUInt64 now;
+    AiUInt32 value;
+    AiUInt32 error;
+    AiUInt32 i;
+
+    if(!fanout)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    deadline = ai_clock_us() + timeout_us;
+
+    for(;;)
+    {
+        value = ai_event_value(fanout->done);
+
+        if(api429_tx_fanout_done(fanout, ticket))
+        {
+            return API_OK;
+        }
+
+        /* Errors of channels the ticket was not submitted to, or has already left, do not concern it */
+        for(i = 0; i < fanout->channel_count; i++)
+        {
+            channel = &fanout->channels[i];
+            error   = ai_atomic_u32_load(&channel->error);
+
+            if(error && api429_tx_fanout_channel_pending(fanout, channel, ticket))
+            {
+                return (AiReturn) error;
+            }
+        }
+
+        now = ai_clock_us();
+        if(now >= deadline)
+        {
+            return AI429_ERR_TIMEOUT;
+        }
+
+        ai_event_wait(fanout->done, value, (AiUInt32) (deadline - now));
+    }
+}
+
+
+/*! \brief Get the progress of a channel
+ *
+ * @param [in] fanout the fan-out
+ * @param [in] index index of the channel as returned by \ref api429_tx_fanout_channel_add
+ * @param [out] status the progress of the channel is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_channel_status(struct api429_tx_fanout* fanout, AiUInt32 index,
+                                                          struct api429_tx_fanout_status* status)
+{
+    struct api429_tx_fanout_channel* channel;
+    AiUInt64 leader = 0;
+    AiUInt64 ticket;
+    AiUInt64 done, put;
+    AiUInt32 i;
+
+    if(!fanout || !status)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(index >= fanout->channel_count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        ticket = ai_atomic_u64_load(&fanout->channels[i].ticket_done);
+        leader = ticket > leader ? ticket : leader;
+    }
+
+    channel = &fanout->channels[index];
+
+    status->sent           = ai_atomic_u64_load(&channel->sent);
+    status->written        = ai_atomic_u64_load(&channel->written);
+    status->queued         = ai_atomic_u64_load(&channel->queued);
+    status->lag_entries    = status->queued - status->sent;
+    status->lag_us         = status->lag_entries * channel->entry_time_ns / 1000;
+    status->lag_max        = channel->lag_max;
+    status->tickets_behind = 0;
+    status->fifo_writes    = channel->fifo_writes;
+    status->error          = (AiReturn) ai_atomic_u32_load(&channel->error);
+
+    /* Only count tickets that were submitted to this channel */
+    put = ai_atomic_u64_load(&channel->put);
+    for(done = ai_atomic_u64_load(&channel->done); done != put && channel->slots[done & fanout->queue_mask].ticket <= leader; done++)
+    {
+        status->tickets_behind++;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Handle channel events
+ *
+ * Must be called from the callback registered for \ref API429_EVENT_TX_FIFO on each channel of the fan-out.
+ * @param [in] fanout the fan-out
+ * @param [in] type type of the event
+ */
+static AI_INLINE void api429_tx_fanout_event(struct api429_tx_fanout* fanout, enum api429_event_type type)
+{
+    if(!fanout || type != API429_EVENT_TX_FIFO)
+    {
+        return;
+    }
+
+    ai_event_signal(fanout->wake);
+}
+
+
+/*! \brief Top up the board FIFO of one channel
+ *
+ * Stores the number of entries to send until the channel needs the next service call in 'pending', 0 if the channel is idle.
+ */
+static AI_INLINE AiReturn api429_tx_fanout_channel_service(struct api429_tx_fanout* fanout, struct api429_tx_fanout_channel* channel,
+                                                           AiBoolean* completed, AiUInt64* pending)
+{
+    struct api429_tx_fifo_status status;
+    struct api429_tx_fanout_slot* slot;
+    AiUInt64 put, written, sent;
+    AiUInt32 count, chunk;
+    AiReturn ret;
+
+    *pending = 0;
+
+    ret = Api429TxFifoStatusGet(fanout->board_handle, channel->channel, &status);
+
+    put     = ai_atomic_u64_load(&channel->put);
+    written = channel->written;
+
+    /* Write directly from the shared blocks as long as the board FIFO has space */
+    while(ret == API_OK && channel->write != put && status.ulEntriesFree)
+    {
+        slot  = &channel->slots[channel->write & fanout->queue_mask];
+        count = slot->block->count - channel->offset;
+        count = status.ulEntriesFree < count ? status.ulEntriesFree : count;
+
+        chunk = 0;
+        ret = Api429TxFifoWrite(fanout->board_handle, channel->channel, count, &slot->block->entries[channel->offset], AiFalse, &chunk);
+        channel->fifo_writes++;
+
+        written                += chunk;
+        channel->offset        += chunk;
+        status.ulEntriesFree   -= chunk;
+        status.ulEntriesToSend += chunk;
+
+        if(channel->offset == slot->block->count)
+        {
+            channel->offset = 0;
+            ai_atomic_u64_store(&channel->write, channel->write + 1);
+        }
+
+        if(chunk < count)
+        {
+            break;
+        }
+    }
+
+    ai_atomic_u64_store(&channel->written, written);
+
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    sent = written - status.ulEntriesToSend;
+    ai_atomic_u64_store(&channel->sent, sent);
+
+    if(channel->queued - sent > channel->lag_max)
+    {
+        channel->lag_max = channel->queued - sent;
+    }
+
+    /* Blocks that left the board FIFO completely are no longer referenced by this channel */
+    while(channel->done != channel->write)
+    {
+        slot = &channel->slots[channel->done & fanout->queue_mask];
+        if(slot->end > sent)
+        {
+            break;
+        }
+
+        ai_atomic_u64_store(&channel->ticket_done, slot->ticket);
+        api429_tx_fanout_block_release(slot->block);
+        ai_atomic_u64_store(&channel->done, channel->done + 1);
+        *completed = AiTrue;
+    }
+
+    if(channel->write != put)
+    {
+        *pending = status.ulEntriesToSend > channel->fifo_size / 2 ? status.ulEntriesToSend - channel->fifo_size / 2 : 1;
+    }
+    else if(channel->done != put)
+    {
+        *pending = channel->slots[channel->done & fanout->queue_mask].end - sent;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Top up the board FIFOs of all channels and release sent blocks
+ *
+ * Called by the service thread. May also be called cyclically by an application thread instead of starting the service thread.
+ * All channels are serviced, even if some of them fail. The result of each channel is reported by \ref api429_tx_fanout_channel_status.
+ * @param [in] fanout the fan-out
+ * @param [out] wait_us time in microseconds until the next call is needed is stored here. May be NULL
+ * @return
+ * - API_OK if all channels were serviced successfully
+ * - Error of the first failing channel otherwise, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fanout_service(struct api429_tx_fanout* fanout, AiUInt32* wait_us)
+{
+    struct api429_tx_fanout_channel* channel;
+    AiUInt64 sleep = API429_TX_FIFO_ASYNC_IDLE_US;
+    AiUInt64 pending, time;
+    AiBoolean completed = AiFalse;
+    AiReturn ret = API_OK;
+    AiReturn channel_ret;
+    AiUInt32 i;
+
+    if(!fanout)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    /* A failing channel must not stall the other channels */
+    for(i = 0; i < fanout->channel_count; i++)
+    {
+        channel = &fanout->channels[i];
+
+        channel_ret = api429_tx_fanout_channel_service(fanout, channel, &completed, &pending);
+        ai_atomic_u32_store(&channel->error, (AiUInt32) channel_ret);
+
+        ret = ret != API_OK ? ret : channel_ret;
+
+        /* Sleep until the first channel needs attention */
+        if(pending)
+        {
+            time  = pending * channel->entry_time_ns / 1000;
+            time  = time < API429_TX_FIFO_ASYNC_MIN_SLEEP_US ? API429_TX_FIFO_ASYNC_MIN_SLEEP_US : time;
+            sleep = time < sleep ? time : sleep;
+        }
+    }
+
+    if(completed || ret != API_OK)
+    {
+        ai_event_signal(fanout->done);
+    }
+
+    if(wait_us)
+    {
+        *wait_us = (AiUInt32) sleep;
+    }
+
+    return ret;
+}
+
+
+/*! \brief Routine of the service thread
+ */
+static void api429_tx_fanout_thread(void* arg)
+{
+    struct api429_tx_fanout* fanout = (struct api429_tx_fanout*) arg;
+    AiUInt32 wait_us;
+    AiUInt32 value;
+
+    while(!ai_atomic_u32_load(&fanout->stop))
+    {
+        value = ai_event_value(fanout->wake);
+
+        api429_tx_fanout_service(fanout, &wait_us);
+
+        ai_event_wait(fanout->wake, value, wait_us);
+    }
+}
+
+
+/*! \brief Start the service thread
+ *
+ * @param [in] fanout the fan-out
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fanout_start(struct api429_tx_fanout* fanout)
+{
+    if(!fanout)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(fanout->thread)
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    ai_atomic_u32_store(&fanout->stop, 0);
+
+    fanout->thread = ai_thread_create(api429_tx_fanout_thread, fanout);
+
+    return fanout->thread ? API_OK : AI429_ERR_NO_MORE_MEMORY;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXFANOUT_H_ */
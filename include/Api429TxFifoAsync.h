@@ -0,0 +1,716 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxFifoAsync.h
+ *
+ *  This header file contains inline helper functions
+ *  for writing to a transmit FIFO without blocking
+ */
+
+#ifndef API429TXFIFOASYNC_H_
+#define API429TXFIFOASYNC_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+#include "Ai_atomic.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+#include "Ai_thread.h"
+
+
+/**
+* \defgroup tx_fifo_async Asynchronous FIFO Writer
+  This module decouples producers of FIFO entries from the board FIFO of a channel
+  initialized with \ref API429_TX_MODE_FIFO. \n
+  Producers put entries into a host side ring buffer with \ref api429_tx_fifo_async_write or
+  \ref api429_tx_fifo_async_words_write. These calls never access the board and never wait for the FIFO.
+  If the ring buffer has not enough space left, they fail with AI429_ERR_BUFFER_OVERFLOW, so the producer can decide
+  how to handle the backpressure. \n
+  A service thread tops up the board FIFO as far as \ref Api429TxFifoStatusGet reports free entries,
+  using non-blocking \ref Api429TxFifoWrite calls. It sleeps until the FIFO is expected to be half empty and is woken early by new
+  entries and by the FIFO empty interrupt (\ref API429_EVENT_TX_FIFO). \n
+  Each write returns a ticket. A ticket is complete once all its entries have left the board FIFO.
+  Completion can be awaited with \ref api429_tx_fifo_async_wait or reported by a callback from the service thread.
+* @{
+*/
+
+
+
+/*! \def API429_TX_FIFO_ASYNC_IDLE_US
+ * Maximum time the service thread sleeps when there is nothing to do
+ */
+#define API429_TX_FIFO_ASYNC_IDLE_US        100000
+
+/*! \def API429_TX_FIFO_ASYNC_MIN_SLEEP_US
+ * Minimum time the service thread sleeps between two FIFO status checks
+ */
+#define API429_TX_FIFO_ASYNC_MIN_SLEEP_US   200
+
+
+
+/*! \typedef API429_TX_FIFO_ASYNC_COMPLETE
+ * Prototype of a function that is called by the service thread when a ticket is complete
+ */
+typedef void (AI_CALL_CONV *API429_TX_FIFO_ASYNC_COMPLETE)(void* context, AiUInt64 ticket, AiReturn result);
+
+
+/*! \struct api429_tx_fifo_async_completion
+ *
+ * This structure describes a pending completion callback
+ */
+struct api429_tx_fifo_async_completion
+{
+    AiUInt64 ticket;                            /*!< Ticket the callback belongs to */
+    API429_TX_FIFO_ASYNC_COMPLETE callback;     /*!< Function to call */
+    void* context;                              /*!< User data passed to 'callback' */
+};
+
+/*! \typedef TY_API429_TX_FIFO_ASYNC_COMPLETION
+ * Convenience typedef for \ref api429_tx_fifo_async_completion
+ */
+typedef struct api429_tx_fifo_async_completion TY_API429_TX_FIFO_ASYNC_COMPLETION;
+
+
+/*! \struct api429_tx_fifo_async
+ *
+ * This structure holds an asynchronous writer for one FIFO based transmit channel.
+ * It is created with \ref api429_tx_fifo_async_create
+ */
+struct api429_tx_fifo_async
+{
+    AiUInt8 board_handle;                                   /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                                        /*!< ID of the transmit channel */
+    enum api429_speed speed;                                /*!< Speed of the channel */
+    AiUInt32 fifo_size;                                     /*!< Size of the board FIFO in entries */
+    AiUInt32 entry_time_ns;                                 /*!< Bus time of one entry with default gap */
+    struct api429_tx_fifo_entry* ring;                      /*!< Host side ring buffer */
+    AiUInt32 ring_mask;                                     /*!< Size of 'ring' minus 1 */
+    volatile AiUInt64 put;                                  /*!< Number of entries ever queued */
+    volatile AiUInt64 get;                                  /*!< Number of entries ever written to the board FIFO */
+    volatile AiUInt64 sent;                                 /*!< Number of entries ever sent from the board FIFO */
+    struct api429_tx_fifo_async_completion* completions;    /*!< Ring of pending completion callbacks */
+    AiUInt32 completion_mask;                               /*!< Size of 'completions' minus 1 */
+    volatile AiUInt64 completion_put;                       /*!< Number of completions ever queued */
+    volatile AiUInt64 completion_get;                       /*!< Number of completions ever called */
+    struct ai_mutex* lock;                                  /*!< Serializes producers */
+    struct ai_event* wake;                                  /*!< Signalled on new entries and FIFO interrupts */
+    struct ai_event* done;                                  /*!< Signalled when tickets complete */
+    struct ai_thread* thread;                               /*!< Service thread, if started */
+    volatile AiUInt32 stop;                                 /*!< Set to stop the service thread */
+    volatile AiUInt32 error;                                /*!< Result of the last service call. Cleared by the next successful one */
+    AiUInt64 fifo_writes;                                   /*!< Number of \ref Api429TxFifoWrite calls */
+    volatile AiUInt64 empty_events;                         /*!< Number of FIFO empty interrupts. Read with \ref ai_atomic_u64_load */
+    volatile AiUInt64 underruns;                            /*!< Number of FIFO empty interrupts while entries were queued on host. Read with \ref ai_atomic_u64_load */
+};
+
+/*! \typedef TY_API429_TX_FIFO_ASYNC
+ * Convenience typedef for \ref api429_tx_fifo_async
+ */
+typedef struct api429_tx_fifo_async TY_API429_TX_FIFO_ASYNC;
+
+
+
+
+/*! \brief Stop the service thread
+ *
+ * Entries that are still queued on host side are kept.
+ * @param [in] writer the writer
+ */
+static AI_INLINE void api429_tx_fifo_async_stop(struct api429_tx_fifo_async* writer)
+{
+    if(!writer || !writer->thread)
+    {
+        return;
+    }
+
+    ai_atomic_u32_store(&writer->stop, 1);
+    ai_event_signal(writer->wake);
+    ai_thread_join(writer->thread);
+
+    writer->thread = NULL;
+}
+
+
+/*! \brief Release an asynchronous writer
+ *
+ * Stops the service thread. Pending completion callbacks are not called.
+ * @param writer writer to release. May be NULL
+ */
+static AI_INLINE void api429_tx_fifo_async_free(struct api429_tx_fifo_async* writer)
+{
+    if(!writer)
+    {
+        return;
+    }
+
+    api429_tx_fifo_async_stop(writer);
+
+    if(writer->lock)
+    {
+        ai_mutex_free(writer->lock);
+    }
+
+    if(writer->wake)
+    {
+        ai_event_free(writer->wake);
+    }
+
+    if(writer->done)
+    {
+        ai_event_free(writer->done);
+    }
+
+    free(writer->ring);
+    free(writer->completions);
+    free(writer);
+}
+
+
+/*! \brief Enable the FIFO empty interrupt of a transmit channel
+ *
+ * Calls \ref Api429TxFifoSetup only if the interrupt is not enabled yet.
+ * Also used by the multi-channel fan-out.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [out] setup the FIFO setup of the channel is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_irq_enable(AiUInt8 board_handle, AiUInt8 channel, struct api429_tx_fifo_setup* setup)
+{
+    AiReturn ret;
+
+    ret = Api429TxFifoSetupGet(board_handle, channel, setup);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    if(!(setup->ulFifoControl & 1))
+    {
+        setup->ulFifoControl |= 1;
+
+        ret = Api429TxFifoSetup(board_handle, channel, setup);
+    }
+
+    return ret;
+}
+
+
+/*! \brief Create an asynchronous writer
+ *
+ * Enables the FIFO empty interrupt of the channel with \ref Api429TxFifoSetup, if not enabled yet.
+ * The channel must be initialized with \ref API429_TX_MODE_FIFO.
+ * Register a callback for \ref API429_EVENT_TX_FIFO that calls \ref api429_tx_fifo_async_event for fast wake-ups.
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] speed speed of the channel
+ * @param [in] ring_size number of entries of the host side ring buffer. Must be a power of two
+ * @param [in] completion_size maximum number of pending completion callbacks. Must be a power of two
+ * @param [out] writer_out the created writer is stored here. Must be released with \ref api429_tx_fifo_async_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_create(AiUInt8 board_handle, AiUInt8 channel, enum api429_speed speed,
+                                                      AiUInt32 ring_size, AiUInt32 completion_size,
+                                                      struct api429_tx_fifo_async** writer_out)
+{
+    struct api429_tx_fifo_async* writer;
+    struct api429_tx_fifo_setup setup;
+    AiReturn ret;
+
+    if(!writer_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *writer_out = NULL;
+
+    if(ring_size < 2 || (ring_size & (ring_size - 1)) || completion_size < 2 || (completion_size & (completion_size - 1)))
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    ret = api429_tx_fifo_async_irq_enable(board_handle, channel, &setup);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    writer = (struct api429_tx_fifo_async*) calloc(1, sizeof(struct api429_tx_fifo_async));
+    if(!writer)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    writer->board_handle    = board_handle;
+    writer->channel         = channel;
+    writer->speed           = speed;
+    writer->fifo_size       = setup.ulFifoSize;
+    writer->entry_time_ns   = api429_timing_word_time_ns(speed, setup.ulDefaultGapSize);
+    writer->ring_mask       = ring_size - 1;
+    writer->completion_mask = completion_size - 1;
+    writer->ring            = (struct api429_tx_fifo_entry*) calloc(ring_size, sizeof(struct api429_tx_fifo_entry));
+    writer->completions     = (struct api429_tx_fifo_async_completion*) calloc(completion_size, sizeof(struct api429_tx_fifo_async_completion));
+    writer->lock            = ai_mutex_create();
+    writer->wake            = ai_event_create();
+    writer->done            = ai_event_create();
+
+    if(!writer->ring || !writer->completions || !writer->lock || !writer->wake || !writer->done)
+    {
+        api429_tx_fifo_async_free(writer);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    *writer_out = writer;
+
+    return API_OK;
+}
+
+
+/*! \brief Reserve ring buffer space for a write
+ *
+ * Must be called with the producer lock held.
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_reserve(struct api429_tx_fifo_async* writer, AiUInt32 count,
+                                                       API429_TX_FIFO_ASYNC_COMPLETE callback)
+{
+    AiUInt64 used = writer->put - ai_atomic_u64_load(&writer->get);
+
+    if(count > writer->ring_mask + 1 - used)
+    {
+        return AI429_ERR_BUFFER_OVERFLOW;
+    }
+
+    if(callback && writer->completion_put - ai_atomic_u64_load(&writer->completion_get) > writer->completion_mask)
+    {
+        return AI429_ERR_BUFFER_OVERFLOW;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Publish entries that were put into the ring buffer
+ *
+ * Must be called with the producer lock held.
+ */
+static AI_INLINE AiUInt64 api429_tx_fifo_async_commit(struct api429_tx_fifo_async* writer, AiUInt32 count,
+                                                      API429_TX_FIFO_ASYNC_COMPLETE callback, void* context)
+{
+    struct api429_tx_fifo_async_completion* completion;
+    AiUInt64 ticket = writer->put + count;
+
+    ai_atomic_u64_store(&writer->put, ticket);
+
+    if(callback)
+    {
+        completion = &writer->completions[writer->completion_put & writer->completion_mask];
+        completion->ticket   = ticket;
+        completion->callback = callback;
+        completion->context  = context;
+
+        ai_atomic_u64_store(&writer->completion_put, writer->completion_put + 1);
+    }
+
+    return ticket;
+}
+
+
+/*! \brief Queue FIFO entries for transmission
+ *
+ * May be called from any thread. Never accesses the board.
+ * @param [in] writer the writer
+ * @param [in] entries FIFO entries e.g. prepared with \ref Api429TxFifoDataWordCreate
+ * @param [in] count number of entries
+ * @param [in] callback function called by the service thread when the entries were sent. May be NULL
+ * @param [in] context user data passed to 'callback'
+ * @param [out] ticket ticket of the entries is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_BUFFER_OVERFLOW if the ring buffer or the completion queue has not enough space. Nothing is queued in this case
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_write(struct api429_tx_fifo_async* writer, const struct api429_tx_fifo_entry* entries,
+                                                     AiUInt32 count, API429_TX_FIFO_ASYNC_COMPLETE callback, void* context,
+                                                     AiUInt64* ticket)
+{
+    AiUInt32 start, first;
+    AiUInt64 result;
+    AiReturn ret;
+
+    if(!writer || (!entries && count))
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(writer->lock);
+
+    ret = api429_tx_fifo_async_reserve(writer, count, callback);
+    if(ret != API_OK)
+    {
+        ai_mutex_release(writer->lock);
+        return ret;
+    }
+
+    start = (AiUInt32) (writer->put & writer->ring_mask);
+    first = writer->ring_mask + 1 - start;
+    first = count < first ? count : first;
+
+    memcpy(&writer->ring[start], entries, first * sizeof(struct api429_tx_fifo_entry));
+    memcpy(&writer->ring[0], &entries[first], (count - first) * sizeof(struct api429_tx_fifo_entry));
+
+    result = api429_tx_fifo_async_commit(writer, count, callback, context);
+
+    ai_mutex_release(writer->lock);
+
+    ai_event_signal(writer->wake);
+
+    if(ticket)
+    {
+        *ticket = result;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Queue data words for transmission
+ *
+ * Same as \ref api429_tx_fifo_async_write, but each data word is converted into a FIFO entry with \ref Api429TxFifoDataWordCreate.
+ * @param [in] writer the writer
+ * @param [in] words Arinc 429 data words
+ * @param [in] count number of data words
+ * @param [in] gap gap following each data word in bit times
+ * @param [in] callback function called by the service thread when the data words were sent. May be NULL
+ * @param [in] context user data passed to 'callback'
+ * @param [out] ticket ticket of the data words is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_BUFFER_OVERFLOW if the ring buffer or the completion queue has not enough space. Nothing is queued in this case
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_words_write(struct api429_tx_fifo_async* writer, const AiUInt32* words, AiUInt32 count,
+                                                           AiUInt32 gap, API429_TX_FIFO_ASYNC_COMPLETE callback, void* context,
+                                                           AiUInt64* ticket)
+{
+    AiUInt64 result;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!writer || (!words && count))
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(writer->lock);
+
+    ret = api429_tx_fifo_async_reserve(writer, count, callback);
+
+    for(i = 0; i < count && ret == API_OK; i++)
+    {
+        ret = Api429TxFifoDataWordCreate(&writer->ring[(writer->put + i) & writer->ring_mask], words[i], gap, API429_XFER_ERR_DIS);
+    }
+
+    if(ret != API_OK)
+    {
+        ai_mutex_release(writer->lock);
+        return ret;
+    }
+
+    result = api429_tx_fifo_async_commit(writer, count, callback, context);
+
+    ai_mutex_release(writer->lock);
+
+    ai_event_signal(writer->wake);
+
+    if(ticket)
+    {
+        *ticket = result;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Check if a ticket is complete
+ *
+ * @param [in] writer the writer
+ * @param [in] ticket ticket as returned by a write function
+ * @return AiTrue if all entries of the ticket were sent
+ */
+static AI_INLINE AiBoolean api429_tx_fifo_async_done(struct api429_tx_fifo_async* writer, AiUInt64 ticket)
+{
+    return ai_atomic_u64_load(&writer->sent) >= ticket ? AiTrue : AiFalse;
+}
+
+
+/*! \brief Get number of entries that can be queued without overflow
+ *
+ * @param [in] writer the writer
+ * @return number of free ring buffer entries
+ */
+static AI_INLINE AiUInt32 api429_tx_fifo_async_space(struct api429_tx_fifo_async* writer)
+{
+    return writer->ring_mask + 1 - (AiUInt32) (ai_atomic_u64_load(&writer->put) - ai_atomic_u64_load(&writer->get));
+}
+
+
+/*! \brief Wait until a ticket is complete
+ *
+ * @param [in] writer the writer
+ * @param [in] ticket ticket as returned by a write function
+ * @param [in] timeout_us maximum time to wait in microseconds
+ * @return
+ * - API_OK if the ticket is complete
+ * - AI429_ERR_TIMEOUT if the ticket did not complete in time
+ * - the error of the last service call, if it failed. Transient errors are no longer reported once a service call succeeds
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_wait(struct api429_tx_fifo_async* writer, AiUInt64 ticket, AiUInt32 timeout_us)
+{
+    AiUInt64 deadline;
+    AiUInt64 now;
+    AiUInt32 value;
+
+    if(!writer)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    deadline = ai_clock_us() + timeout_us;
+
+    for(;;)
+    {
+        value = ai_event_value(writer->done);
+
+        if(api429_tx_fifo_async_done(writer, ticket))
+        {
+            return API_OK;
+        }
+
+        if(ai_atomic_u32_load(&writer->error))
+        {
+            return (AiReturn) ai_atomic_u32_load(&writer->error);
+        }
+
+        now = ai_clock_us();
+        if(now >= deadline)
+        {
+            return AI429_ERR_TIMEOUT;
+        }
+
+        ai_event_wait(writer->done, value, (AiUInt32) (deadline - now));
+    }
+}
+
+
+/*! \brief Handle channel events
+ *
+ * Must be called from the callback registered for \ref API429_EVENT_TX_FIFO on the channel.
+ * @param [in] writer the writer
+ * @param [in] type type of the event
+ */
+static AI_INLINE void api429_tx_fifo_async_event(struct api429_tx_fifo_async* writer, enum api429_event_type type)
+{
+    if(!writer || type != API429_EVENT_TX_FIFO)
+    {
+        return;
+    }
+
+    ai_atomic_u64_fetch_add(&writer->empty_events, 1);
+    if(ai_atomic_u64_load(&writer->put) != ai_atomic_u64_load(&writer->get))
+    {
+        ai_atomic_u64_fetch_add(&writer->underruns, 1);
+    }
+
+    ai_event_signal(writer->wake);
+}
+
+
+/*! \brief Top up the board FIFO and report completed tickets
+ *
+ * Called by the service thread. May also be called cyclically by an application thread instead of starting the service thread.
+ * @param [in] writer the writer
+ * @param [out] wait_us time in microseconds until the next call is needed is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_service(struct api429_tx_fifo_async* writer, AiUInt32* wait_us)
+{
+    struct api429_tx_fifo_async_completion* completion;
+    struct api429_tx_fifo_status status;
+    AiUInt64 put, get, sent, completion_put;
+    AiUInt64 pending, sleep;
+    AiUInt32 count, start, written;
+    AiBoolean completed = AiFalse;
+    AiReturn ret;
+
+    if(!writer)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(wait_us)
+    {
+        *wait_us = API429_TX_FIFO_ASYNC_IDLE_US;
+    }
+
+    ret = Api429TxFifoStatusGet(writer->board_handle, writer->channel, &status);
+
+    put = ai_atomic_u64_load(&writer->put);
+    get = writer->get;
+
+    /* Write as many entries as fit into the board FIFO, in at most two chunks due to ring wrap-around */
+    while(ret == API_OK && put != get && status.ulEntriesFree)
+    {
+        start = (AiUInt32) (get & writer->ring_mask);
+        count = writer->ring_mask + 1 - start;
+        count = put - get < count ? (AiUInt32) (put - get) : count;
+        count = status.ulEntriesFree < count ? status.ulEntriesFree : count;
+
+        written = 0;
+        ret = Api429TxFifoWrite(writer->board_handle, writer->channel, count, &writer->ring[start], AiFalse, &written);
+        writer->fifo_writes++;
+
+        get += written;
+        status.ulEntriesFree   -= written;
+        status.ulEntriesToSend += written;
+        ai_atomic_u64_store(&writer->get, get);
+
+        if(written < count)
+        {
+            break;
+        }
+    }
+
+    if(ret != API_OK)
+    {
+        ai_atomic_u32_store(&writer->error, (AiUInt32) ret);
+        ai_event_signal(writer->done);
+        return ret;
+    }
+
+    ai_atomic_u32_store(&writer->error, API_OK);
+
+    /* Entries that left the board FIFO are sent */
+    sent = get - status.ulEntriesToSend;
+    ai_atomic_u64_store(&writer->sent, sent);
+
+    completion_put = ai_atomic_u64_load(&writer->completion_put);
+    while(writer->completion_get != completion_put)
+    {
+        completion = &writer->completions[writer->completion_get & writer->completion_mask];
+        if(completion->ticket > sent)
+        {
+            break;
+        }
+
+        completion->callback(completion->context, completion->ticket, API_OK);
+        ai_atomic_u64_store(&writer->completion_get, writer->completion_get + 1);
+        completed = AiTrue;
+    }
+
+    if(completed || sent == put)
+    {
+        ai_event_signal(writer->done);
+    }
+
+    if(wait_us)
+    {
+        /* Sleep until the board FIFO is half empty if there is more to write, otherwise until the next ticket might complete */
+        if(put != get)
+        {
+            pending = status.ulEntriesToSend > writer->fifo_size / 2 ? status.ulEntriesToSend - writer->fifo_size / 2 : 0;
+        }
+        else
+        {
+            pending = writer->completion_get != completion_put ? writer->completions[writer->completion_get & writer->completion_mask].ticket - sent : 0;
+            pending = pending ? pending : (sent != put ? put - sent : 0);
+        }
+
+        if(pending)
+        {
+            sleep = pending * writer->entry_time_ns / 1000;
+            sleep = sleep < API429_TX_FIFO_ASYNC_MIN_SLEEP_US ? API429_TX_FIFO_ASYNC_MIN_SLEEP_US : sleep;
+            sleep = sleep > API429_TX_FIFO_ASYNC_IDLE_US ? API429_TX_FIFO_ASYNC_IDLE_US : sleep;
+            *wait_us = (AiUInt32) sleep;
+        }
+        else if(put != get)
+        {
+            *wait_us = API429_TX_FIFO_ASYNC_MIN_SLEEP_US;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Routine of the service thread
+ */
+static void api429_tx_fifo_async_thread(void* arg)
+{
+    struct api429_tx_fifo_async* writer = (struct api429_tx_fifo_async*) arg;
+    AiUInt32 wait_us;
+    AiUInt32 value;
+
+    while(!ai_atomic_u32_load(&writer->stop))
+    {
+        value = ai_event_value(writer->wake);
+
+        if(api429_tx_fifo_async_service(writer, &wait_us) != API_OK)
+        {
+            wait_us = API429_TX_FIFO_ASYNC_IDLE_US;
+        }
+
+        ai_event_wait(writer->wake, value, wait_us);
+    }
+}
+
+
+/*! \brief Start the service thread
+ *
+ * @param [in] writer the writer
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fifo_async_start(struct api429_tx_fifo_async* writer)
+{
+    if(!writer)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(writer->thread)
+    {
+        return AI429_ERR_CHANNEL_ACTIVE;
+    }
+
+    ai_atomic_u32_store(&writer->stop, 0);
+
+    writer->thread = ai_thread_create(api429_tx_fifo_async_thread, writer);
+
+    return writer->thread ? API_OK : AI429_ERR_NO_MORE_MEMORY;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXFIFOASYNC_H_ */
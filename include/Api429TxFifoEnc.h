@@ -0,0 +1,464 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxFifoEnc.h
+ *
+ *  This header file contains inline helper functions
+ *  for building transmit FIFO entries without library calls
+ */
+
+#ifndef API429TXFIFOENC_H_
+#define API429TXFIFOENC_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+
+
+/**
+* \defgroup tx_fifo_enc FIFO Entry Encoder
+  This module builds \ref api429_tx_fifo_entry structures inline, so large batches of entries
+  can be prepared without one library call per entry. \n
+  The encoding of the entries is not part of the API, so it is learned from the library when the encoder is created:
+  \ref Api429TxFifoDataWordCreate is called for each gap and error type and the results are stored in tables.
+  The data word, the delay time of \ref Api429TxFifoDelayCreate and the other parameters are probed bit by bit.
+  Afterwards each entry is built by a table look-up. \n
+  \ref api429_fifo_enc_create compares the learned encoding against the library functions for random parameters
+  and fails if they differ. \ref api429_fifo_enc_verify may be called with more samples.
+  The encoder is only equivalent for parameters the library accepts. Gaps are clipped with \ref api429_timing_gap_clip.
+* @{
+*/
+
+
+
+/*! \def API429_FIFO_ENC_ERRORS
+ * Number of error types of \ref api429_xfer_error
+ */
+#define API429_FIFO_ENC_ERRORS      (API429_XFER_ERR_WAIT + 1)
+
+/*! \def API429_FIFO_ENC_CHECK_SAMPLES
+ * Number of random parameter sets \ref api429_fifo_enc_create checks the encoder with
+ */
+#define API429_FIFO_ENC_CHECK_SAMPLES   256
+
+/*! \def API429_FIFO_ENC_TRIGGER_LINES
+ * Number of trigger lines
+ */
+#define API429_FIFO_ENC_TRIGGER_LINES   4
+
+
+
+/*! \struct api429_fifo_enc_linear
+ *
+ * This structure describes how a parameter is encoded into an entry, if each parameter bit toggles fixed entry bits
+ */
+struct api429_fifo_enc_linear
+{
+    struct api429_tx_fifo_entry base;           /*!< Entry for parameter value 0 */
+    struct api429_tx_fifo_entry bit[32];        /*!< Entry bits toggled by each parameter bit */
+    AiUInt32 bits;                              /*!< Number of parameter bits the library accepts */
+};
+
+/*! \typedef TY_API429_FIFO_ENC_LINEAR
+ * Convenience typedef for \ref api429_fifo_enc_linear
+ */
+typedef struct api429_fifo_enc_linear TY_API429_FIFO_ENC_LINEAR;
+
+
+/*! \struct api429_fifo_enc
+ *
+ * This structure holds the encoding tables learned from the library.
+ * It is created with \ref api429_fifo_enc_create
+ */
+struct api429_fifo_enc
+{
+    struct api429_tx_fifo_entry word[API429_MAX_GAP_BITS + 1][API429_FIFO_ENC_ERRORS];     /*!< Data word entry with data 0 for each gap and error type */
+    struct api429_fifo_enc_linear data;                                     /*!< Encoding of the data word */
+    AiBoolean data_plain;                                                   /*!< AiTrue if the data word is stored unchanged in 'ulData' */
+    struct api429_fifo_enc_linear delay;                                    /*!< Encoding of delay entries */
+    struct api429_tx_fifo_entry interrupt[256];                             /*!< Interrupt entry for each tag */
+    struct api429_tx_fifo_entry trigger_pulse[API429_FIFO_ENC_TRIGGER_LINES]; /*!< Trigger pulse entry for each line */
+    struct api429_tx_fifo_entry trigger_wait[API429_FIFO_ENC_TRIGGER_LINES];  /*!< Trigger wait entry for each line */
+};
+
+/*! \typedef TY_API429_FIFO_ENC
+ * Convenience typedef for \ref api429_fifo_enc
+ */
+typedef struct api429_fifo_enc TY_API429_FIFO_ENC;
+
+
+
+
+/*! \brief Apply a linear encoding to a parameter value
+ */
+static AI_INLINE void api429_fifo_enc_linear_apply(const struct api429_fifo_enc_linear* linear, AiUInt32 value,
+                                                   struct api429_tx_fifo_entry* entry)
+{
+    AiUInt32 control = linear->base.ulControl;
+    AiUInt32 data    = linear->base.ulData;
+    AiUInt32 i;
+
+    for(i = 0; value; i++, value >>= 1)
+    {
+        if(value & 1)
+        {
+            control ^= linear->bit[i].ulControl;
+            data    ^= linear->bit[i].ulData;
+        }
+    }
+
+    entry->ulControl = control;
+    entry->ulData    = data;
+}
+
+
+/*! \brief Learn a linear encoding from a library function
+ *
+ * Probes value 0 and each single bit. Probing stops at the first bit the library does not accept.
+ */
+#define API429_FIFO_ENC_LINEAR_LEARN(linear, ret, call, value)                              \
+    do                                                                                      \
+    {                                                                                       \
+        struct api429_tx_fifo_entry probe_;                                                 \
+        AiUInt32 value = 0;                                                                 \
+        ret = call(&(linear)->base, value);                                                 \
+        for((linear)->bits = 0; ret == API_OK && (linear)->bits < 32; (linear)->bits++)     \
+        {                                                                                   \
+            value = 1u << (linear)->bits;                                                   \
+            if(call(&probe_, value) != API_OK)                                              \
+            {                                                                               \
+                break;                                                                      \
+            }                                                                               \
+            (linear)->bit[(linear)->bits].ulControl = probe_.ulControl ^ (linear)->base.ulControl; \
+            (linear)->bit[(linear)->bits].ulData    = probe_.ulData ^ (linear)->base.ulData;       \
+        }                                                                                   \
+    } while(0)
+
+
+/*! \brief Data word probe with gap 4 and no error
+ */
+static AI_INLINE AiReturn api429_fifo_enc_data_probe(struct api429_tx_fifo_entry* entry, AiUInt32 data)
+{
+    return Api429TxFifoDataWordCreate(entry, data, 4, API429_XFER_ERR_DIS);
+}
+
+
+/*! \brief Release an encoder
+ *
+ * @param enc encoder to release. May be NULL
+ */
+static AI_INLINE void api429_fifo_enc_free(struct api429_fifo_enc* enc)
+{
+    free(enc);
+}
+
+
+/*! \brief Build a data word entry
+ *
+ * Same as \ref Api429TxFifoDataWordCreate
+ * @param [in] enc the encoder
+ * @param [out] entry the entry to build
+ * @param [in] data the Arinc 429 data word
+ * @param [in] gap gap following the data word in bit times. Clipped with \ref api429_timing_gap_clip
+ * @param [in] error error type to inject. See \ref api429_xfer_error
+ */
+static AI_INLINE void api429_fifo_enc_word(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entry,
+                                           AiUInt32 data, AiUInt32 gap, enum api429_xfer_error error)
+{
+    const struct api429_tx_fifo_entry* base = &enc->word[api429_timing_gap_clip(gap)][error];
+
+    if(enc->data_plain)
+    {
+        entry->ulControl = base->ulControl;
+        entry->ulData    = base->ulData ^ data;
+        return;
+    }
+
+    api429_fifo_enc_linear_apply(&enc->data, data, entry);
+    entry->ulControl ^= base->ulControl;
+    entry->ulData    ^= base->ulData;
+}
+
+
+/*! \brief Build a delay entry
+ *
+ * Same as \ref Api429TxFifoDelayCreate
+ */
+static AI_INLINE void api429_fifo_enc_delay(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entry, AiUInt32 time_100_usec)
+{
+    api429_fifo_enc_linear_apply(&enc->delay, time_100_usec, entry);
+}
+
+
+/*! \brief Build an interrupt entry
+ *
+ * Same as \ref Api429TxFifoInterruptCreate
+ */
+static AI_INLINE void api429_fifo_enc_interrupt(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entry, AiUInt32 tag)
+{
+    *entry = enc->interrupt[tag & 0xFF];
+}
+
+
+/*! \brief Build a trigger pulse entry
+ *
+ * Same as \ref Api429TxFifoTriggerPulseCreate
+ */
+static AI_INLINE void api429_fifo_enc_trigger_pulse(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entry, AiUInt32 trigger_line)
+{
+    *entry = enc->trigger_pulse[trigger_line & (API429_FIFO_ENC_TRIGGER_LINES - 1)];
+}
+
+
+/*! \brief Build a trigger wait entry
+ *
+ * Same as \ref Api429TxFifoTriggerWaitCreate
+ */
+static AI_INLINE void api429_fifo_enc_trigger_wait(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entry, AiUInt32 trigger_line)
+{
+    *entry = enc->trigger_wait[trigger_line & (API429_FIFO_ENC_TRIGGER_LINES - 1)];
+}
+
+
+/*! \brief Build data word entries with the same gap and error type
+ *
+ * @param [in] enc the encoder
+ * @param [out] entries array the entries are built in. Must hold 'count' entries
+ * @param [in] words Arinc 429 data words
+ * @param [in] count number of data words
+ * @param [in] gap gap following each data word in bit times. Clipped with \ref api429_timing_gap_clip
+ * @param [in] error error type to inject. See \ref api429_xfer_error
+ */
+static AI_INLINE void api429_fifo_enc_words(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entries,
+                                            const AiUInt32* words, AiUInt32 count, AiUInt32 gap, enum api429_xfer_error error)
+{
+    const struct api429_tx_fifo_entry base = enc->word[api429_timing_gap_clip(gap)][error];
+    AiUInt32 i;
+
+    if(!enc->data_plain)
+    {
+        for(i = 0; i < count; i++)
+        {
+            api429_fifo_enc_word(enc, &entries[i], words[i], gap, error);
+        }
+        return;
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        entries[i].ulControl = base.ulControl;
+        entries[i].ulData    = base.ulData ^ words[i];
+    }
+}
+
+
+/*! \brief Build data word entries with individual gaps
+ *
+ * @param [in] enc the encoder
+ * @param [out] entries array the entries are built in. Must hold 'count' entries
+ * @param [in] words Arinc 429 data words
+ * @param [in] gaps gap following each data word in bit times. Clipped with \ref api429_timing_gap_clip
+ * @param [in] count number of data words
+ * @param [in] error error type to inject. See \ref api429_xfer_error
+ */
+static AI_INLINE void api429_fifo_enc_words_gaps(const struct api429_fifo_enc* enc, struct api429_tx_fifo_entry* entries,
+                                                 const AiUInt32* words, const AiUInt8* gaps, AiUInt32 count,
+                                                 enum api429_xfer_error error)
+{
+    AiUInt32 i;
+
+    for(i = 0; i < count; i++)
+    {
+        api429_fifo_enc_word(enc, &entries[i], words[i], gaps[i], error);
+    }
+}
+
+
+/*! \brief Compare the encoder with the library
+ *
+ * Builds entries of all types with random parameters both with the encoder and the library functions
+ * and compares them bit by bit.
+ * @param [in] enc the encoder
+ * @param [in] samples number of random parameter sets per entry type
+ * @param [in] seed seed of the random parameters
+ * @param [out] mismatches number of entries that differ is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_fifo_enc_verify(const struct api429_fifo_enc* enc, AiUInt32 samples, AiUInt32 seed, AiUInt32* mismatches)
+{
+    struct api429_tx_fifo_entry expected;
+    struct api429_tx_fifo_entry actual;
+    AiUInt32 state = seed ? seed : 1;
+    AiUInt32 data, gap, error, time;
+    AiReturn ret = API_OK;
+    AiUInt32 i;
+
+    if(!enc || !mismatches)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *mismatches = 0;
+
+    for(i = 0; i < samples && ret == API_OK; i++)
+    {
+        /* xorshift32 */
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        data = state;
+        state ^= state << 13; state ^= state >> 17; state ^= state << 5;
+        gap   = api429_timing_gap_clip(state & API429_MAX_GAP_BITS);
+        error = (state >> 8) % API429_FIFO_ENC_ERRORS;
+        time  = enc->delay.bits < 32 ? (state >> 11) & ((1u << enc->delay.bits) - 1) : state >> 11;
+
+        ret = Api429TxFifoDataWordCreate(&expected, data, gap, (enum api429_xfer_error) error);
+        api429_fifo_enc_word(enc, &actual, data, gap, (enum api429_xfer_error) error);
+        *mismatches += ret == API_OK && memcmp(&expected, &actual, sizeof(expected)) ? 1 : 0;
+
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoDelayCreate(&expected, time);
+            api429_fifo_enc_delay(enc, &actual, time);
+            *mismatches += ret == API_OK && memcmp(&expected, &actual, sizeof(expected)) ? 1 : 0;
+        }
+
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoInterruptCreate(&expected, data & 0xFF);
+            api429_fifo_enc_interrupt(enc, &actual, data & 0xFF);
+            *mismatches += ret == API_OK && memcmp(&expected, &actual, sizeof(expected)) ? 1 : 0;
+        }
+
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoTriggerPulseCreate(&expected, data & 3);
+            api429_fifo_enc_trigger_pulse(enc, &actual, data & 3);
+            *mismatches += ret == API_OK && memcmp(&expected, &actual, sizeof(expected)) ? 1 : 0;
+        }
+
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoTriggerWaitCreate(&expected, (data >> 2) & 3);
+            api429_fifo_enc_trigger_wait(enc, &actual, (data >> 2) & 3);
+            *mismatches += ret == API_OK && memcmp(&expected, &actual, sizeof(expected)) ? 1 : 0;
+        }
+    }
+
+    return ret;
+}
+
+
+/*! \brief Create an encoder
+ *
+ * Learns the encoding of all entry types from the library and checks it with \ref api429_fifo_enc_verify.
+ * @param [out] enc_out the created encoder is stored here. Must be released with \ref api429_fifo_enc_free
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_FUNCTION_NOT_IMPLEMENTED if the library encoding can not be reproduced by the encoder
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_fifo_enc_create(struct api429_fifo_enc** enc_out)
+{
+    struct api429_fifo_enc* enc;
+    AiUInt32 mismatches = 0;
+    AiReturn ret = API_OK;
+    AiUInt32 i, k;
+
+    if(!enc_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *enc_out = NULL;
+
+    enc = (struct api429_fifo_enc*) calloc(1, sizeof(struct api429_fifo_enc));
+    if(!enc)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    for(i = API429_MIN_GAP_BITS; i <= API429_MAX_GAP_BITS && ret == API_OK; i++)
+    {
+        for(k = 0; k < API429_FIFO_ENC_ERRORS && ret == API_OK; k++)
+        {
+            ret = Api429TxFifoDataWordCreate(&enc->word[i][k], 0, i, (enum api429_xfer_error) k);
+        }
+    }
+
+    if(ret == API_OK)
+    {
+        API429_FIFO_ENC_LINEAR_LEARN(&enc->data, ret, api429_fifo_enc_data_probe, data);
+    }
+
+    if(ret == API_OK)
+    {
+        API429_FIFO_ENC_LINEAR_LEARN(&enc->delay, ret, Api429TxFifoDelayCreate, time);
+    }
+
+    for(i = 0; i < 256 && ret == API_OK; i++)
+    {
+        ret = Api429TxFifoInterruptCreate(&enc->interrupt[i], i);
+    }
+
+    for(i = 0; i < API429_FIFO_ENC_TRIGGER_LINES && ret == API_OK; i++)
+    {
+        ret = Api429TxFifoTriggerPulseCreate(&enc->trigger_pulse[i], i);
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoTriggerWaitCreate(&enc->trigger_wait[i], i);
+        }
+    }
+
+    if(ret != API_OK)
+    {
+        free(enc);
+        return ret;
+    }
+
+    /* Usually the data word is stored unchanged and does not affect the control word */
+    enc->data_plain = enc->data.bits == 32 && enc->data.base.ulData == 0 ? AiTrue : AiFalse;
+    for(i = 0; i < 32 && enc->data_plain; i++)
+    {
+        enc->data_plain = enc->data.bit[i].ulControl == 0 && enc->data.bit[i].ulData == (1u << i) ? AiTrue : AiFalse;
+    }
+
+    /* The data word table holds entries with data 0, so the data encoding must not include them */
+    enc->data.base.ulControl = 0;
+    enc->data.base.ulData    = 0;
+
+    /* The tables are only valid if the library encodes each parameter bit independently */
+    ret = api429_fifo_enc_verify(enc, API429_FIFO_ENC_CHECK_SAMPLES, 1, &mismatches);
+    if(ret == API_OK && mismatches)
+    {
+        ret = AI429_ERR_FUNCTION_NOT_IMPLEMENTED;
+    }
+
+    if(ret != API_OK)
+    {
+        free(enc);
+        return ret;
+    }
+
+    *enc_out = enc;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXFIFOENC_H_ */
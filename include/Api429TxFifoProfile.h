@@ -0,0 +1,524 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxFifoProfile.h
+ *
+ *  This header file contains inline helper functions
+ *  for detecting transmit FIFO underruns and profiling FIFO latencies
+ */
+
+#ifndef API429TXFIFOPROFILE_H_
+#define API429TXFIFOPROFILE_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Histogram.h"
+#include "Api429Timing.h"
+#include "Ai_clock.h"
+#include "Ai_mutex.h"
+
+
+/**
+* \defgroup tx_fifo_profile FIFO Profiler
+  This module instruments the refill path of a channel initialized with \ref API429_TX_MODE_FIFO. \n
+  \ref api429_tx_fifo_profile_write replaces \ref Api429TxFifoWrite. It samples
+  api429_tx_fifo_status.ulEntriesToSend before each refill and appends an interrupt entry (\ref Api429TxFifoInterruptCreate)
+  as marker behind the written entries. The marker tags are taken from a range reserved for the profiler,
+  so the application can still use the other tags. \n
+  When a marker interrupt is passed to \ref api429_tx_fifo_profile_event, all entries in front of it are on the bus.
+  This gives the latency from enqueueing the entries on host side to the bus and the time the entries spent in the board FIFO.
+  If no entries were written behind the marker yet, the FIFO ran empty: an underrun starts and lasts until the next refill. \n
+  \ref api429_tx_fifo_profile_recommend derives a FIFO size and a refill threshold from the measured refill intervals.
+* @{
+*/
+
+
+
+/*! \def API429_TX_FIFO_PROFILE_MAX_TAGS
+ * Number of interrupt tags available
+ */
+#define API429_TX_FIFO_PROFILE_MAX_TAGS     256
+
+
+
+/*! \struct api429_tx_fifo_profile_marker
+ *
+ * This structure describes a marker in the board FIFO
+ */
+struct api429_tx_fifo_profile_marker
+{
+    AiUInt64 enqueue_us;        /*!< Time the entries in front of the marker were enqueued on host side */
+    AiUInt64 write_us;          /*!< Time the marker was written to the board FIFO */
+    AiUInt64 position;          /*!< Number of entries ever written including the marker */
+    AiBoolean pending;          /*!< AiTrue until the interrupt of the marker was received */
+};
+
+/*! \typedef TY_API429_TX_FIFO_PROFILE_MARKER
+ * Convenience typedef for \ref api429_tx_fifo_profile_marker
+ */
+typedef struct api429_tx_fifo_profile_marker TY_API429_TX_FIFO_PROFILE_MARKER;
+
+
+/*! \struct api429_tx_fifo_profile_recommendation
+ *
+ * This structure holds FIFO dimensions derived from measurements
+ */
+struct api429_tx_fifo_profile_recommendation
+{
+    AiUInt32 fifo_size;             /*!< Minimum value for api429_tx_fifo_setup.ulFifoSize */
+    AiUInt32 refill_threshold;      /*!< Minimum number of entries to send at which a refill must start */
+    AiInt64 refill_interval_us;     /*!< Refill interval the values are based on */
+    AiUInt32 batch_max;             /*!< Largest number of entries written at once */
+};
+
+/*! \typedef TY_API429_TX_FIFO_PROFILE_RECOMMENDATION
+ * Convenience typedef for \ref api429_tx_fifo_profile_recommendation
+ */
+typedef struct api429_tx_fifo_profile_recommendation TY_API429_TX_FIFO_PROFILE_RECOMMENDATION;
+
+
+/*! \struct api429_tx_fifo_profile
+ *
+ * This structure holds the measurements of one FIFO based transmit channel.
+ * It is created with \ref api429_tx_fifo_profile_create
+ */
+struct api429_tx_fifo_profile
+{
+    AiUInt8 board_handle;                                               /*!< Handle to the board the channel belongs to */
+    AiUInt8 channel;                                                    /*!< ID of the transmit channel */
+    AiUInt32 fifo_size;                                                 /*!< Size of the board FIFO in entries */
+    AiUInt32 entry_time_ns;                                             /*!< Bus time of one entry with default gap */
+    AiUInt32 tag_first;                                                 /*!< First interrupt tag used for markers */
+    AiUInt32 tag_count;                                                 /*!< Number of interrupt tags used for markers */
+    AiUInt32 tag_next;                                                  /*!< Index of the tag used for the next marker */
+    struct api429_tx_fifo_profile_marker markers[API429_TX_FIFO_PROFILE_MAX_TAGS]; /*!< Markers by tag index */
+    struct ai_mutex* lock;                                              /*!< Serializes refills and events */
+    AiUInt64 written;                                                   /*!< Number of entries ever written including markers */
+    AiUInt64 last_write_us;                                             /*!< Time of the last refill */
+    AiUInt64 underrun_start_us;                                         /*!< Start of the current underrun, 0 if none */
+    AiUInt32 batch_max;                                                 /*!< Largest number of entries written at once */
+    AiUInt32 fill_min;                                                  /*!< Smallest number of entries to send sampled before a refill */
+    AiUInt64 samples;                                                   /*!< Number of status samples */
+    AiUInt64 empty_samples;                                             /*!< Number of status samples with an empty FIFO */
+    AiUInt64 underruns;                                                 /*!< Number of underruns detected by markers */
+    AiUInt64 markers_lost;                                              /*!< Number of markers reused before their interrupt was received */
+    AiUInt64 empty_events;                                              /*!< Number of FIFO interrupts that were no markers */
+    struct api429_histogram latency;                                    /*!< Time from enqueueing on host side to the bus */
+    struct api429_histogram fifo_latency;                               /*!< Time from writing to the board FIFO to the bus */
+    struct api429_histogram headroom;                                   /*!< Bus time of the entries to send, sampled before each refill */
+    struct api429_histogram refill_interval;                            /*!< Time between two refills */
+    struct api429_histogram underrun_time;                              /*!< Duration of underruns */
+};
+
+/*! \typedef TY_API429_TX_FIFO_PROFILE
+ * Convenience typedef for \ref api429_tx_fifo_profile
+ */
+typedef struct api429_tx_fifo_profile TY_API429_TX_FIFO_PROFILE;
+
+
+
+
+/*! \brief Release a profiler
+ *
+ * @param profile profiler to release. May be NULL
+ */
+static AI_INLINE void api429_tx_fifo_profile_free(struct api429_tx_fifo_profile* profile)
+{
+    if(!profile)
+    {
+        return;
+    }
+
+    if(profile->lock)
+    {
+        ai_mutex_free(profile->lock);
+    }
+
+    free(profile);
+}
+
+
+/*! \brief Clear all measurements of a profiler
+ *
+ * Markers that are still in the board FIFO are ignored when their interrupt is received.
+ * @param [in] profile the profiler
+ */
+static AI_INLINE void api429_tx_fifo_profile_reset(struct api429_tx_fifo_profile* profile)
+{
+    AiUInt32 i;
+
+    ai_mutex_lock(profile->lock);
+
+    for(i = 0; i < API429_TX_FIFO_PROFILE_MAX_TAGS; i++)
+    {
+        profile->markers[i].pending = AiFalse;
+    }
+
+    profile->last_write_us     = 0;
+    profile->underrun_start_us = 0;
+    profile->batch_max         = 0;
+    profile->fill_min          = profile->fifo_size;
+    profile->samples           = 0;
+    profile->empty_samples     = 0;
+    profile->underruns         = 0;
+    profile->markers_lost      = 0;
+    profile->empty_events      = 0;
+
+    api429_histogram_init(&profile->latency);
+    api429_histogram_init(&profile->fifo_latency);
+    api429_histogram_init(&profile->headroom);
+    api429_histogram_init(&profile->refill_interval);
+    api429_histogram_init(&profile->underrun_time);
+
+    ai_mutex_release(profile->lock);
+}
+
+
+/*! \brief Create a profiler
+ *
+ * @param [in] board_handle handle to the board the channel belongs to
+ * @param [in] channel ID of the transmit channel
+ * @param [in] speed speed of the channel
+ * @param [in] tag_first first interrupt tag reserved for markers
+ * @param [in] tag_count number of interrupt tags reserved for markers. Limits the number of refills the FIFO may hold at a time
+ * @param [out] profile_out the created profiler is stored here. Must be released with \ref api429_tx_fifo_profile_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_profile_create(AiUInt8 board_handle, AiUInt8 channel, enum api429_speed speed,
+                                                        AiUInt32 tag_first, AiUInt32 tag_count,
+                                                        struct api429_tx_fifo_profile** profile_out)
+{
+    struct api429_tx_fifo_profile* profile;
+    struct api429_tx_fifo_setup setup;
+    AiReturn ret;
+
+    if(!profile_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *profile_out = NULL;
+
+    if(!tag_count || tag_first + tag_count > API429_TX_FIFO_PROFILE_MAX_TAGS)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    ret = Api429TxFifoSetupGet(board_handle, channel, &setup);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    profile = (struct api429_tx_fifo_profile*) calloc(1, sizeof(struct api429_tx_fifo_profile));
+    if(!profile)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    profile->board_handle  = board_handle;
+    profile->channel       = channel;
+    profile->fifo_size     = setup.ulFifoSize;
+    profile->entry_time_ns = api429_timing_word_time_ns(speed, setup.ulDefaultGapSize);
+    profile->tag_first     = tag_first;
+    profile->tag_count     = tag_count;
+    profile->lock          = ai_mutex_create();
+
+    if(!profile->lock)
+    {
+        api429_tx_fifo_profile_free(profile);
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    api429_tx_fifo_profile_reset(profile);
+
+    *profile_out = profile;
+
+    return API_OK;
+}
+
+
+/*! \brief Record a FIFO status sample
+ *
+ * Must be called with the lock held.
+ */
+static AI_INLINE void api429_tx_fifo_profile_sample_add(struct api429_tx_fifo_profile* profile, const struct api429_tx_fifo_status* status)
+{
+    profile->samples++;
+
+    if(!status->ulEntriesToSend)
+    {
+        profile->empty_samples++;
+    }
+
+    if(status->ulEntriesToSend < profile->fill_min)
+    {
+        profile->fill_min = status->ulEntriesToSend;
+    }
+
+    api429_histogram_add(&profile->headroom, (AiInt64) status->ulEntriesToSend * profile->entry_time_ns / 1000);
+}
+
+
+/*! \brief Sample the FIFO status
+ *
+ * May be called cyclically in addition to the samples taken by \ref api429_tx_fifo_profile_write.
+ * @param [in] profile the profiler
+ * @param [out] status the sampled status is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_profile_sample(struct api429_tx_fifo_profile* profile, struct api429_tx_fifo_status* status)
+{
+    struct api429_tx_fifo_status sample;
+    AiReturn ret;
+
+    if(!profile)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ret = Api429TxFifoStatusGet(profile->board_handle, profile->channel, &sample);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    ai_mutex_lock(profile->lock);
+    api429_tx_fifo_profile_sample_add(profile, &sample);
+    ai_mutex_release(profile->lock);
+
+    if(status)
+    {
+        *status = sample;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Write entries to the board FIFO followed by a marker
+ *
+ * Replaces \ref Api429TxFifoWrite in non-blocking mode. One entry of the board FIFO is reserved for the marker,
+ * so nothing is written unless at least two entries are free.
+ * The marker is only written if all entries were written.
+ * @param [in] profile the profiler
+ * @param [in] entries the FIFO entries
+ * @param [in] count number of entries
+ * @param [in] enqueue_us time in microseconds (see \ref ai_clock_us) the entries were enqueued on host side
+ * @param [out] written number of entries written, not including the marker, is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_fifo_profile_write(struct api429_tx_fifo_profile* profile, struct api429_tx_fifo_entry* entries,
+                                                       AiUInt32 count, AiUInt64 enqueue_us, AiUInt32* written)
+{
+    struct api429_tx_fifo_profile_marker* marker;
+    struct api429_tx_fifo_status status;
+    struct api429_tx_fifo_entry entry;
+    AiUInt32 tag_index;
+    AiUInt32 marker_written = 0;
+    AiUInt64 now;
+    AiReturn ret;
+
+    if(!profile || !written || (!entries && count))
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *written = 0;
+
+    ret = Api429TxFifoStatusGet(profile->board_handle, profile->channel, &status);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    /* A marker without data entries would only measure the marker itself */
+    if(status.ulEntriesFree < 2 || !count)
+    {
+        return API_OK;
+    }
+
+    count = status.ulEntriesFree - 1 < count ? status.ulEntriesFree - 1 : count;
+
+    ai_mutex_lock(profile->lock);
+
+    api429_tx_fifo_profile_sample_add(profile, &status);
+
+    ret = Api429TxFifoWrite(profile->board_handle, profile->channel, count, entries, AiFalse, written);
+
+    tag_index = profile->tag_next;
+
+    if(ret == API_OK && *written == count)
+    {
+        ret = Api429TxFifoInterruptCreate(&entry, profile->tag_first + tag_index);
+        if(ret == API_OK)
+        {
+            ret = Api429TxFifoWrite(profile->board_handle, profile->channel, 1, &entry, AiFalse, &marker_written);
+        }
+    }
+
+    now = ai_clock_us();
+    profile->written += *written + marker_written;
+
+    if(*written + marker_written)
+    {
+        /* A pending underrun ends with the first entries written behind the last marker */
+        if(profile->underrun_start_us)
+        {
+            api429_histogram_add(&profile->underrun_time, (AiInt64) (now - profile->underrun_start_us));
+            profile->underrun_start_us = 0;
+        }
+
+        if(profile->last_write_us)
+        {
+            api429_histogram_add(&profile->refill_interval, (AiInt64) (now - profile->last_write_us));
+        }
+
+        profile->last_write_us = now;
+        profile->batch_max     = *written > profile->batch_max ? *written : profile->batch_max;
+    }
+
+    if(marker_written)
+    {
+        marker = &profile->markers[tag_index];
+        if(marker->pending)
+        {
+            profile->markers_lost++;
+        }
+
+        marker->enqueue_us = enqueue_us;
+        marker->write_us   = now;
+        marker->position   = profile->written;
+        marker->pending    = AiTrue;
+
+        profile->tag_next = (tag_index + 1) % profile->tag_count;
+    }
+
+    ai_mutex_release(profile->lock);
+
+    return ret;
+}
+
+
+/*! \brief Process a channel event
+ *
+ * Must be called from the event handler of the channel for each event.
+ * @param [in] profile the profiler
+ * @param [in] type type of the event
+ * @param [in] info additional event information as passed to the event handler
+ * @return AiTrue if the event was raised by one of the markers, AiFalse otherwise
+ */
+static AI_INLINE AiBoolean api429_tx_fifo_profile_event(struct api429_tx_fifo_profile* profile, enum api429_event_type type,
+                                                        const struct api429_intr_loglist_entry* info)
+{
+    struct api429_tx_fifo_profile_marker* marker;
+    AiUInt32 tag;
+    AiUInt64 now;
+
+    if(!profile || !info || type != API429_EVENT_TX_FIFO)
+    {
+        return AiFalse;
+    }
+
+    now = ai_clock_us();
+    tag = API429_CHANNEL_EVENT_TAG(info);
+
+    ai_mutex_lock(profile->lock);
+
+    if(tag < profile->tag_first || tag >= profile->tag_first + profile->tag_count)
+    {
+        profile->empty_events++;
+        ai_mutex_release(profile->lock);
+        return AiFalse;
+    }
+
+    marker = &profile->markers[tag - profile->tag_first];
+
+    if(marker->pending)
+    {
+        marker->pending = AiFalse;
+
+        api429_histogram_add(&profile->latency, (AiInt64) (now - marker->enqueue_us));
+        api429_histogram_add(&profile->fifo_latency, (AiInt64) (now - marker->write_us));
+
+        /* Nothing was written behind the marker, so the FIFO is empty now */
+        if(marker->position == profile->written && !profile->underrun_start_us)
+        {
+            profile->underrun_start_us = now;
+            profile->underruns++;
+        }
+    }
+
+    ai_mutex_release(profile->lock);
+
+    return AiTrue;
+}
+
+
+/*! \brief Derive FIFO dimensions from the measurements
+ *
+ * The refill threshold is the number of entries sent during the given percentile of the refill interval.
+ * The FIFO must hold this number of entries plus the largest refill.
+ * @param [in] profile the profiler
+ * @param [in] percent percentile of the refill interval to cover, e.g. 99.9
+ * @param [out] recommendation the derived values are stored here
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_PARAMETER_RANGE if not enough refills were measured
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_fifo_profile_recommend(struct api429_tx_fifo_profile* profile, AiDouble percent,
+                                                           struct api429_tx_fifo_profile_recommendation* recommendation)
+{
+    AiUInt64 threshold;
+
+    if(!profile || !recommendation)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    ai_mutex_lock(profile->lock);
+
+    if(!profile->refill_interval.count || !profile->entry_time_ns)
+    {
+        ai_mutex_release(profile->lock);
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    recommendation->refill_interval_us = api429_histogram_percentile(&profile->refill_interval, percent);
+    recommendation->batch_max          = profile->batch_max;
+
+    threshold = ((AiUInt64) recommendation->refill_interval_us * 1000 + profile->entry_time_ns - 1) / profile->entry_time_ns;
+
+    /* One entry more for the marker */
+    recommendation->refill_threshold = (AiUInt32) threshold;
+    recommendation->fifo_size        = (AiUInt32) threshold + profile->batch_max + 1;
+
+    ai_mutex_release(profile->lock);
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXFIFOPROFILE_H_ */
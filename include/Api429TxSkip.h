@@ -0,0 +1,310 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxSkip.h
+ *
+ *  This header file contains inline helper functions
+ *  for skipping groups of transfers at once
+ */
+
+#ifndef API429TXSKIP_H_
+#define API429TXSKIP_H_
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Api429.h"
+#include "Ai_clock.h"
+
+
+/**
+* \defgroup tx_skip Transfer Skip Groups
+  This module enables and disables named groups of transfers, possibly spread over several channels, with one call. \n
+  Each member is changed with \ref Api429TxXferSkip. Writing the skip bits directly into the transfer descriptors
+  (\ref API429_MEM_OBJ_XFER) would not save board accesses: the skip words of different descriptors are not adjacent,
+  so each member still needs its own write, and the rest of a descriptor word is updated by the firmware while the channel
+  is running, so a read-modify-write from the host could overwrite these updates. \ref Api429TxXferSkip per transfer
+  is the only safe way. \n
+  The duration of each toggle is recorded, so it can be checked against the minor frame time.
+* @{
+*/
+
+
+
+/*! \def API429_TX_SKIP_NAME_LEN
+ * Maximum length of a group name including terminating zero
+ */
+#define API429_TX_SKIP_NAME_LEN         32
+
+
+
+/*! \struct api429_tx_skip_xfer
+ *
+ * This structure identifies a transfer that is a member of a skip group
+ */
+struct api429_tx_skip_xfer
+{
+    AiUInt8 channel;    /*!< ID of the transmit channel the transfer was created on */
+    AiUInt32 xfer_id;   /*!< ID of the transfer */
+};
+
+/*! \typedef TY_API429_TX_SKIP_XFER
+ * Convenience typedef for \ref api429_tx_skip_xfer
+ */
+typedef struct api429_tx_skip_xfer TY_API429_TX_SKIP_XFER;
+
+
+/*! \struct api429_tx_skip_group
+ *
+ * This structure describes a named group of transfers that are skipped together
+ */
+struct api429_tx_skip_group
+{
+    char name[API429_TX_SKIP_NAME_LEN];     /*!< Name of the group */
+    AiUInt32 member_count;                  /*!< Number of transfers in the group */
+    struct api429_tx_skip_xfer* members;    /*!< Transfers of the group */
+    AiBoolean skipped;                      /*!< AiTrue if the group was skipped last by \ref api429_tx_skip_group_set */
+    AiUInt64 last_toggle_us;                /*!< Duration of the last toggle in microseconds */
+    AiUInt64 max_toggle_us;                 /*!< Longest duration of a toggle in microseconds */
+};
+
+/*! \typedef TY_API429_TX_SKIP_GROUP
+ * Convenience typedef for \ref api429_tx_skip_group
+ */
+typedef struct api429_tx_skip_group TY_API429_TX_SKIP_GROUP;
+
+
+/*! \struct api429_tx_skip_engine
+ *
+ * This structure holds all skip groups of a board.
+ * It is created with \ref api429_tx_skip_create
+ */
+struct api429_tx_skip_engine
+{
+    AiUInt8 board_handle;                   /*!< Handle to the board */
+    AiUInt32 group_count;                   /*!< Number of groups */
+    AiUInt32 group_capacity;                /*!< Number of allocated groups */
+    struct api429_tx_skip_group* groups;    /*!< All groups */
+};
+
+/*! \typedef TY_API429_TX_SKIP_ENGINE
+ * Convenience typedef for \ref api429_tx_skip_engine
+ */
+typedef struct api429_tx_skip_engine TY_API429_TX_SKIP_ENGINE;
+
+
+
+
+/*! \brief Create a skip engine
+ *
+ * @param [in] board_handle handle to the board
+ * @param [out] engine_out the created engine is stored here. Must be released with \ref api429_tx_skip_free
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_skip_create(AiUInt8 board_handle, struct api429_tx_skip_engine** engine_out)
+{
+    struct api429_tx_skip_engine* engine;
+
+    if(!engine_out)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    *engine_out = NULL;
+
+    engine = (struct api429_tx_skip_engine*) calloc(1, sizeof(struct api429_tx_skip_engine));
+    if(!engine)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    engine->board_handle = board_handle;
+
+    *engine_out = engine;
+
+    return API_OK;
+}
+
+
+/*! \brief Release a skip engine
+ *
+ * The skip state of the transfers is not changed.
+ * @param engine engine to release. May be NULL
+ */
+static AI_INLINE void api429_tx_skip_free(struct api429_tx_skip_engine* engine)
+{
+    AiUInt32 i;
+
+    if(!engine)
+    {
+        return;
+    }
+
+    for(i = 0; i < engine->group_count; i++)
+    {
+        free(engine->groups[i].members);
+    }
+
+    free(engine->groups);
+    free(engine);
+}
+
+
+/*! \brief Add a named group of transfers
+ *
+ * The skip state of the transfers is not changed.
+ * @param [in] engine the engine
+ * @param [in] name name of the group. Truncated to \ref API429_TX_SKIP_NAME_LEN - 1 characters
+ * @param [in] xfers transfers of the group. Will be copied
+ * @param [in] count number of transfers
+ * @param [out] group_index index of the new group is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_skip_group_add(struct api429_tx_skip_engine* engine, const char* name,
+                                                   const struct api429_tx_skip_xfer* xfers, AiUInt32 count, AiUInt32* group_index)
+{
+    struct api429_tx_skip_group* groups;
+    struct api429_tx_skip_group* group;
+    AiUInt32 capacity;
+
+    if(!engine || !name || !xfers)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(count == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    if(engine->group_count == engine->group_capacity)
+    {
+        capacity = engine->group_capacity ? engine->group_capacity * 2 : 8;
+        groups   = (struct api429_tx_skip_group*) realloc(engine->groups, capacity * sizeof(struct api429_tx_skip_group));
+        if(!groups)
+        {
+            return AI429_ERR_NO_MORE_MEMORY;
+        }
+
+        engine->groups         = groups;
+        engine->group_capacity = capacity;
+    }
+
+    group = &engine->groups[engine->group_count];
+    memset(group, 0, sizeof(struct api429_tx_skip_group));
+
+    strncpy(group->name, name, API429_TX_SKIP_NAME_LEN - 1);
+    group->member_count = count;
+    group->members = (struct api429_tx_skip_xfer*) malloc(count * sizeof(struct api429_tx_skip_xfer));
+    if(!group->members)
+    {
+        return AI429_ERR_NO_MORE_MEMORY;
+    }
+
+    memcpy(group->members, xfers, count * sizeof(struct api429_tx_skip_xfer));
+
+    if(group_index)
+    {
+        *group_index = engine->group_count;
+    }
+
+    engine->group_count++;
+
+    return API_OK;
+}
+
+
+/*! \brief Find a group by name
+ *
+ * @param [in] engine the engine
+ * @param [in] name name of the group
+ * @param [out] group_index index of the group is stored here
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_PARAMETER_RANGE if no group with this name exists
+ */
+static AI_INLINE AiReturn api429_tx_skip_group_find(const struct api429_tx_skip_engine* engine, const char* name, AiUInt32* group_index)
+{
+    AiUInt32 i;
+
+    if(!engine || !name || !group_index)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(i = 0; i < engine->group_count; i++)
+    {
+        if(!strncmp(engine->groups[i].name, name, API429_TX_SKIP_NAME_LEN - 1))
+        {
+            *group_index = i;
+            return API_OK;
+        }
+    }
+
+    return AI429_ERR_PARAMETER_RANGE;
+}
+
+
+/*! \brief Skip or send all transfers of a group
+ *
+ * @param [in] engine the engine
+ * @param [in] group_index index of the group
+ * @param [in] skip if AiTrue the transfers are skipped, if AiFalse they are sent
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_skip_group_set(struct api429_tx_skip_engine* engine, AiUInt32 group_index, AiBoolean skip)
+{
+    struct api429_tx_skip_group* group;
+    AiUInt64 start = ai_clock_us();
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!engine)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(group_index >= engine->group_count)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    group = &engine->groups[group_index];
+
+    for(i = 0; i < group->member_count; i++)
+    {
+        ret = Api429TxXferSkip(engine->board_handle, group->members[i].channel, skip, group->members[i].xfer_id);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    group->skipped        = skip ? AiTrue : AiFalse;
+    group->last_toggle_us = ai_clock_us() - start;
+    group->max_toggle_us  = group->last_toggle_us > group->max_toggle_us ? group->last_toggle_us : group->max_toggle_us;
+
+    return API_OK;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXSKIP_H_ */
@@ -0,0 +1,459 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxSync.h
+ *
+ *  This header file contains inline helper functions
+ *  for starting several transmit channels synchronously
+ */
+
+#ifndef API429TXSYNC_H_
+#define API429TXSYNC_H_
+
+
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Codec.h"
+#include "Api429Timing.h"
+#include "Ai_clock.h"
+
+
+/**
+* \defgroup tx_sync Synchronized Transmitter Start
+  This module starts several transmit channels of a board at the same time. \n
+  Starting channels one after another with \ref Api429ChannelStart results in a skew that grows with the number of channels.
+  Instead all channels are armed first, and then started by the board at a common point of time: \n
+  - \ref API429_TX_SYNC_TTAG arms each channel with \ref Api429TxStartOnTTag for an IRIG time shortly
+    in the future. An individual phase offset can be given for each channel. As IRIG start times have a resolution of one
+    millisecond and the board compares them every 500us, phase offsets are rounded to milliseconds.
+  - \ref API429_TX_SYNC_TRIGGER arms each channel with \ref Api429TxStartOnTrigger, so all channels start on
+    the same strobe of a trigger input line. No phase offsets are possible in this mode. \n
+
+  The residual skew can be measured afterwards from the first data word each channel sends, as received
+  by a monitor channel in loopback. \ref api429_tx_sync_calibrate turns the measured static offsets into
+  corrections that are applied to the next start.
+* @{
+*/
+
+
+
+/*! \def API429_TX_SYNC_MAX_CHANNELS
+ * Maximum number of channels that can be started synchronously
+ */
+#define API429_TX_SYNC_MAX_CHANNELS     32
+
+/*! \def API429_TX_SYNC_RM_BLOCK
+ * Number of monitor entries read at once when measuring skew
+ */
+#define API429_TX_SYNC_RM_BLOCK         64
+
+/*! \def API429_TX_SYNC_SDI_ANY
+ * Value for 'sdi' of \ref api429_tx_sync_channel that matches data words with any SDI
+ */
+#define API429_TX_SYNC_SDI_ANY          0xFF
+
+/*! \def API429_TX_SYNC_LABEL_ANY
+ * Value for 'label' of \ref api429_tx_sync_channel that matches any data word
+ */
+#define API429_TX_SYNC_LABEL_ANY        0xFFFF
+
+
+
+/*! \enum api429_tx_sync_mode
+ *
+ * Enumeration of all ways to start channels synchronously
+ */
+enum api429_tx_sync_mode
+{
+    API429_TX_SYNC_TTAG = 0,    /*!< Start channels at an IRIG time with \ref Api429TxStartOnTTag */
+    API429_TX_SYNC_TRIGGER      /*!< Start channels on a trigger input strobe with \ref Api429TxStartOnTrigger */
+};
+
+/*! \typedef TY_E_API429_TX_SYNC_MODE
+ * Convenience typedef for \ref api429_tx_sync_mode
+ */
+typedef enum api429_tx_sync_mode TY_E_API429_TX_SYNC_MODE;
+
+
+/*! \struct api429_tx_sync_channel
+ *
+ * This structure describes one channel of a synchronized start
+ */
+struct api429_tx_sync_channel
+{
+    AiUInt8 channel;            /*!< ID of the transmit channel */
+    AiUInt8 rm_channel;         /*!< ID of the channel that monitors the transmit channel in loopback */
+    AiUInt16 label;             /*!< Label number of the first data word the channel sends, or \ref API429_TX_SYNC_LABEL_ANY */
+    AiUInt8 sdi;                /*!< SDI of the first data word the channel sends, or \ref API429_TX_SYNC_SDI_ANY */
+    AiInt32 phase_us;           /*!< Requested start delay relative to the common start time in microseconds */
+    AiInt32 correction_us;      /*!< Correction of start time as calculated by \ref api429_tx_sync_calibrate */
+    AiInt64 start_us;           /*!< Scheduled start time in microseconds of day. Only valid in \ref API429_TX_SYNC_TTAG mode */
+    AiInt64 first_rx_us;        /*!< Time tag of the first received data word in microseconds of day. -1 if not received yet */
+    AiInt64 residual_us;        /*!< Deviation of the measured start from the requested phase in microseconds */
+};
+
+/*! \typedef TY_API429_TX_SYNC_CHANNEL
+ * Convenience typedef for \ref api429_tx_sync_channel
+ */
+typedef struct api429_tx_sync_channel TY_API429_TX_SYNC_CHANNEL;
+
+
+/*! \struct api429_tx_sync
+ *
+ * This structure holds a synchronized start of several transmit channels.
+ * It is initialized with \ref api429_tx_sync_init
+ */
+struct api429_tx_sync
+{
+    AiUInt8 board_handle;                                           /*!< Handle to the board the channels belong to */
+    enum api429_tx_sync_mode mode;                                  /*!< Start mode */
+    AiUInt32 trigger_line;                                          /*!< Trigger input line in \ref API429_TX_SYNC_TRIGGER mode */
+    AiUInt32 lead_us;                                               /*!< Time between arming and start in \ref API429_TX_SYNC_TTAG mode */
+    AiUInt32 channel_count;                                         /*!< Number of channels */
+    struct api429_tx_sync_channel channels[API429_TX_SYNC_MAX_CHANNELS]; /*!< All channels to start */
+    AiUInt32 day;                                                   /*!< Day of year of the common start time */
+    AiInt64 target_us;                                              /*!< Common start time in microseconds of day */
+    AiInt64 max_skew_us;                                            /*!< Largest difference of the residuals of all channels */
+    struct api429_rcv_stack_entry rm_scratch[API429_TX_SYNC_RM_BLOCK]; /*!< Buffer for reading monitor entries */
+};
+
+/*! \typedef TY_API429_TX_SYNC
+ * Convenience typedef for \ref api429_tx_sync
+ */
+typedef struct api429_tx_sync TY_API429_TX_SYNC;
+
+
+
+
+/*! \brief Initialize a synchronized start
+ *
+ * @param [out] sync the synchronized start to initialize
+ * @param [in] board_handle handle to the board the channels belong to
+ * @param [in] mode start mode. See \ref api429_tx_sync_mode
+ * @param [in] trigger_line trigger input line (0..3) in \ref API429_TX_SYNC_TRIGGER mode
+ * @param [in] lead_us time between arming and start in \ref API429_TX_SYNC_TTAG mode.
+ *             Must be long enough to arm all channels, e.g. 100000
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_sync_init(struct api429_tx_sync* sync, AiUInt8 board_handle, enum api429_tx_sync_mode mode,
+                                              AiUInt32 trigger_line, AiUInt32 lead_us)
+{
+    if(!sync)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(trigger_line > 3 || (mode == API429_TX_SYNC_TTAG && lead_us == 0))
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    memset(sync, 0, sizeof(struct api429_tx_sync));
+
+    sync->board_handle = board_handle;
+    sync->mode         = mode;
+    sync->trigger_line = trigger_line;
+    sync->lead_us      = lead_us;
+
+    return API_OK;
+}
+
+
+/*! \brief Add a channel to a synchronized start
+ *
+ * The channel has to be initialized and its transmission set up, but must not be started.
+ * @param [in] sync the synchronized start
+ * @param [in] channel ID of the transmit channel
+ * @param [in] rm_channel ID of the channel that monitors the transmit channel in loopback. Only used for measuring skew
+ * @param [in] phase_us start delay relative to the common start time in microseconds. Must be 0 in \ref API429_TX_SYNC_TRIGGER mode
+ * @param [in] label label number of the first data word the channel sends, or \ref API429_TX_SYNC_LABEL_ANY
+ * @param [in] sdi SDI of the first data word the channel sends, or \ref API429_TX_SYNC_SDI_ANY
+ * @return
+ * - API_OK on success
+ * - Appropriate error code otherwise
+ */
+static AI_INLINE AiReturn api429_tx_sync_channel_add(struct api429_tx_sync* sync, AiUInt8 channel, AiUInt8 rm_channel, AiInt32 phase_us,
+                                                     AiUInt16 label, AiUInt8 sdi)
+{
+    struct api429_tx_sync_channel* entry;
+
+    if(!sync)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(sync->channel_count >= API429_TX_SYNC_MAX_CHANNELS || phase_us < 0 || (sync->mode == API429_TX_SYNC_TRIGGER && phase_us != 0))
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    entry = &sync->channels[sync->channel_count++];
+    memset(entry, 0, sizeof(struct api429_tx_sync_channel));
+
+    entry->channel     = channel;
+    entry->rm_channel  = rm_channel;
+    entry->phase_us    = phase_us;
+    entry->label       = label;
+    entry->sdi         = sdi;
+    entry->first_rx_us = -1;
+
+    return API_OK;
+}
+
+
+/*! \brief Arm all channels
+ *
+ * In \ref API429_TX_SYNC_TTAG mode the common start time is the current board time plus the lead time,
+ * rounded up to the next millisecond. Each channel is started at the common start time plus its phase and correction. \n
+ * In \ref API429_TX_SYNC_TRIGGER mode the channels start with the next strobe on the trigger line.
+ * @param [in] sync the synchronized start
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_sync_arm(struct api429_tx_sync* sync)
+{
+    struct api429_tx_sync_channel* entry;
+    struct api429_time time;
+    AiInt64 start;
+    AiReturn ret;
+    AiUInt32 i;
+
+    if(!sync)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    if(sync->channel_count == 0)
+    {
+        return AI429_ERR_PARAMETER_RANGE;
+    }
+
+    for(i = 0; i < sync->channel_count; i++)
+    {
+        sync->channels[i].first_rx_us = -1;
+        sync->channels[i].residual_us = 0;
+    }
+
+    sync->max_skew_us = 0;
+
+    if(sync->mode == API429_TX_SYNC_TRIGGER)
+    {
+        for(i = 0; i < sync->channel_count; i++)
+        {
+            ret = Api429TxStartOnTrigger(sync->board_handle, sync->channels[i].channel, sync->trigger_line);
+            if(ret != API_OK)
+            {
+                return ret;
+            }
+        }
+
+        return API_OK;
+    }
+
+    ret = Api429BoardTimeGet(sync->board_handle, &time);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    sync->day       = time.day;
+    sync->target_us = (api429_timing_time_us(&time) + sync->lead_us + 999) / 1000 * 1000;
+
+    for(i = 0; i < sync->channel_count; i++)
+    {
+        entry = &sync->channels[i];
+
+        /* Start times have millisecond resolution */
+        start = sync->target_us + entry->phase_us + entry->correction_us;
+        start = start < sync->target_us ? sync->target_us : start;
+        start = (start + 500) / 1000 * 1000;
+
+        entry->start_us = start % API429_TIMING_DAY_US;
+        api429_timing_time_set(&time, sync->day, start);
+
+        ret = Api429TxStartOnTTag(sync->board_handle, entry->channel, &time);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Check if a monitor entry is the expected first data word of a channel
+ */
+static AI_INLINE AiBoolean api429_tx_sync_match(const struct api429_tx_sync_channel* entry, AiUInt32 word)
+{
+    AiUInt8 number = (AiUInt8) (word & API429_WORD_LABEL_MASK);
+    AiUInt8 sdi    = (AiUInt8) ((word & API429_WORD_SDI_MASK) >> API429_WORD_SDI_POS);
+
+    if(entry->label != API429_TX_SYNC_LABEL_ANY && entry->label != number && entry->label != api429_codec_label_reverse(number))
+    {
+        return AiFalse;
+    }
+
+    return entry->sdi == API429_TX_SYNC_SDI_ANY || entry->sdi == sdi ? AiTrue : AiFalse;
+}
+
+
+/*! \brief Measure the residual skew of the last synchronized start
+ *
+ * Reads the monitor channels until the first data word of each channel was received or the timeout elapsed.
+ * The monitor channels must have been started before the channels were armed. \n
+ * The residual of each channel is the time its first data word was received minus the requested phase. In
+ * \ref API429_TX_SYNC_TTAG mode it is relative to the common start time, in \ref API429_TX_SYNC_TRIGGER mode
+ * relative to the earliest channel. As all channels have the same transmit to monitor latency, only differences of residuals are relevant.
+ * @param [in] sync the synchronized start
+ * @param [in] timeout_us maximum time to wait for data words
+ * @return
+ * - API_OK on success
+ * - AI429_ERR_TIMEOUT if not all channels were received
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_tx_sync_measure(struct api429_tx_sync* sync, AiUInt32 timeout_us)
+{
+    struct api429_tx_sync_channel* entry;
+    AiUInt64 deadline = ai_clock_us() + timeout_us;
+    AiUInt32 missing;
+    AiUInt16 count;
+    AiInt64 reference, min_residual, max_residual;
+    AiReturn ret;
+    AiUInt32 i, k;
+
+    if(!sync)
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    for(;;)
+    {
+        missing = 0;
+
+        for(i = 0; i < sync->channel_count; i++)
+        {
+            entry = &sync->channels[i];
+
+            while(entry->first_rx_us < 0)
+            {
+                ret = Api429RmDataRead(sync->board_handle, entry->rm_channel, API429_TX_SYNC_RM_BLOCK, &count, sync->rm_scratch);
+                if(ret != API_OK)
+                {
+                    return ret;
+                }
+
+                for(k = 0; k < count; k++)
+                {
+                    if(api429_tx_sync_match(entry, sync->rm_scratch[k].ldata))
+                    {
+                        entry->first_rx_us = api429_timing_tm_tag_us(sync->rm_scratch[k].tm_tag, sync->rm_scratch[k].brw);
+                        break;
+                    }
+                }
+
+                if(count < API429_TX_SYNC_RM_BLOCK)
+                {
+                    break;
+                }
+            }
+
+            if(entry->first_rx_us < 0)
+            {
+                missing++;
+            }
+        }
+
+        if(!missing)
+        {
+            break;
+        }
+
+        if(ai_clock_us() >= deadline)
+        {
+            return AI429_ERR_TIMEOUT;
+        }
+
+        ai_clock_sleep_us(1000);
+    }
+
+    reference = sync->target_us;
+    if(sync->mode == API429_TX_SYNC_TRIGGER)
+    {
+        reference = sync->channels[0].first_rx_us;
+        for(i = 1; i < sync->channel_count; i++)
+        {
+            if(api429_timing_diff_us(sync->channels[i].first_rx_us, reference) < 0)
+            {
+                reference = sync->channels[i].first_rx_us;
+            }
+        }
+    }
+
+    min_residual = 0;
+    max_residual = 0;
+    for(i = 0; i < sync->channel_count; i++)
+    {
+        entry = &sync->channels[i];
+        entry->residual_us = api429_timing_diff_us(entry->first_rx_us, reference) - entry->phase_us;
+
+        min_residual = i == 0 || entry->residual_us < min_residual ? entry->residual_us : min_residual;
+        max_residual = i == 0 || entry->residual_us > max_residual ? entry->residual_us : max_residual;
+    }
+
+    sync->max_skew_us = max_residual - min_residual;
+
+    return API_OK;
+}
+
+
+/*! \brief Derive start time corrections from the last measurement
+ *
+ * Each channel's residual is subtracted from its correction, so static offsets between channels are compensated
+ * at the next \ref api429_tx_sync_arm. Afterwards all corrections are shifted by the same amount, so the smallest one is zero.
+ * This keeps every correction non-negative, so the start times never fall before the common start time, where
+ * \ref api429_tx_sync_arm would have to clamp them. Late channels are thus compensated by delaying the others.
+ * Only effective in \ref API429_TX_SYNC_TTAG mode for offsets of at least half a millisecond.
+ * @param [in] sync the synchronized start. \ref api429_tx_sync_measure must have succeeded before
+ */
+static AI_INLINE void api429_tx_sync_calibrate(struct api429_tx_sync* sync)
+{
+    AiInt64 correction;
+    AiInt64 min_correction = 0;
+    AiUInt32 i;
+
+    if(!sync || sync->channel_count == 0)
+    {
+        return;
+    }
+
+    for(i = 0; i < sync->channel_count; i++)
+    {
+        correction     = (AiInt64) sync->channels[i].correction_us - sync->channels[i].residual_us;
+        min_correction = i == 0 || correction < min_correction ? correction : min_correction;
+    }
+
+    for(i = 0; i < sync->channel_count; i++)
+    {
+        sync->channels[i].correction_us = (AiInt32) ((AiInt64) sync->channels[i].correction_us - sync->channels[i].residual_us - min_correction);
+    }
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXSYNC_H_ */
@@ -0,0 +1,386 @@
+/******************************************************************************
+
+           Copyright (c) AIM GmbH 2026, 79111 Freiburg, Germany.
+
+            All rights reserved.  No part of this software may
+            be published, distributed, translated or otherwise
+            reproduced by any means or for any purpose without
+            the prior written consent of AIM GmbH, Freiburg.
+
+******************************************************************************/
+/*! \file Api429TxTimeline.h
+ *
+ *  This header file contains inline helper functions
+ *  for sending data words at given points of time via a transmit FIFO
+ */
+
+#ifndef API429TXTIMELINE_H_
+#define API429TXTIMELINE_H_
+
+
+#include <string.h>
+
+#include "Api429.h"
+#include "Api429Timing.h"
+#include "Api429TxFifoAsync.h"
+
+
+/**
+* \defgroup tx_timeline FIFO Timeline Compiler
+  This module converts data words with absolute send times into FIFO entries for a
+  channel initialized with \ref API429_TX_MODE_FIFO. \n
+  The time between two data words is built from the gap of the first word (4..255 bit times) and, if this is not sufficient,
+  delay entries (\ref Api429TxFifoDelayCreate) in steps of 100us. The number of delay entries is kept minimal and
+  the remainder is put into the gap, rounded to the nearest bit time. \n
+  The compiler tracks the realized send time of each word, so rounding errors do not accumulate: each word is
+  sent within half a bit time of its target, unless it is too close to its predecessor. \n
+  Words are compiled one at a time with \ref api429_timeline_push, which only needs constant memory, so scenarios
+  of any length can be streamed. \ref api429_timeline_feed compiles words directly into an asynchronous FIFO writer
+  as far as its ring buffer has space. \n
+  Times are relative to the start of FIFO processing. The FIFO must not run empty during playback, otherwise all following
+  words are delayed.
+* @{
+*/
+
+
+
+/*! \def API429_TIMELINE_DELAY_NS
+ * Resolution of FIFO delay entries in nanoseconds
+ */
+#define API429_TIMELINE_DELAY_NS        100000
+
+/*! \def API429_TIMELINE_MAX_DELAY_STEPS
+ * Maximum number of 100us steps put into one delay entry
+ */
+#define API429_TIMELINE_MAX_DELAY_STEPS 0xFFFF
+
+/*! \def API429_TIMELINE_CHUNK
+ * Number of FIFO entries compiled at once by \ref api429_timeline_feed
+ */
+#define API429_TIMELINE_CHUNK           256
+
+
+
+/*! \struct api429_timeline_word
+ *
+ * This structure describes a data word with its send time
+ */
+struct api429_timeline_word
+{
+    AiUInt64 time_ns;   /*!< Time the data word shall be sent in nanoseconds since start of the timeline */
+    AiUInt32 data;      /*!< Arinc 429 data word */
+};
+
+/*! \typedef TY_API429_TIMELINE_WORD
+ * Convenience typedef for \ref api429_timeline_word
+ */
+typedef struct api429_timeline_word TY_API429_TIMELINE_WORD;
+
+
+/*! \struct api429_timeline
+ *
+ * This structure holds the state of a timeline compiler.
+ * It is initialized with \ref api429_timeline_init
+ */
+struct api429_timeline
+{
+    AiUInt32 bit_ns;            /*!< Duration of one bit on the channel */
+    AiUInt32 min_gap;           /*!< Minimum gap between two data words in bit times */
+    AiBoolean pending;          /*!< AiTrue if a data word waits for its gap to be known */
+    AiUInt32 pending_data;      /*!< Data word waiting for its gap */
+    AiUInt64 cursor_ns;         /*!< Realized start time of the pending word, or end of the timeline if none is pending */
+    AiUInt64 words;             /*!< Number of compiled data words */
+    AiUInt64 entries;           /*!< Number of emitted FIFO entries */
+    AiUInt64 delays;            /*!< Number of emitted delay entries */
+    AiUInt64 late_words;        /*!< Number of data words sent later than half a bit time after their target */
+    AiUInt64 max_late_ns;       /*!< Largest delay of a data word relative to its target */
+    AiUInt64 max_early_ns;      /*!< Largest advance of a data word relative to its target */
+};
+
+/*! \typedef TY_API429_TIMELINE
+ * Convenience typedef for \ref api429_timeline
+ */
+typedef struct api429_timeline TY_API429_TIMELINE;
+
+
+
+
+/*! \brief Initialize a timeline compiler
+ *
+ * @param [out] timeline the compiler to initialize
+ * @param [in] speed speed of the channel
+ * @param [in] min_gap minimum gap between two data words in bit times, e.g. ulDefaultGapSize of the FIFO set-up.
+ *             Values below 4 are treated as 4
+ */
+static AI_INLINE void api429_timeline_init(struct api429_timeline* timeline, enum api429_speed speed, AiUInt32 min_gap)
+{
+    memset(timeline, 0, sizeof(struct api429_timeline));
+
+    timeline->bit_ns  = api429_timing_bit_time_ns(speed);
+    timeline->min_gap = api429_timing_gap_clip(min_gap);
+}
+
+
+/*! \brief Get maximum number of FIFO entries a data word may produce
+ *
+ * @param [in] timeline the compiler
+ * @param [in] time_ns send time of the data word
+ * @return upper limit of the number of entries \ref api429_timeline_push will emit for the data word
+ */
+static AI_INLINE AiUInt32 api429_timeline_entries_max(const struct api429_timeline* timeline, AiUInt64 time_ns)
+{
+    AiUInt64 steps;
+
+    if(time_ns <= timeline->cursor_ns)
+    {
+        return 1;
+    }
+
+    steps = (time_ns - timeline->cursor_ns) / API429_TIMELINE_DELAY_NS + 1;
+
+    return 1 + (AiUInt32) ((steps + API429_TIMELINE_MAX_DELAY_STEPS - 1) / API429_TIMELINE_MAX_DELAY_STEPS);
+}
+
+
+/*! \brief Emit delay entries
+ */
+static AI_INLINE AiReturn api429_timeline_delay_emit(struct api429_timeline* timeline, AiUInt64 steps,
+                                                     struct api429_tx_fifo_entry* entries, AiUInt32* count)
+{
+    AiUInt32 chunk;
+    AiReturn ret;
+
+    while(steps)
+    {
+        chunk = steps > API429_TIMELINE_MAX_DELAY_STEPS ? API429_TIMELINE_MAX_DELAY_STEPS : (AiUInt32) steps;
+
+        ret = Api429TxFifoDelayCreate(&entries[(*count)++], chunk);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        steps -= chunk;
+        timeline->delays++;
+    }
+
+    return API_OK;
+}
+
+
+/*! \brief Compile a data word
+ *
+ * Emits the FIFO entries that lead up to the data word. The data word itself is held back until
+ * the time of the next data word is known, as its gap depends on it.
+ * @param [in] timeline the compiler
+ * @param [in] word the data word with its send time. Send times must not decrease
+ * @param [out] entries the emitted entries are stored here. Must hold at least \ref api429_timeline_entries_max entries
+ * @param [out] count number of emitted entries is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_timeline_push(struct api429_timeline* timeline, const struct api429_timeline_word* word,
+                                               struct api429_tx_fifo_entry* entries, AiUInt32* count)
+{
+    AiUInt64 word_ns = (AiUInt64) API429_WORD_BITS * timeline->bit_ns;
+    AiUInt64 min_ns  = (AiUInt64) timeline->min_gap * timeline->bit_ns;
+    AiUInt64 end, idle, steps, rest;
+    AiUInt32 gap;
+    AiReturn ret;
+
+    *count = 0;
+
+    if(!timeline->pending)
+    {
+        /* Nothing to attach a gap to, so the start is only adjustable by delays */
+        steps = word->time_ns > timeline->cursor_ns
+              ? (word->time_ns - timeline->cursor_ns + API429_TIMELINE_DELAY_NS / 2) / API429_TIMELINE_DELAY_NS : 0;
+
+        ret = api429_timeline_delay_emit(timeline, steps, entries, count);
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        timeline->cursor_ns += steps * API429_TIMELINE_DELAY_NS;
+    }
+    else
+    {
+        end  = timeline->cursor_ns + word_ns;
+        idle = word->time_ns > end + min_ns ? word->time_ns - end : min_ns;
+
+        /* Put as much as possible into delays, keeping at least the minimum gap */
+        steps = (idle - min_ns) / API429_TIMELINE_DELAY_NS;
+        rest  = idle - steps * API429_TIMELINE_DELAY_NS;
+        gap   = (AiUInt32) ((rest + timeline->bit_ns / 2) / timeline->bit_ns);
+        gap   = gap < timeline->min_gap ? timeline->min_gap : (gap > API429_MAX_GAP_BITS ? API429_MAX_GAP_BITS : gap);
+
+        ret = Api429TxFifoDataWordCreate(&entries[(*count)++], timeline->pending_data, gap, API429_XFER_ERR_DIS);
+        if(ret == API_OK)
+        {
+            ret = api429_timeline_delay_emit(timeline, steps, entries, count);
+        }
+
+        if(ret != API_OK)
+        {
+            return ret;
+        }
+
+        timeline->cursor_ns = end + (AiUInt64) gap * timeline->bit_ns + steps * API429_TIMELINE_DELAY_NS;
+    }
+
+    if(timeline->cursor_ns > word->time_ns + timeline->bit_ns / 2)
+    {
+        timeline->late_words++;
+    }
+
+    if(timeline->cursor_ns > word->time_ns && timeline->cursor_ns - word->time_ns > timeline->max_late_ns)
+    {
+        timeline->max_late_ns = timeline->cursor_ns - word->time_ns;
+    }
+
+    if(timeline->cursor_ns < word->time_ns && word->time_ns - timeline->cursor_ns > timeline->max_early_ns)
+    {
+        timeline->max_early_ns = word->time_ns - timeline->cursor_ns;
+    }
+
+    timeline->pending      = AiTrue;
+    timeline->pending_data = word->data;
+    timeline->words++;
+    timeline->entries     += *count;
+
+    return API_OK;
+}
+
+
+/*! \brief Emit the data word that is held back
+ *
+ * Must be called after the last data word of a timeline. The word is sent with the minimum gap.
+ * @param [in] timeline the compiler
+ * @param [out] entry the emitted entry is stored here
+ * @param [out] count number of emitted entries (0 or 1) is stored here
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_timeline_flush(struct api429_timeline* timeline, struct api429_tx_fifo_entry* entry, AiUInt32* count)
+{
+    AiReturn ret;
+
+    *count = 0;
+
+    if(!timeline->pending)
+    {
+        return API_OK;
+    }
+
+    ret = Api429TxFifoDataWordCreate(entry, timeline->pending_data, timeline->min_gap, API429_XFER_ERR_DIS);
+    if(ret != API_OK)
+    {
+        return ret;
+    }
+
+    timeline->cursor_ns += (AiUInt64) (API429_WORD_BITS + timeline->min_gap) * timeline->bit_ns;
+    timeline->pending    = AiFalse;
+    timeline->entries++;
+    *count = 1;
+
+    return API_OK;
+}
+
+
+/*! \brief Compile data words into an asynchronous FIFO writer
+ *
+ * Compiles as many data words as fit into the ring buffer of the writer. Must be called repeatedly until all
+ * data words are consumed, e.g. whenever a previously returned ticket completed. Only one thread may write to the writer
+ * while a timeline is fed.
+ * @param [in] timeline the compiler
+ * @param [in] writer the asynchronous writer of the channel
+ * @param [in] words data words with their send times
+ * @param [in] count number of data words
+ * @param [in] last if AiTrue, 'words' ends the timeline and the held back word is flushed after the last one.
+ *             If the ring buffer was too full for this, 'pending' of the compiler is still AiTrue and the call has to be repeated
+ * @param [out] consumed number of data words that were compiled is stored here
+ * @param [out] ticket ticket of the last written entries is stored here. May be NULL
+ * @return
+ * - API_OK on success
+ * - Appropriate error code, which may be used as input parameter for \ref Api429LibErrorDescGet
+ */
+static AI_INLINE AiReturn api429_timeline_feed(struct api429_timeline* timeline, struct api429_tx_fifo_async* writer,
+                                               const struct api429_timeline_word* words, AiUInt32 count, AiBoolean last,
+                                               AiUInt32* consumed, AiUInt64* ticket)
+{
+    struct api429_tx_fifo_entry chunk[API429_TIMELINE_CHUNK];
+    AiUInt32 fill = 0;
+    AiUInt32 space;
+    AiUInt32 emitted;
+    AiReturn ret = API_OK;
+    AiUInt32 i = 0;
+
+    if(!timeline || !writer || !consumed || (!words && count))
+    {
+        return AI429_ERR_NULL_POINTER;
+    }
+
+    space = api429_tx_fifo_async_space(writer);
+
+    for(;;)
+    {
+        /* Stop when the next word might not fit into the chunk or the ring buffer */
+        if(i < count)
+        {
+            emitted = api429_timeline_entries_max(timeline, words[i].time_ns);
+            if(emitted > API429_TIMELINE_CHUNK - fill || emitted > space - fill)
+            {
+                if(fill == 0 && emitted > API429_TIMELINE_CHUNK)
+                {
+                    ret = AI429_ERR_PARAMETER_RANGE;
+                }
+            }
+            else
+            {
+                ret = api429_timeline_push(timeline, &words[i], &chunk[fill], &emitted);
+                fill += emitted;
+                i++;
+
+                if(ret == API_OK && i < count)
+                {
+                    continue;
+                }
+            }
+        }
+
+        if(ret == API_OK && last && i == count && fill < API429_TIMELINE_CHUNK && fill < space)
+        {
+            ret = api429_timeline_flush(timeline, &chunk[fill], &emitted);
+            fill += emitted;
+        }
+
+        if(fill == 0 || ret != API_OK)
+        {
+            break;
+        }
+
+        ret = api429_tx_fifo_async_write(writer, chunk, fill, NULL, NULL, ticket);
+        space -= fill;
+        fill   = 0;
+
+        if(ret != API_OK || (i == count && !(last && timeline->pending)))
+        {
+            break;
+        }
+    }
+
+    *consumed = i;
+
+    return ret;
+}
+
+
+
+/** @} */
+
+
+
+#endif /* API429TXTIMELINE_H_ */